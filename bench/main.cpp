@@ -0,0 +1,243 @@
+/**
+ * Image encoding benchmark.
+ *
+ * Compares the SOIL snapshot path against the in-tree PNG encoder at
+ * increasing thread counts on a synthetic render of given size.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <soil/soil.h>
+#include <tclap/CmdLine.h>
+
+#include <mandelbrot/PngEncoder.h>
+#include <mandelbrot/Stopwatch.h>
+
+
+using namespace mandelbrot;
+
+
+typedef int Status;
+const Status SUCCESS =  0;
+const Status FAILURE = -1;
+
+namespace
+{
+    const unsigned int CHANNEL_COUNT = 3;
+
+    /**
+     * Produces a smoothly colored escape time image, which compresses
+     * similarly to actual snapshots.
+     */
+    std::vector<unsigned char> Render
+    (
+        const unsigned int width,
+        const unsigned int height
+    )
+    {
+        static const unsigned int MAX_ITERATIONS = 256;
+
+        std::vector<unsigned char> pixels
+        (
+            static_cast<std::size_t>(width) * height * CHANNEL_COUNT
+        );
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                const double cx = -2.0 + 2.6 * x / width;
+                const double cy = -1.3 + 2.6 * y / height;
+                double zx = 0, zy = 0;
+                unsigned int i = 0;
+                while (i < MAX_ITERATIONS && zx * zx + zy * zy < 256)
+                {
+                    const double t = zx * zx - zy * zy + cx;
+                    zy = 2 * zx * zy + cy;
+                    zx = t;
+                    ++i;
+                }
+                double mu = 0;
+                if (i < MAX_ITERATIONS)
+                {
+                    mu = i + 1 - std::log2(std::log(zx * zx + zy * zy) / 2);
+                }
+                unsigned char* pixel =
+                    &pixels[(static_cast<std::size_t>(y) * width + x) *
+                            CHANNEL_COUNT];
+                for (unsigned int c = 0; c < CHANNEL_COUNT; ++c)
+                {
+                    const double phase = 0.1 * mu + 2.0 * c;
+                    pixel[c] = static_cast<unsigned char>
+                    (
+                        127.5 * (1 + std::sin(phase))
+                    );
+                }
+            }
+        }
+        return pixels;
+    }
+
+    /**
+     * Gets the best wall time of given number of runs, in milliseconds.
+     */
+    template <typename Function>
+    double Measure(const unsigned int repetitions, Function function)
+    {
+        double best = 0;
+        for (unsigned int i = 0; i < repetitions; ++i)
+        {
+            Stopwatch stopwatch;
+            stopwatch.Start();
+            const bool success = function();
+            stopwatch.Stop();
+
+            if (!success) { return -1; }
+
+            const double milliseconds =
+                stopwatch.nanoseconds().count() * 1e-6;
+            if (i == 0 || milliseconds < best) { best = milliseconds; }
+        }
+        return best;
+    }
+
+    void PrintRow
+    (
+        const std::string& name,
+        const double milliseconds,
+        const double baseline_milliseconds,
+        const std::size_t size
+    )
+    {
+        std::cout << std::left << std::setw(16) << name
+                  << std::right << std::fixed << std::setprecision(1);
+        if (milliseconds < 0)
+        {
+            std::cout << std::setw(12) << "failed" << std::endl;
+            return;
+        }
+        std::cout << std::setw(12) << milliseconds << " ms"
+                  << std::setw(10) << size / (milliseconds * 1e3) << " MB/s"
+                  << std::setw(8) << std::setprecision(2)
+                  << baseline_milliseconds / milliseconds << "x"
+                  << std::endl;
+    }
+}
+
+Status main(const int argc, char** argv)
+{
+    static const unsigned int DEFAULT_SIZE = 8192;
+    static const unsigned int DEFAULT_REPETITIONS = 3;
+
+    try
+    {
+        TCLAP::CmdLine command_line
+        (
+            "Measures snapshot encoding throughput.",
+            ' ',
+            "1.0"
+        );
+        TCLAP::ValueArg<unsigned int> width_arg
+        (
+            "w", "width", "Image width",
+            false, DEFAULT_SIZE, "positive integer"
+        );
+        TCLAP::ValueArg<unsigned int> height_arg
+        (
+            "e", "height", "Image height",
+            false, DEFAULT_SIZE, "positive integer"
+        );
+        TCLAP::ValueArg<unsigned int> repetitions_arg
+        (
+            "n", "repetitions", "Runs per measurement (best is reported)",
+            false, DEFAULT_REPETITIONS, "positive integer"
+        );
+        TCLAP::ValueArg<std::string> output_path_arg
+        (
+            "o", "output-path", "Path prefix of temporary output files",
+            false, "benchmark", "string"
+        );
+        command_line.add(width_arg);
+        command_line.add(height_arg);
+        command_line.add(repetitions_arg);
+        command_line.add(output_path_arg);
+
+        command_line.parse(argc, argv);
+
+        const unsigned int width = std::max(width_arg.getValue(), 1U);
+        const unsigned int height = std::max(height_arg.getValue(), 1U);
+        const unsigned int repetitions =
+            std::max(repetitions_arg.getValue(), 1U);
+        const std::string bmp_path = output_path_arg.getValue() + ".bmp";
+        const std::string png_path = output_path_arg.getValue() + ".png";
+
+        std::cout << "Rendering " << width << "x" << height
+                  << " test image..." << std::endl;
+        const std::vector<unsigned char> pixels = Render(width, height);
+
+        std::cout << std::left << std::setw(16) << "encoder"
+                  << std::right << std::setw(15) << "time"
+                  << std::setw(15) << "throughput"
+                  << std::setw(9) << "speedup" << std::endl;
+
+        const double soil_milliseconds = Measure(repetitions, [&]
+        {
+            return SOIL_save_image
+            (
+                bmp_path.c_str(), SOIL_SAVE_TYPE_BMP,
+                width, height, CHANNEL_COUNT,
+                pixels.data()
+            ) != 0;
+        });
+        PrintRow
+        (
+            "soil bmp", 
+            soil_milliseconds, soil_milliseconds, pixels.size()
+        );
+        std::remove(bmp_path.c_str());
+
+        const unsigned int max_thread_count =
+            std::max(std::thread::hardware_concurrency(), 1U);
+        for (unsigned int thread_count = 1; ;
+             thread_count = std::min(thread_count * 2, max_thread_count))
+        {
+            const PngEncoder encoder(thread_count);
+            const double milliseconds = Measure(repetitions, [&]
+            {
+                return encoder.Write
+                (
+                    png_path.c_str(), pixels.data(),
+                    width, height, CHANNEL_COUNT,
+                    true
+                );
+            });
+            PrintRow
+            (
+                "png x" + std::to_string(thread_count),
+                milliseconds, soil_milliseconds, pixels.size()
+            );
+
+            if (thread_count == max_thread_count) { break; }
+        }
+        std::remove(png_path.c_str());
+
+        return SUCCESS;
+    }
+    catch (TCLAP::ArgException& exception)
+    {
+        std::cerr << "Error: " << exception.error()
+                  << "in argument" << exception.argId()
+                  << std::endl;
+    }
+    return FAILURE;
+}
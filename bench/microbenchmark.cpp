@@ -0,0 +1,749 @@
+/**
+ * Kernel microbenchmarks.
+ *
+ * Times the arithmetic building blocks of rendering on fixed pixel sets
+ * drawn from the snapshot views: the escape loop, complex squaring,
+ * smooth coloring, color map interpolation, image encoding and the CPU
+ * computation as a whole. Results are written as JSON, and may be
+ * compared against a stored baseline to flag regressions.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <experimental/filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <tclap/CmdLine.h>
+
+#include <mandelbrot/ColorArray.h>
+#include <mandelbrot/CpuComputation.h>
+#include <mandelbrot/PngEncoder.h>
+#include <mandelbrot/Stopwatch.h>
+#include <mandelbrot/Vector2.h>
+
+
+using namespace mandelbrot;
+
+
+typedef int Status;
+const Status SUCCESS =  0;
+const Status FAILURE = -1;
+
+namespace
+{
+    typedef std::complex<double> Complex;
+
+    const unsigned int CHANNEL_COUNT = 3;
+    const unsigned int COLOR_MAP_SIZE = 256;
+    const double ESCAPE_RADIUS = 2;
+
+    /**
+     * A square grid of points spanning a snapshot view.
+     */
+    struct View
+    {
+        std::string name;
+        Vector2d bottom_left;
+        double pixel_size;
+        std::vector<Complex> points;
+    };
+    /**
+     * Escape time evaluation of a point.
+     */
+    struct Escape
+    {
+        Complex z;
+        int lifetime;
+        bool is_interior;
+    };
+    /**
+     * Measurement of a kernel over every view.
+     */
+    struct Result
+    {
+        std::string name;
+        std::size_t pixel_count = 0;
+        // Zero for kernels that do not iterate.
+        std::uint64_t iteration_count = 0;
+        double nanoseconds_per_pixel = 0;
+        double iterations_per_second = 0;
+    };
+
+    std::vector<View> LoadViews
+    (
+        const std::string& directory,
+        const unsigned int grid_size
+    )
+    {
+        namespace filesystem = std::experimental::filesystem;
+
+        std::vector<std::string> paths;
+        std::error_code error;
+        for (filesystem::directory_iterator entry(directory, error), end;
+             !error && entry != end;
+             entry.increment(error))
+        {
+            if (entry->path().extension() == ".txt")
+            {
+                paths.push_back(entry->path().string());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+
+        std::vector<View> views;
+        for (const std::string& path : paths)
+        {
+            // State files start with the view's center and size.
+            Vector2d center;
+            double size;
+            std::ifstream file(path);
+            file >> center.x >> center.y >> size;
+            if (file.fail() || size <= 0) { continue; }
+
+            View view;
+            view.name = filesystem::path(path).stem().string();
+            view.pixel_size = size / grid_size;
+            view.bottom_left = center - Vector2d(0.5 * size, 0.5 * size);
+            for (unsigned int y = 0; y < grid_size; ++y)
+            {
+                for (unsigned int x = 0; x < grid_size; ++x)
+                {
+                    view.points.emplace_back
+                    (
+                        view.bottom_left.x + (x + 0.5) * view.pixel_size,
+                        view.bottom_left.y + (y + 0.5) * view.pixel_size
+                    );
+                }
+            }
+            views.push_back(view);
+        }
+        return views;
+    }
+
+    /**
+     * Iterates z = z^2 + c in separate real and imaginary parts, as the
+     * computation shader does.
+     */
+    std::uint64_t EscapeLoop
+    (
+        const std::vector<Complex>& points,
+        const unsigned int max_iteration_count,
+        std::vector<Escape>& escapes
+    )
+    {
+        const double escape_norm = ESCAPE_RADIUS * ESCAPE_RADIUS;
+
+        std::uint64_t iteration_count = 0;
+        escapes.resize(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const double c_real = points[i].real();
+            const double c_imaginary = points[i].imag();
+            double z_real = 0, z_imaginary = 0;
+            double real_2 = 0, imaginary_2 = 0;
+
+            unsigned int n = 0;
+            while (n < max_iteration_count &&
+                   real_2 + imaginary_2 < escape_norm)
+            {
+                z_imaginary = 2 * z_real * z_imaginary + c_imaginary;
+                z_real = real_2 - imaginary_2 + c_real;
+                real_2 = z_real * z_real;
+                imaginary_2 = z_imaginary * z_imaginary;
+                ++ n;
+            }
+            escapes[i].z = Complex(z_real, z_imaginary);
+            escapes[i].lifetime = static_cast<int>(n);
+            escapes[i].is_interior = n == max_iteration_count;
+            iteration_count += n;
+        }
+        return iteration_count;
+    }
+    /**
+     * Iterates z = z^2 + c with std::complex, as the CPU computation does.
+     */
+    std::uint64_t ComplexSquare
+    (
+        const std::vector<Complex>& points,
+        const unsigned int max_iteration_count,
+        std::vector<Escape>& escapes
+    )
+    {
+        const double escape_norm = ESCAPE_RADIUS * ESCAPE_RADIUS;
+
+        std::uint64_t iteration_count = 0;
+        escapes.resize(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const Complex c = points[i];
+            Complex z;
+
+            unsigned int n = 0;
+            while (n < max_iteration_count && std::norm(z) < escape_norm)
+            {
+                z = z * z + c;
+                ++ n;
+            }
+            escapes[i].z = z;
+            escapes[i].lifetime = static_cast<int>(n);
+            escapes[i].is_interior = n == max_iteration_count;
+            iteration_count += n;
+        }
+        return iteration_count;
+    }
+    /**
+     * Computes continuous escape times, as the smooth coloring shader does.
+     * Interior points get a negative lifetime.
+     */
+    void SmoothLifetimes
+    (
+        const std::vector<Escape>& escapes,
+        std::vector<float>& lifetimes
+    )
+    {
+        const double log_escape_radius = std::log(ESCAPE_RADIUS);
+
+        lifetimes.resize(escapes.size());
+        for (std::size_t i = 0; i < escapes.size(); ++i)
+        {
+            const Escape& escape = escapes[i];
+            if (escape.is_interior)
+            {
+                lifetimes[i] = -1;
+                continue;
+            }
+            const double log_z = std::log(std::norm(escape.z)) / 2;
+            const double nu = std::log2(log_z / log_escape_radius);
+            lifetimes[i] = static_cast<float>(escape.lifetime + 1 - nu);
+        }
+    }
+    /**
+     * Blends adjacent colors of the map, as the smooth coloring shader
+     * does. Interior points are black.
+     */
+    void Colorize
+    (
+        const std::vector<float>& lifetimes,
+        const ColorArray& color_map,
+        std::vector<unsigned char>& pixels
+    )
+    {
+        const unsigned int size = color_map.size();
+        const unsigned char* colors = color_map.data();
+
+        pixels.assign(lifetimes.size() * CHANNEL_COUNT, 0);
+        for (std::size_t i = 0; i < lifetimes.size(); ++i)
+        {
+            const float lifetime = lifetimes[i];
+            if (lifetime < 0) { continue; }
+
+            const float whole = std::floor(lifetime);
+            const float t = lifetime - whole;
+            const unsigned int a = static_cast<unsigned int>(whole) % size;
+            const unsigned int b = (a + 1) % size;
+            for (unsigned int channel = 0; channel < CHANNEL_COUNT; ++channel)
+            {
+                const float value =
+                    (1 - t) * colors[a * CHANNEL_COUNT + channel] +
+                    t * colors[b * CHANNEL_COUNT + channel];
+                pixels[i * CHANNEL_COUNT + channel] =
+                    static_cast<unsigned char>(value + 0.5f);
+            }
+        }
+    }
+
+    /**
+     * Produces a smooth cyclic gradient.
+     */
+    ColorArray CreateColorMap()
+    {
+        std::vector<unsigned char> data(COLOR_MAP_SIZE * CHANNEL_COUNT);
+        for (unsigned int i = 0; i < COLOR_MAP_SIZE; ++i)
+        {
+            for (unsigned int channel = 0; channel < CHANNEL_COUNT; ++channel)
+            {
+                const double phase =
+                    6.2831853 * i / COLOR_MAP_SIZE + 2.0 * channel;
+                data[i * CHANNEL_COUNT + channel] =
+                    static_cast<unsigned char>(127.5 * (1 + std::sin(phase)));
+            }
+        }
+        return ColorArray(COLOR_MAP_SIZE, CHANNEL_COUNT, data.data());
+    }
+
+    /**
+     * Gets the best wall time of given number of runs, in nanoseconds.
+     */
+    template <typename Function>
+    double Measure(const unsigned int repetitions, Function function)
+    {
+        double best = 0;
+        for (unsigned int i = 0; i < repetitions; ++i)
+        {
+            Stopwatch stopwatch;
+            stopwatch.Start();
+            function();
+            stopwatch.Stop();
+
+            const double nanoseconds =
+                static_cast<double>(stopwatch.nanoseconds().count());
+            if (i == 0 || nanoseconds < best) { best = nanoseconds; }
+        }
+        return best;
+    }
+    Result MakeResult
+    (
+        const std::string& name,
+        const std::size_t pixel_count,
+        const std::uint64_t iteration_count,
+        const double nanoseconds
+    )
+    {
+        Result result;
+        result.name = name;
+        result.pixel_count = pixel_count;
+        result.iteration_count = iteration_count;
+        result.nanoseconds_per_pixel =
+            nanoseconds / static_cast<double>(pixel_count);
+        result.iterations_per_second =
+            nanoseconds > 0 ?
+            static_cast<double>(iteration_count) / (nanoseconds * 1e-9) :
+            0;
+        return result;
+    }
+
+    std::vector<Result> Run
+    (
+        const std::vector<View>& views,
+        const unsigned int grid_size,
+        const unsigned int max_iteration_count,
+        const unsigned int repetitions
+    )
+    {
+        std::vector<Result> results;
+
+        std::vector<std::vector<Escape>> escapes(views.size());
+        std::vector<std::vector<float>> lifetimes(views.size());
+        std::vector<std::vector<unsigned char>> pixels(views.size());
+
+        std::size_t pixel_count = 0;
+        std::uint64_t iteration_count = 0;
+        for (const View& view : views) { pixel_count += view.points.size(); }
+
+        double nanoseconds = Measure(repetitions, [&]
+        {
+            iteration_count = 0;
+            for (std::size_t i = 0; i < views.size(); ++i)
+            {
+                iteration_count += EscapeLoop
+                (
+                    views[i].points, max_iteration_count, escapes[i]
+                );
+            }
+        });
+        results.push_back
+        (
+            MakeResult
+            (
+                "escape_loop", pixel_count, iteration_count, nanoseconds
+            )
+        );
+
+        std::vector<Escape> complex_escapes;
+        nanoseconds = Measure(repetitions, [&]
+        {
+            iteration_count = 0;
+            for (const View& view : views)
+            {
+                iteration_count += ComplexSquare
+                (
+                    view.points, max_iteration_count, complex_escapes
+                );
+            }
+        });
+        results.push_back
+        (
+            MakeResult
+            (
+                "complex_square", pixel_count, iteration_count, nanoseconds
+            )
+        );
+
+        nanoseconds = Measure(repetitions, [&]
+        {
+            for (std::size_t i = 0; i < views.size(); ++i)
+            {
+                SmoothLifetimes(escapes[i], lifetimes[i]);
+            }
+        });
+        results.push_back
+        (
+            MakeResult("smooth_coloring", pixel_count, 0, nanoseconds)
+        );
+
+        const ColorArray color_map = CreateColorMap();
+        nanoseconds = Measure(repetitions, [&]
+        {
+            for (std::size_t i = 0; i < views.size(); ++i)
+            {
+                Colorize(lifetimes[i], color_map, pixels[i]);
+            }
+        });
+        results.push_back
+        (
+            MakeResult("color_interpolation", pixel_count, 0, nanoseconds)
+        );
+
+        // A single stripe, so results do not depend on the core count.
+        const PngEncoder encoder(1);
+        std::vector<unsigned char> encoded;
+        nanoseconds = Measure(repetitions, [&]
+        {
+            for (std::size_t i = 0; i < views.size(); ++i)
+            {
+                encoder.Encode
+                (
+                    pixels[i].data(),
+                    grid_size, grid_size,
+                    CHANNEL_COUNT,
+                    true,
+                    encoded
+                );
+            }
+        });
+        results.push_back
+        (
+            MakeResult("png_encoding", pixel_count, 0, nanoseconds)
+        );
+
+        CpuComputation computation;
+        computation.set_size(Vector2u(grid_size, grid_size));
+        computation.set_escape_radius(ESCAPE_RADIUS);
+        nanoseconds = Measure(repetitions, [&]
+        {
+            for (const View& view : views)
+            {
+                computation.set_viewport(view.bottom_left, view.pixel_size);
+                computation.Execute(max_iteration_count);
+            }
+        });
+        results.push_back
+        (
+            MakeResult("cpu_computation", pixel_count, 0, nanoseconds)
+        );
+
+        return results;
+    }
+
+    bool WriteResults
+    (
+        const std::string& path,
+        const std::vector<Result>& results,
+        const std::size_t view_count,
+        const unsigned int grid_size,
+        const unsigned int max_iteration_count
+    )
+    {
+        std::ofstream file(path);
+        file << std::fixed << std::setprecision(3)
+             << "{" << std::endl
+             << "  \"view_count\": " << view_count << "," << std::endl
+             << "  \"grid_size\": " << grid_size << "," << std::endl
+             << "  \"max_iteration_count\": " << max_iteration_count << ","
+             << std::endl
+             << "  \"kernels\": [";
+
+        // One kernel per line, which ReadResults relies on.
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+            file << (i == 0 ? "" : ",") << std::endl
+                 << "    { "
+                 << "\"name\": \"" << result.name << "\", "
+                 << "\"pixels\": " << result.pixel_count << ", "
+                 << "\"iterations\": " << result.iteration_count << ", "
+                 << "\"ns_per_pixel\": " << result.nanoseconds_per_pixel
+                 << ", "
+                 << "\"iterations_per_second\": "
+                 << result.iterations_per_second
+                 << " }";
+        }
+        file << std::endl << "  ]" << std::endl
+             << "}" << std::endl;
+
+        return !file.fail();
+    }
+    /**
+     * Reads kernel names and their time per pixel from a file written by
+     * WriteResults.
+     */
+    bool ReadResults
+    (
+        const std::string& path,
+        std::map<std::string, double>& nanoseconds_per_pixel
+    )
+    {
+        std::ifstream file(path);
+        if (!file.is_open()) { return false; }
+
+        const std::string NAME_KEY = "\"name\": \"";
+        const std::string TIME_KEY = "\"ns_per_pixel\": ";
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            const std::size_t name_offset = line.find(NAME_KEY);
+            const std::size_t time_offset = line.find(TIME_KEY);
+            if (name_offset == std::string::npos ||
+                time_offset == std::string::npos)
+            {
+                continue;
+            }
+            const std::size_t name_begin = name_offset + NAME_KEY.size();
+            const std::size_t name_end = line.find('"', name_begin);
+
+            const std::string name =
+                line.substr(name_begin, name_end - name_begin);
+            nanoseconds_per_pixel[name] =
+                std::stod(line.substr(time_offset + TIME_KEY.size()));
+        }
+        return true;
+    }
+
+    void PrintResults(const std::vector<Result>& results)
+    {
+        std::cout << std::left << std::setw(22) << "kernel"
+                  << std::right << std::setw(12) << "ns/pixel"
+                  << std::setw(16) << "Miterations/s"
+                  << std::endl;
+        for (const Result& result : results)
+        {
+            std::cout << std::left << std::setw(22) << result.name
+                      << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(12) << result.nanoseconds_per_pixel;
+            if (result.iteration_count > 0)
+            {
+                std::cout << std::setw(16)
+                          << result.iterations_per_second * 1e-6;
+            }
+            std::cout << std::endl;
+        }
+    }
+    /**
+     * Prints the change of each kernel's time per pixel.
+     *
+     * @returns Number of kernels slower than the baseline by more than the
+     *          threshold.
+     */
+    unsigned int Compare
+    (
+        const std::map<std::string, double>& current,
+        const std::map<std::string, double>& baseline,
+        const double threshold
+    )
+    {
+        std::cout << std::left << std::setw(22) << "kernel"
+                  << std::right << std::setw(12) << "baseline"
+                  << std::setw(12) << "current"
+                  << std::setw(10) << "change"
+                  << std::endl;
+
+        unsigned int regression_count = 0;
+        for (const auto& entry : current)
+        {
+            std::cout << std::left << std::setw(22) << entry.first
+                      << std::right << std::fixed << std::setprecision(2);
+
+            const auto baseline_entry = baseline.find(entry.first);
+            if (baseline_entry == baseline.end() ||
+                baseline_entry->second <= 0)
+            {
+                std::cout << std::setw(12) << "-"
+                          << std::setw(12) << entry.second
+                          << std::endl;
+                continue;
+            }
+
+            const double change = entry.second / baseline_entry->second - 1;
+            std::cout << std::setw(12) << baseline_entry->second
+                      << std::setw(12) << entry.second
+                      << std::setw(9) << std::showpos << 100 * change << "%"
+                      << std::noshowpos;
+            if (change > threshold)
+            {
+                std::cout << "  REGRESSION";
+                ++ regression_count;
+            }
+            else if (change < -threshold) { std::cout << "  improved"; }
+            std::cout << std::endl;
+        }
+        return regression_count;
+    }
+}
+
+Status main(const int argc, char** argv)
+{
+    static const unsigned int DEFAULT_GRID_SIZE = 64;
+    static const unsigned int DEFAULT_ITERATION_COUNT = 1024;
+    static const unsigned int DEFAULT_REPETITIONS = 5;
+    static const double DEFAULT_THRESHOLD = 0.05;
+
+    try
+    {
+        TCLAP::CmdLine command_line
+        (
+            "Measures rendering kernels over the snapshot views.",
+            ' ',
+            "1.0"
+        );
+        TCLAP::ValueArg<std::string> states_arg
+        (
+            "s", "states", "Directory of the snapshot state files",
+            false, "img/snapshots/states", "path"
+        );
+        TCLAP::ValueArg<unsigned int> grid_size_arg
+        (
+            "g", "grid-size", "Pixels along each side of a view",
+            false, DEFAULT_GRID_SIZE, "positive integer"
+        );
+        TCLAP::ValueArg<unsigned int> iteration_count_arg
+        (
+            "i", "iterations", "Maximum iterations per pixel",
+            false, DEFAULT_ITERATION_COUNT, "positive integer"
+        );
+        TCLAP::ValueArg<unsigned int> repetitions_arg
+        (
+            "n", "repetitions", "Runs per measurement (best is reported)",
+            false, DEFAULT_REPETITIONS, "positive integer"
+        );
+        TCLAP::ValueArg<std::string> output_path_arg
+        (
+            "o", "output", "Write results to this JSON file",
+            false, "", "path"
+        );
+        TCLAP::ValueArg<std::string> compare_path_arg
+        (
+            "c", "compare",
+            "Compare results read from this JSON file instead of running",
+            false, "", "path"
+        );
+        TCLAP::ValueArg<std::string> baseline_path_arg
+        (
+            "b", "baseline",
+            "Compare results against this JSON file, failing on regressions",
+            false, "", "path"
+        );
+        TCLAP::ValueArg<double> threshold_arg
+        (
+            "t", "threshold",
+            "Relative slowdown beyond which a kernel regressed (noise)",
+            false, DEFAULT_THRESHOLD, "fraction"
+        );
+        command_line.add(states_arg);
+        command_line.add(grid_size_arg);
+        command_line.add(iteration_count_arg);
+        command_line.add(repetitions_arg);
+        command_line.add(output_path_arg);
+        command_line.add(compare_path_arg);
+        command_line.add(baseline_path_arg);
+        command_line.add(threshold_arg);
+
+        command_line.parse(argc, argv);
+
+        std::map<std::string, double> current;
+        if (!compare_path_arg.getValue().empty())
+        {
+            if (!ReadResults(compare_path_arg.getValue(), current))
+            {
+                std::cout << "Error loading: "
+                          << compare_path_arg.getValue()
+                          << std::endl;
+                return FAILURE;
+            }
+        }
+        else
+        {
+            const unsigned int grid_size =
+                std::max(grid_size_arg.getValue(), 1U);
+            const unsigned int iteration_count =
+                std::max(iteration_count_arg.getValue(), 1U);
+            const unsigned int repetitions =
+                std::max(repetitions_arg.getValue(), 1U);
+
+            const std::vector<View> views =
+                LoadViews(states_arg.getValue(), grid_size);
+            if (views.empty())
+            {
+                std::cout << "Error: no states found in "
+                          << states_arg.getValue()
+                          << std::endl;
+                return FAILURE;
+            }
+            std::cout << "Measuring " << views.size() << " views of "
+                      << grid_size << "x" << grid_size << " pixels, up to "
+                      << iteration_count << " iterations each"
+                      << std::endl;
+
+            const std::vector<Result> results =
+                Run(views, grid_size, iteration_count, repetitions);
+            PrintResults(results);
+            for (const Result& result : results)
+            {
+                current[result.name] = result.nanoseconds_per_pixel;
+            }
+
+            const std::string& output_path = output_path_arg.getValue();
+            if (!output_path.empty())
+            {
+                if (!WriteResults
+                    (
+                        output_path, results,
+                        views.size(), grid_size, iteration_count
+                    ))
+                {
+                    std::cout << "Error saving: " << output_path << std::endl;
+                    return FAILURE;
+                }
+                std::cout << "Saved: " << output_path << std::endl;
+            }
+        }
+
+        if (baseline_path_arg.getValue().empty()) { return SUCCESS; }
+
+        std::map<std::string, double> baseline;
+        if (!ReadResults(baseline_path_arg.getValue(), baseline))
+        {
+            std::cout << "Error loading: "
+                      << baseline_path_arg.getValue()
+                      << std::endl;
+            return FAILURE;
+        }
+        const unsigned int regression_count =
+            Compare(current, baseline, threshold_arg.getValue());
+        if (regression_count > 0)
+        {
+            std::cout << regression_count << " kernels regressed"
+                      << std::endl;
+            return FAILURE;
+        }
+        return SUCCESS;
+    }
+    catch (TCLAP::ArgException& exception)
+    {
+        std::cerr << "Error: " << exception.error()
+                  << "in argument" << exception.argId()
+                  << std::endl;
+    }
+    return FAILURE;
+}
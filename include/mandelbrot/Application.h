@@ -9,14 +9,22 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <glew/glew.h>
 #include <glfw/glfw3.h>
 
+#include <mandelbrot/Benchmark.h>
 #include <mandelbrot/Camera.h>
 #include <mandelbrot/ColorArray.h>
+#include <mandelbrot/ComputeThread.h>
+#include <mandelbrot/InputLog.h>
 #include <mandelbrot/KeyboardController.h>
+#include <mandelbrot/LatencyMonitor.h>
+#include <mandelbrot/PixelReader.h>
+#include <mandelbrot/PosterRenderer.h>
 #include <mandelbrot/Renderer.h>
+#include <mandelbrot/SnapshotWriter.h>
 #include <mandelbrot/Stopwatch.h>
 #include <mandelbrot/Vector2.h>
 
@@ -48,15 +56,122 @@ namespace mandelbrot
 
         static const char* WINDOW_TITLE;
 
+        /**
+         * Describes a poster rendering.
+         */
+        struct PosterSettings
+        {
+            // Poster size in pixels.
+            Vector2u size;
+            // Tile size in pixels, or zero for the largest supported.
+            unsigned int tile_size = 0;
+            // Index of the first tile to render, for resuming.
+            unsigned int first_tile_index = 0;
+            // Output path. Its extension selects the format (.png, .ppm).
+            std::string path;
+            // Whether each tile is written to its own file.
+            bool is_tiled = false;
+        };
+        /**
+         * Describes a benchmark run.
+         */
+        struct BenchmarkSettings
+        {
+            // Directory of the state files to render.
+            std::string state_directory;
+            // Output path of the JSON report.
+            std::string path;
+        };
+        /**
+         * Describes a replay of recorded input.
+         */
+        struct ReplaySettings
+        {
+            // Path of the recorded session.
+            std::string path;
+            // Camera time step per frame, or zero for the recorded times.
+            double timestep_seconds = 0;
+        };
+
         /**
          * Initializes OpenGL and launches the the graphical user interface.
          */
         bool Launch();
+        /**
+         * Initializes OpenGL in a hidden window and renders a poster of 
+         * the camera's view, then exits.
+         */
+        bool LaunchPoster(const PosterSettings& settings);
+        /**
+         * Initializes OpenGL in a hidden window and renders each scene of 
+         * the benchmark, then exits.
+         */
+        bool LaunchBenchmark(const BenchmarkSettings& settings);
+        /**
+         * Initializes OpenGL in a hidden window and replays a recorded
+         * session frame by frame, then reports frame times and exits.
+         */
+        bool LaunchReplay(const ReplaySettings& settings);
         /**
          * Exits the application.
          */
         void Close();
 
+        /**
+         * Gets the image format of saved snapshots.
+         */
+        SnapshotWriter::Format snapshot_format() const;
+        /**
+         * Sets the image format of saved snapshots.
+         */
+        void set_snapshot_format(SnapshotWriter::Format value);
+
+        /**
+         * Gets the path GL statistics are written to on exit.
+         */
+        const std::string& gl_statistics_path() const;
+        /**
+         * Sets the path GL statistics are written to on exit. Empty to not
+         * write them.
+         */
+        void set_gl_statistics_path(const std::string& value);
+        /**
+         * Gets the path input is recorded to.
+         */
+        const std::string& input_recording_path() const;
+        /**
+         * Sets the path input is recorded to on exit. Empty to not record.
+         */
+        void set_input_recording_path(const std::string& value);
+        /**
+         * Gets the path the trace is written to on exit.
+         */
+        const std::string& trace_path() const;
+        /**
+         * Sets the path the trace is written to on exit. Empty to only
+         * write it on demand.
+         */
+        void set_trace_path(const std::string& value);
+        /**
+         * Gets the path GPU stage times are written to on exit, as CSV.
+         */
+        const std::string& stage_times_path() const;
+        /**
+         * Sets the path GPU stage times are written to on exit, as CSV. 
+         * Empty to not write them.
+         */
+        void set_stage_times_path(const std::string& value);
+
+        /**
+         * Checks whether computation runs on the display thread.
+         */
+        bool is_synchronous() const;
+        /**
+         * Sets whether computation runs on the display thread. 
+         * Must be set before launch.
+         */
+        void set_is_synchronous(bool value);
+
         /**
          * Pauses continuous rendering.
          */
@@ -73,6 +188,15 @@ namespace mandelbrot
          * Produces a single rendering based on current camera position.
          */
         void Step();
+        /**
+         * Shows or hides the on-screen performance overlay.
+         */
+        void ToggleHud();
+        /**
+         * Shows the iterations executed per pixel as a heatmap, or the
+         * fractal again. Restarts the rendering either way.
+         */
+        void ToggleCostHeatmap();
         
         /**
          * Increases rendering precision.
@@ -91,12 +215,29 @@ namespace mandelbrot
         bool SaveSnapshot(const char* name = nullptr);
         /**
          * Save rendering as an image file.
+         *
+         * @note 
+         *      The image is read back over the following frames, then 
+         *      encoded and written on a background thread. The format
+         *      follows the path's extension (.png or .bmp).
+         *
+         * @returns Value indicating whether the save was issued.
          */
         bool SaveImage(const char* path = nullptr);
         /**
          * Save camera state as a text file.
+         *
+         * @note The file is written on a background thread.
          */
         bool SaveState(const char* path = nullptr);
+        /**
+         * Save the iterations executed per pixel as a raw file of 32-bit 
+         * little-endian unsigned integers, rows top first, and print how 
+         * concentrated they are. Only available while the heatmap is shown.
+         *
+         * @note The file is written on a background thread.
+         */
+        bool SaveCost(const char* path);
 
         /**
          * Gets camera (read only).
@@ -120,6 +261,11 @@ namespace mandelbrot
          * Prints debug information to std::cout.
          */
         void PrintDebugInformation() const;
+        /**
+         * Writes the zones traced so far to the trace path, or to the
+         * default path if none is set.
+         */
+        void WriteTrace();
 
         private:
         static void WindowSizeCallback
@@ -135,9 +281,14 @@ namespace mandelbrot
             int action,
             int modifiers
         );
+        static void WindowRefreshCallback(GLFWwindow* window);
 
         static std::unique_ptr<Application> instance_;
 
+        static const double PENDING_IMAGE_TIMEOUT_SECONDS;
+        static const double PENDING_STEP_TIMEOUT_SECONDS;
+        static const double HUD_REFRESH_INTERVAL_SECONDS;
+
         Application
         (
             unsigned int window_width,
@@ -150,12 +301,34 @@ namespace mandelbrot
         bool InitializeRenderer();
         
         void Dispose();
+        void WriteGLStatistics() const;
+        void WriteStageTimes() const;
+
+        bool RenderPoster(const PosterSettings& settings);
+        bool RunBenchmark(const BenchmarkSettings& settings);
+        bool ReplayInput(const ReplaySettings& settings);
+        static std::string GetPosterTilePath
+        (
+            const std::string& path, 
+            const PosterRenderer::Tile& tile
+        );
 
         void EnterMainLoop();
         void HandleEvents();
+        void WaitForEvents();
+        void Advance(const Stopwatch::Duration& elapsed);
         void RenderFrame();
+        void StepSynchronous();
+        void StepAsynchronous();
+        void UpdateHud();
 
-        bool UpdateCamera();
+        void PrintSnapshotReports();
+        void PrintRenderReport() const;
+        void PrintLatencyReport() const;
+        void PrintStartupReport();
+
+        bool is_camera_moving();
+        bool UpdateCamera(const Stopwatch::Duration& elapsed);
         void UpdateViewport();
 
         void WindowSizeCallback(int width, int height);
@@ -174,11 +347,38 @@ namespace mandelbrot
       
         bool is_paused_ = false;
         bool is_stepping_ = false;
+        bool is_synchronous_ = false;
+        bool is_window_visible_ = true;
+        bool needs_redraw_ = true;
 
         Renderer renderer_;
+        ComputeThread compute_thread_;
         Camera camera_;
 
         Stopwatch stopwatch_;
+        Stopwatch startup_stopwatch_;
+        bool has_image_ = false;
+        // Whether a complete image awaits presentation.
+        bool is_image_complete_ = false;
+        bool is_startup_reported_ = false;
+
+        PixelReader pixel_reader_;
+        SnapshotWriter snapshot_writer_;
+        SnapshotWriter::Format snapshot_format_ = SnapshotWriter::Format::Bmp;
+        std::string gl_statistics_path_;
+        std::string stage_times_path_;
+        std::string trace_path_;
+
+        LatencyMonitor latency_monitor_;
+
+        // Overlay figures are averaged since its previous refresh.
+        Stopwatch::TimePoint hud_refresh_time_;
+        unsigned int hud_frame_count_ = 0;
+        unsigned long long hud_iteration_count_ = 0;
+
+        InputLog input_log_;
+        std::string input_recording_path_;
+        bool is_recording_input_ = false;
 
         unsigned int session_saved_snapshots_count_ = 0;
     };
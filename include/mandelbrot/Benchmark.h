@@ -0,0 +1,98 @@
+/**
+ * Standard rendering workload.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mandelbrot/Renderer.h>
+#include <mandelbrot/Vector2.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class renders a set of scenes, loaded from saved state files,
+     * to completion with the renderer's current settings, and reports how
+     * long each took along with the GPU times of each stage.
+     *
+     * Results are written as JSON together with the driver and renderer
+     * settings, so that runs on different machines or builds can be
+     * compared.
+     */
+    class Benchmark
+    {
+        public:
+        /**
+         * Describes a view to render.
+         */
+        struct Scene
+        {
+            std::string name;
+            Vector2d position;
+            double size = 0;
+        };
+        /**
+         * Describes a rendered scene.
+         */
+        struct Result
+        {
+            Scene scene;
+            unsigned int step_count = 0;
+            // Time from reset until the image is displayed.
+            double milliseconds = 0;
+            std::vector<Renderer::StageTime> stage_times;
+        };
+
+        static const char* DEFAULT_STATE_DIRECTORY;
+        static const char* DEFAULT_PATH;
+
+        /**
+         * Gets the paths of state files (.txt) in given directory, sorted
+         * by name.
+         */
+        static std::vector<std::string> FindStatePaths
+        (
+            const std::string& directory
+        );
+        /**
+         * Loads a scene from a state file, as saved along with snapshots.
+         *
+         * @returns Value indicating success.
+         */
+        static bool LoadScene(const std::string& path, Scene& scene);
+
+        /**
+         * Creates a benchmark using given renderer. The renderer must be
+         * initialized, and its context current.
+         */
+        explicit Benchmark(Renderer& renderer);
+
+        /**
+         * Renders given scene to completion and displays it.
+         */
+        Result Run(const Scene& scene);
+
+        /**
+         * Writes given results as JSON.
+         *
+         * @returns Value indicating success.
+         */
+        bool Write
+        (
+            const std::string& path,
+            const std::vector<Result>& results
+        ) const;
+
+        private:
+        static std::string Quote(const std::string& text);
+
+        Renderer* renderer_;
+    };
+}
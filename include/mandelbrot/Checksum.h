@@ -0,0 +1,76 @@
+/**
+ * Checksums used by the image encoders.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace mandelbrot
+{
+    /**
+     * Running CRC-32 checksum (ISO 3309, as used by PNG).
+     */
+    class Crc32
+    {
+        public:
+        /**
+         * Adds given bytes to the checksum.
+         */
+        void Update(const unsigned char* data, std::size_t size);
+
+        /**
+         * Gets checksum value.
+         */
+        std::uint32_t value() const;
+
+        private:
+        std::uint32_t state_ = 0xFFFFFFFF;
+    };
+
+    /**
+     * Running Adler-32 checksum (RFC 1950, as used by zlib streams).
+     */
+    class Adler32
+    {
+        public:
+        /**
+         * Combines the checksums of two consecutive pieces of data.
+         *
+         * @param first         Checksum of the first piece.
+         * @param second        Checksum of the second piece.
+         * @param second_size   Size of the second piece in bytes.
+         *
+         * @returns Checksum of the concatenation.
+         */
+        static std::uint32_t Combine
+        (
+            std::uint32_t first, 
+            std::uint32_t second,
+            std::size_t second_size
+        );
+
+        /**
+         * Adds given bytes to the checksum.
+         */
+        void Update(const unsigned char* data, std::size_t size);
+
+        /**
+         * Gets checksum value.
+         */
+        std::uint32_t value() const;
+
+        private:
+        static const std::uint32_t MODULUS;
+        static const std::size_t MAX_BLOCK_SIZE;
+
+        std::uint32_t a_ = 1;
+        std::uint32_t b_ = 0;
+    };
+}
@@ -10,14 +10,17 @@
 
 #include <memory>
 
+#include <mandelbrot/CpuComputation.h>
 #include <mandelbrot/ProcessingStage.h>
+#include <mandelbrot/Stopwatch.h>
+#include <mandelbrot/SymmetryStage.h>
 #include <mandelbrot/Vector2.h>
 #include <mandelbrot/Box2.h>
 
 #include <oogl/Program.hpp>
 #include <oogl/Texture.hpp>
 #include <oogl/FrameBuffer.hpp>
-#include <oogl/RenderBuffer.hpp>
+#include <oogl/Query.hpp>
 
 
 namespace mandelbrot
@@ -29,11 +32,25 @@ namespace mandelbrot
     class ComputationStage : public ProcessingStage
     {
         public:
+        enum class Mode
+        {
+            Gpu,  // Fragment shader
+            Cpu   // CpuComputation, with distance estimates
+        };
+        enum class Precision
+        {
+            Single,
+            Double
+        };
+
         static const char* VERTEX_SHADER_SOURCE_PATH;
         static const char* FRAGMENT_SHADER_SOURCE_PATH;
 
         static const GLint VALUE_TEXTURE_UNIT_INDEX;
         static const GLint LIFETIME_TEXTURE_UNIT_INDEX;
+        static const GLint COST_TEXTURE_UNIT_INDEX;
+
+        static const double ACTIVE_PIXEL_COUNT_INTERVAL_SECONDS;
 
         /**
          * Creates a new stage.
@@ -50,23 +67,56 @@ namespace mandelbrot
          */
         void Reset();
         /**
-         * Executes one rendering step.
+         * Executes one rendering step. In CPU mode, this performs the 
+         * three parts of a CPU step below in turn.
          */
         void Execute() override;
+        /**
+         * Prepares a CPU mode step, applying the current settings to the
+         * CPU buffers.
+         */
+        void PrepareCpuStep();
+        /**
+         * Evaluates a prepared CPU mode step. Touches nothing but the CPU
+         * buffers, so it may run while other threads use the stage, as 
+         * long as they do not prepare or finish a step meanwhile.
+         */
+        void ExecuteCpuStep();
+        /**
+         * Completes an evaluated CPU mode step. Its results are uploaded 
+         * by the next call to UploadCpuResults().
+         */
+        void FinishCpuStep();
+        /**
+         * Uploads the latest CPU mode results to the output textures, 
+         * unless already there. Call before reading them in CPU mode.
+         */
+        void UploadCpuResults();
+        /**
+         * Fills rows skipped due to symmetry in the output textures. Call
+         * before reading them.
+         */
+        void Mirror();
 
         /**
-         * Gets resolution.
+         * Gets output size in pixels.
          */
-        unsigned int resolution() const;
+        const Vector2u& size() const;
         /**
-         * Sets resolution power-of-two.
+         * Sets output size in pixels.
          */
-        void set_resolution_power(unsigned int value);
+        void set_size(const Vector2u& value);
 
         /**
-         * Gets viewport.
+         * Gets viewport. Its size spans the output's longer side.
          */
         const Box2d& viewport() const;
+        /**
+         * Gets the viewport the current rendering is computed at. It may
+         * be shifted from viewport() by less than half a pixel vertically,
+         * to align with the real axis for symmetry.
+         */
+        const Box2d& computed_viewport() const;
         /**
          * Sets viewport position.
          */
@@ -85,55 +135,203 @@ namespace mandelbrot
          */
         void set_iterations_per_step(unsigned int value);
 
+        /**
+         * Gets floating point precision of GPU iteration.
+         */
+        Precision precision() const;
+        /**
+         * Sets floating point precision of GPU iteration.
+         */
+        void set_precision(Precision value);
+
+        /**
+         * Gets magnitude beyond which orbits escape.
+         */
+        double escape_radius() const;
+        /**
+         * Sets magnitude beyond which orbits escape, at least 2.
+         */
+        void set_escape_radius(double value);
+
+        /**
+         * Gets value indicating whether the GPU stops iterating orbits
+         * attracted to a cycle.
+         */
+        bool detects_interior() const;
+        /**
+         * Sets value indicating whether the GPU stops iterating orbits
+         * attracted to a cycle.
+         */
+        void set_detects_interior(bool value);
+
+        /**
+         * Gets value indicating whether only one side of the real axis is
+         * computed when the viewport straddles it.
+         */
+        bool is_symmetric() const;
+        /**
+         * Sets value indicating whether only one side of the real axis is
+         * computed when the viewport straddles it. The viewport may shift
+         * by less than half a pixel vertically to align with the axis.
+         */
+        void set_is_symmetric(bool value);
+
+        /**
+         * Gets computation mode.
+         */
+        Mode mode() const;
+        /**
+         * Sets computation mode.
+         */
+        void set_mode(Mode value);
+
+        /**
+         * Gets value indicating whether CPU mode only skips pixels proven
+         * to be uniform.
+         */
+        bool is_proven_only() const;
+        /**
+         * Sets value indicating whether CPU mode only skips pixels proven
+         * to be uniform.
+         */
+        void set_is_proven_only(bool value);
+        /**
+         * Gets the fraction of the output proven to be uniform by CPU mode 
+         * since the last reset.
+         */
+        double proven_fraction() const;
+
+        /**
+         * Gets value indicating whether pixels still iterated are counted
+         * in GPU mode.
+         */
+        bool counts_active_pixels() const;
+        /**
+         * Sets value indicating whether pixels still iterated are counted
+         * in GPU mode. Counting takes an extra pass over the computed 
+         * pixels at most every ACTIVE_PIXEL_COUNT_INTERVAL_SECONDS.
+         */
+        void set_counts_active_pixels(bool value);
+        /**
+         * Gets the fraction of computed pixels still iterated, as of the 
+         * latest count, or a negative value if there is none.
+         */
+        double active_fraction() const;
+
+        /**
+         * Gets value indicating whether the iterations executed per pixel 
+         * are recorded.
+         */
+        bool records_cost() const;
+        /**
+         * Sets value indicating whether the iterations executed per pixel 
+         * are recorded. Resets the current rendering.
+         */
+        void set_records_cost(bool value);
+
         /**
          * Gets value texture.
          */
         oogl::Texture& value_texture();
         /**
-         * Gets lifetime texture.
+         * Gets lifetime texture. Its second channel is non-zero for pixels
+         * found to be inside the set, which are no longer iterated.
          */
         oogl::Texture& lifetime_texture();
+        /**
+         * Gets texture of estimated distances to the set, in complex plane
+         * units. Only written in CPU mode, zero elsewhere.
+         */
+        oogl::Texture& distance_texture();
+        /**
+         * Gets texture of the iterations executed per pixel since the last
+         * reset, or null when not recorded. Unlike lifetimes, it counts
+         * nothing for pixels copied by symmetry or filled in by CPU mode.
+         */
+        oogl::Texture* cost_texture();
+
+        protected:
+        /**
+         * Gets the definitions specializing the kernel to the current
+         * settings: the iteration loop is unrolled to the number of 
+         * iterations per step, and disabled features are compiled out.
+         */
+        oogl::Shader::Definitions GetDefinitions() const override;
 
         private:
         bool InitializeTextures();
-        bool InitializeTexture
+        void AcquireTextures();
+        void AcquireTexture
         (
             GLint internal_format, 
-            GLenum data_format,
-            GLenum data_type,
             std::unique_ptr<oogl::Texture>& texture
         );
+        void ReleaseCostTextures();
         bool InitializeBuffers();
         bool InitializeUniforms();
 
+        void UpdateProgram();
         void UpdateUniforms();
-        void UpdateResolution();
+        void UpdateMirroredRows(Vector2d& bottom_left);
+        void UpdateSize();
         void SwapBuffers();
         void ComputeStep();
+        void DrawComputedRows();
+        void CountActivePixels();
 
-        unsigned int resolution_ = 512;
+        Vector2u size_ = Vector2u(512, 512);
         Box2d viewport_ = Box2d(-2, -1.5, 3);
+        Box2d computed_viewport_ = Box2d(-2, -1.5, 3);
         unsigned int iterations_per_step_ = 1;
+        Precision precision_ = Precision::Double;
+        double escape_radius_ = 2;
+        bool detects_interior_ = true;
+        bool records_cost_ = false;
+
+        bool is_symmetric_ = false;
+        GLint mirrored_rows_begin_ = 0;
+        GLint mirrored_rows_end_ = 0;
+        GLint mirror_axis_ = 0;
+        SymmetryStage symmetry_stage_;
+
+        Mode mode_ = Mode::Gpu;
+        // Only accessed by the thread performing steps, and not shared 
+        // with other settings, so that CPU steps can run outside locks.
+        CpuComputation cpu_computation_;
+        unsigned int cpu_iteration_count_ = 1;
+        bool is_proven_only_ = false;
+        double proven_fraction_ = 0;
+        bool cpu_results_need_upload_ = false;
+
+        bool counts_active_pixels_ = false;
+        // At most one count is in flight, read back once available.
+        std::unique_ptr<oogl::Query> active_pixel_query_;
+        bool is_active_pixel_query_pending_ = false;
+        Stopwatch::TimePoint active_pixel_count_time_;
+        double counted_pixel_count_ = 0;
+        double active_fraction_ = -1;
 
         std::unique_ptr<oogl::Texture> in_value_texture_;
         std::unique_ptr<oogl::Texture> in_lifetime_texture_;
         std::unique_ptr<oogl::Texture> out_value_texture_;
         std::unique_ptr<oogl::Texture> out_lifetime_texture_;
+        std::unique_ptr<oogl::Texture> distance_texture_;
+        std::unique_ptr<oogl::Texture> in_cost_texture_;
+        std::unique_ptr<oogl::Texture> out_cost_texture_;
+        std::unique_ptr<oogl::Texture> depth_texture_;
         
         std::unique_ptr<oogl::FrameBuffer> frame_buffer_;
-        std::unique_ptr<oogl::RenderBuffer> depth_render_buffer_;
 
         oogl::Uniform2d uniform_viewport_bottom_left_;
-        oogl::Uniform1d uniform_viewport_size_;
+        oogl::Uniform2d uniform_viewport_size_;
 
         oogl::Uniform1i uniform_value_texture_;
         oogl::Uniform1i uniform_lifetime_texture_;
+        oogl::Uniform1i uniform_cost_texture_;
 
-        oogl::Uniform1i uniform_iterations_per_step_;
-
-        bool resolution_needs_update_ = true;
+        bool size_needs_update_ = true;
         bool viewport_position_needs_update_ = true;
         bool viewport_size_needs_update_ = true;
-        bool iterations_per_step_needs_update_ = true;
+        bool variant_needs_update_ = false;
     };
 }
@@ -0,0 +1,136 @@
+/**
+ * Background computation thread.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <glew/glew.h>
+#include <glfw/glfw3.h>
+
+#include <mandelbrot/Renderer.h>
+
+#include <oogl/Fence.hpp>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class runs the computation and coloring stages of a renderer on
+     * a worker thread with its own shared OpenGL context, so that the
+     * display thread can keep presenting the cached image while the
+     * fractal is being evaluated. CPU mode steps are evaluated without
+     * holding the lock, which is only taken to begin and end them.
+     *
+     * Finished images are handed over through a fence and are picked up by
+     * the display thread without blocking. The copy into the cache is
+     * fenced in turn, and the worker's next commands wait for it on the
+     * GPU before overwriting the textures it reads from.
+     */
+    class ComputeThread
+    {
+        public:
+        typedef std::unique_lock<std::mutex> Lock;
+
+        /**
+         * Creates a thread working on given renderer.
+         */
+        ComputeThread(Renderer& renderer);
+        /**
+         * Stops the thread.
+         */
+        ~ComputeThread();
+
+        /**
+         * Creates a hidden context sharing objects with given window,
+         * initializes the renderer's computation resources in it, and
+         * launches the thread.
+         *
+         * @note Must be called from the thread owning the window.
+         */
+        bool Start(GLFWwindow* shared_window);
+        /**
+         * Stops the thread and destroys its context.
+         *
+         * @note Must be called from the thread owning the window.
+         */
+        void Stop();
+
+        /**
+         * Acquires exclusive access to the renderer.
+         * The display thread must hold it while modifying the renderer.
+         */
+        Lock Acquire();
+        /**
+         * Wakes the thread after the renderer was modified.
+         */
+        void Notify();
+
+        /**
+         * Moves a finished image to the renderer's cache if the GPU is done
+         * producing it.
+         *
+         * @note Caller must hold the lock.
+         *
+         * @returns Value indicating whether the cache was updated.
+         */
+        bool PollImage();
+
+        /**
+         * Checks whether the thread is running.
+         */
+        bool is_running() const;
+        /**
+         * Checks whether an image awaits pickup.
+         *
+         * @note Caller must hold the lock.
+         */
+        bool is_image_pending() const;
+
+        /**
+         * Allows or disallows the thread to perform rendering steps.
+         *
+         * @note Caller must hold the lock.
+         */
+        void set_is_enabled(bool value);
+
+        /**
+         * Gets string containing status information.
+         */
+        const char* status_message() const;
+
+        ComputeThread(const ComputeThread&) = delete;
+        ComputeThread& operator=(const ComputeThread&) = delete;
+
+        private:
+        static const GLuint64 FENCE_TIMEOUT_NANOSECONDS;
+
+        void Run();
+        bool has_work() const;
+
+        Renderer* renderer_;
+        GLFWwindow* context_ = nullptr;
+
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+
+        bool is_running_ = false;
+        bool is_enabled_ = false;
+
+        std::unique_ptr<oogl::Fence> image_fence_;
+        std::unique_ptr<oogl::Fence> cache_fence_;
+        bool is_image_pending_ = false;
+
+        std::string status_message_;
+    };
+}
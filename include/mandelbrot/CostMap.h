@@ -0,0 +1,89 @@
+/**
+ * Per-pixel iteration cost of a rendering.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include <mandelbrot/Vector2.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class holds the iterations executed per pixel, rows bottom
+     * first as read back from OpenGL, and summarizes how concentrated they
+     * are.
+     */
+    class CostMap
+    {
+        public:
+        /**
+         * Summary of a cost map.
+         */
+        struct Summary
+        {
+            unsigned long long total = 0;
+            unsigned int maximum = 0;
+            double mean = 0;
+            // Shares of the total spent on the costliest pixels.
+            double top_1_percent_share = 0;
+            double top_10_percent_share = 0;
+            // Fraction of pixels that cost nothing.
+            double free_fraction = 0;
+        };
+
+        /**
+         * Creates an empty map.
+         */
+        CostMap() = default;
+        /**
+         * Creates a map of given size, with all costs zero.
+         */
+        explicit CostMap(const Vector2u& size);
+
+        /**
+         * Resizes map, setting all costs to zero.
+         */
+        void Resize(const Vector2u& size);
+
+        /**
+         * Summarizes the map.
+         */
+        Summary GetSummary() const;
+        /**
+         * Gets the share of the total spent on the given fraction of
+         * costliest pixels.
+         */
+        double GetTopShare(double fraction) const;
+
+        /**
+         * Encodes the map as raw little-endian 32-bit unsigned integers,
+         * rows top first.
+         */
+        std::vector<unsigned char> Encode() const;
+
+        /**
+         * Gets size in pixels.
+         */
+        const Vector2u& size() const;
+
+        /**
+         * Gets costs (read only).
+         */
+        const unsigned int* data() const;
+        /**
+         * Gets costs.
+         */
+        unsigned int* data();
+
+        private:
+        Vector2u size_;
+        std::vector<unsigned int> costs_;
+    };
+}
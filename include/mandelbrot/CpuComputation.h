@@ -0,0 +1,223 @@
+/**
+ * Evaluates the mandelbrot fractal on the CPU.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <mandelbrot/ThreadPool.h>
+#include <mandelbrot/TileClassifier.h>
+#include <mandelbrot/Vector2.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * Evaluates the mandelbrot fractal along with its derivative with
+     * respect to c, which yields an estimate of each escaped point's
+     * distance to the set.
+     *
+     * By the Koebe 1/4 theorem, a disk of a quarter of that distance around
+     * an escaped point lies outside the set. Pixels within it are filled in
+     * without iterating, their lifetime extrapolated from the point's
+     * potential gradient. Pixels are visited coarse-to-fine so large disks
+     * are found early.
+     *
+     * Rows are split into bands evaluated in parallel on a thread pool. A
+     * disk is clipped to its center's band, so bands never write to each
+     * other's pixels and results do not depend on scheduling.
+     *
+     * Output layout matches the computation stage's textures: rows are
+     * bottom-up, values are escaped z pairs, lifetimes are escape times.
+     */
+    class CpuComputation
+    {
+        public:
+        /**
+         * Resets evaluation.
+         */
+        void Reset();
+        /**
+         * Evaluates a number of further iterations for every pixel that has
+         * neither escaped nor been filled.
+         */
+        void Execute(unsigned int iteration_count);
+
+        /**
+         * Gets output size in pixels.
+         */
+        const Vector2u& size() const;
+        /**
+         * Sets output size in pixels. Resets evaluation if changed.
+         */
+        void set_size(const Vector2u& value);
+
+        /**
+         * Gets magnitude beyond which orbits escape.
+         */
+        double escape_radius() const;
+        /**
+         * Sets magnitude beyond which orbits escape. Resets evaluation if 
+         * changed.
+         */
+        void set_escape_radius(double value);
+
+        /**
+         * Sets the complex plane position of the bottom-left corner and the
+         * pixel pitch. Resets evaluation.
+         */
+        void set_viewport(const Vector2d& bottom_left, double pixel_size);
+
+        /**
+         * Gets values, two floats per pixel.
+         */
+        const float* values() const;
+        /**
+         * Gets lifetimes and interior flags, two ints per pixel.
+         */
+        const int* lifetimes() const;
+        /**
+         * Gets estimated distances to the set's boundary in complex plane
+         * units, one per pixel. Negative inside the set, zero where 
+         * unknown.
+         */
+        const float* distances() const;
+        /**
+         * Gets the number of iterations executed for each pixel since the
+         * last reset. Pixels filled in cost nothing; the iterations of a 
+         * distance estimate or a cycle's refinement are charged to the 
+         * pixel they started from. Tile classification is not included.
+         */
+        const unsigned int* costs() const;
+
+        /**
+         * Gets the number of pixels filled in without iterating since the
+         * last reset, inside or outside the set.
+         */
+        std::size_t filled_count() const;
+        /**
+         * Gets the number of pixels in tiles proven to be uniform since the
+         * last reset.
+         */
+        std::size_t proven_count() const;
+
+        /**
+         * Gets value indicating whether pixels are only skipped when proven
+         * to be uniform.
+         */
+        bool is_proven_only() const;
+        /**
+         * Sets value indicating whether pixels are only skipped when proven
+         * to be uniform. Resets evaluation if changed.
+         */
+        void set_is_proven_only(bool value);
+
+        private:
+        typedef std::complex<double> Complex;
+
+        enum class State : unsigned char
+        {
+            Pending,
+            Escaped,
+            Interior,
+            Filled
+        };
+
+        static const double ESTIMATE_ESCAPE_RADIUS;
+        static const unsigned int MAX_ESTIMATE_ITERATION_COUNT;
+        static const unsigned int COARSEST_STRIDE;
+        static const unsigned int TILE_SIZE;
+        static const double CYCLE_EPSILON;
+        static const unsigned int NEWTON_ITERATION_COUNT;
+
+        // Rows [begin_row, end_row), with the pixels filled in them.
+        struct Band
+        {
+            unsigned int begin_row;
+            unsigned int end_row;
+            std::size_t filled_count;
+            std::size_t proven_count;
+        };
+
+        static const unsigned int BAND_HEIGHT;
+
+        void ExecuteBand
+        (
+            Band& band, 
+            unsigned int iteration_count, 
+            bool is_reset
+        );
+        void Iterate
+        (
+            Band& band,
+            std::size_t index, 
+            const Complex& c, 
+            unsigned int count
+        );
+        void FillExterior
+        (
+            Band& band,
+            std::size_t center_index,
+            const Complex& c,
+            Complex z, Complex dz,
+            int lifetime
+        );
+        void FillInterior
+        (
+            Band& band,
+            std::size_t center_index,
+            const Complex& c,
+            const Complex& z,
+            int period
+        );
+        void FillDisk
+        (
+            Band& band,
+            std::size_t center_index,
+            double radius,
+            State state,
+            const std::function<void(std::size_t, const Complex&)>& fill
+        );
+        void CreateTiles();
+        void CreateBands();
+        void FillTile(Band& band, std::size_t tile_index);
+        void SetSmoothLifetime(std::size_t index, double smooth_lifetime);
+
+        Complex position(unsigned int x, unsigned int y) const;
+
+        Vector2u size_ = Vector2u(1, 1);
+        Vector2d bottom_left_ = Vector2d(-2, -1.5);
+        double pixel_size_ = 3;
+        double escape_radius_ = 2;
+
+        std::vector<Complex> z_;
+        std::vector<Complex> dz_;
+        std::vector<Complex> reference_z_;
+        std::vector<Complex> multipliers_;
+        std::vector<State> states_;
+        std::vector<float> values_;
+        std::vector<int> lifetimes_;
+        std::vector<float> distances_;
+        std::vector<unsigned int> costs_;
+
+        std::vector<TileClassifier> tiles_;
+        unsigned int tile_column_count_ = 0;
+
+        std::vector<Band> bands_;
+        std::unique_ptr<ThreadPool> thread_pool_;
+
+        std::size_t filled_count_ = 0;
+        std::size_t proven_count_ = 0;
+        bool is_proven_only_ = false;
+        bool needs_reset_ = true;
+    };
+}
@@ -0,0 +1,99 @@
+/**
+ * DEFLATE compressor.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace mandelbrot
+{
+    /**
+     * Compresses data into a raw DEFLATE (RFC 1951) bit stream.
+     *
+     * Matches are found greedily through hash chains over a sliding 32K 
+     * window and are coded with the fixed Huffman tables, which keeps the
+     * compressor small and fast while still removing most of the 
+     * redundancy left in filtered image rows.
+     *
+     * Data may be fed incrementally; the window carries over between 
+     * calls, and memory use is bounded regardless of the input size.
+     */
+    class Deflater
+    {
+        public:
+        /**
+         * Creates a compressor.
+         */
+        Deflater();
+
+        /**
+         * Compresses given data.
+         */
+        void Compress(const unsigned char* data, std::size_t size);
+        /**
+         * Pads the output to a byte boundary with an empty stored block.
+         * Output produced so far may then be concatenated with the output 
+         * of another compressor.
+         */
+        void Flush();
+        /**
+         * Terminates the stream with an empty final block.
+         */
+        void Finish();
+
+        /**
+         * Gets compressed bytes produced so far.
+         */
+        std::vector<unsigned char>& output();
+
+        private:
+        static const std::size_t WINDOW_SIZE;
+        static const std::size_t HASH_SIZE;
+        static const std::size_t MIN_MATCH_LENGTH;
+        static const std::size_t MAX_MATCH_LENGTH;
+        static const unsigned int MAX_CHAIN_LENGTH;
+
+        void Process(std::size_t end);
+        void Insert(std::size_t position);
+        std::size_t FindMatch
+        (
+            std::size_t position,
+            std::size_t max_length,
+            std::size_t& distance
+        ) const;
+        std::size_t Hash(std::size_t position) const;
+
+        void BeginBlock(bool is_final);
+        void EndBlock();
+        void WriteLiteral(unsigned char value);
+        void WriteMatch(std::size_t length, std::size_t distance);
+        void WriteSymbol(unsigned int symbol);
+        void WriteCode(unsigned int code, unsigned int length);
+        void WriteBits(std::uint32_t value, unsigned int count);
+        void AlignToByte();
+
+        // Sliding window: bytes at absolute positions 
+        // [window_begin_, window_begin_ + window_.size()).
+        std::vector<unsigned char> window_;
+        std::size_t window_begin_ = 0;
+        std::size_t position_ = 0;
+
+        // Hash chains hold absolute positions plus one (zero is empty).
+        std::vector<std::size_t> head_;
+        std::vector<std::size_t> previous_;
+
+        bool is_block_open_ = false;
+
+        std::uint64_t bit_buffer_ = 0;
+        unsigned int bit_count_ = 0;
+        std::vector<unsigned char> output_;
+    };
+}
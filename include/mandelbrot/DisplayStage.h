@@ -52,6 +52,18 @@ namespace mandelbrot
             const Vector2d& position,
             double size
         );
+        /**
+         * Saves the iterations executed per pixel of the cached image.
+         */
+        void UpdateCostCache(const oogl::Texture& texture);
+        /**
+         * Marks the cached cost as stale until the next UpdateCostCache().
+         */
+        void InvalidateCostCache();
+        /**
+         * Returns the cached cost's texture to the pool.
+         */
+        void ReleaseCostCache();
 
         /**
          * Gets display window size.
@@ -63,7 +75,7 @@ namespace mandelbrot
         void set_display_size(const Vector2u& value);
 
         /**
-         * Gets saved viewport.
+         * Gets saved viewport. Its size spans the image's longer side.
          */
         const Box2d& viewport() const;
 
@@ -72,19 +84,29 @@ namespace mandelbrot
          */
         void set_relative_position_offset(const Vector2d& value);
         /**
-         * Sets relative viewport size offset.
+         * Sets relative viewport size offset, per axis.
          */
-        void set_relative_size_offset(double value);
+        void set_relative_size_offset(const Vector2d& value);
 
+        /**
+         * Gets cached image (read only).
+         */
+        const oogl::Texture& image() const;
         /**
          * Gets cached image.
          */
         oogl::Texture& image();
+        /**
+         * Gets the cached iterations executed per pixel, or null if none 
+         * were saved since the cache was invalidated.
+         */
+        const oogl::Texture* cost() const;
 
         private:
         bool InitializeTextures();
         bool InitializeUniforms();
 
+        void SetImageParameters();
         void UpdateUniforms();
 
         Vector2u display_size_;
@@ -92,13 +114,15 @@ namespace mandelbrot
         Box2d viewport_;
 
         Vector2d relative_position_offset_ = Vector2d(0, 0);
-        double relative_size_factor_ = 1.0f;
+        Vector2d relative_size_factor_ = Vector2d(1, 1);
 
         std::unique_ptr<oogl::Texture> image_texture_;
+        std::unique_ptr<oogl::Texture> cost_texture_;
+        bool is_cost_valid_ = false;
 
         oogl::Uniform1i uniform_image_;
         oogl::Uniform2d uniform_relative_position_offset_;
-        oogl::Uniform1d uniform_relative_size_factor_;
+        oogl::Uniform2d uniform_relative_size_factor_;
 
         bool relative_position_offset_needs_update_ = true;
         bool relative_size_factor_needs_update_ = true;
@@ -0,0 +1,110 @@
+/**
+ * GPU time measurement.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <oogl/Query.hpp>
+
+
+namespace mandelbrot
+{
+    /**
+     * Measures the GPU time of the commands issued between Begin() and 
+     * End(), keeping the last measurements for rolling statistics.
+     *
+     * Results are read back from earlier measurements once available, so
+     * the CPU never waits on the GPU. If every query is still pending, the 
+     * measurement is skipped.
+     *
+     * @note Not thread-safe. Must be used from a single context, and not 
+     *       nested within another timer.
+     */
+    class GpuTimer
+    {
+        public:
+        /**
+         * Rolling statistics in milliseconds.
+         */
+        struct Statistics
+        {
+            unsigned int sample_count = 0;
+            double minimum = 0;
+            double average = 0;
+            double percentile_99 = 0;
+        };
+
+        /**
+         * Measures its lifetime.
+         */
+        class Scope
+        {
+            public:
+            explicit Scope(GpuTimer& timer);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            private:
+            GpuTimer& timer_;
+        };
+
+        static const unsigned int QUERY_COUNT;
+        static const unsigned int DEFAULT_SAMPLE_CAPACITY;
+
+        /**
+         * Starts a measurement, first reading back completed ones.
+         */
+        void Begin();
+        /**
+         * Ends the current measurement.
+         */
+        void End();
+
+        /**
+         * Discards kept measurements.
+         */
+        void Clear();
+        /**
+         * Waits for pending measurements and reads them back.
+         */
+        void Finish();
+
+        /**
+         * Gets statistics of kept measurements.
+         */
+        Statistics statistics() const;
+
+        /**
+         * Gets the number of measurements kept.
+         */
+        unsigned int sample_capacity() const;
+        /**
+         * Sets the number of measurements kept.
+         */
+        void set_sample_capacity(unsigned int value);
+
+        private:
+        void Poll();
+        void ReadOldest();
+
+        // Ring of queries, the oldest pending at first_.
+        std::vector<std::unique_ptr<oogl::Query>> queries_;
+        unsigned int first_ = 0;
+        unsigned int pending_count_ = 0;
+        bool is_measuring_ = false;
+
+        // Milliseconds, oldest first.
+        std::deque<double> samples_;
+        unsigned int sample_capacity_ = DEFAULT_SAMPLE_CAPACITY;
+    };
+}
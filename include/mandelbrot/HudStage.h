@@ -0,0 +1,115 @@
+/**
+ * Draws the on-screen performance overlay.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <mandelbrot/ProcessingStage.h>
+#include <mandelbrot/Vector2.h>
+
+#include <oogl/Program.hpp>
+#include <oogl/Texture.hpp>
+
+
+namespace mandelbrot
+{
+    /**
+     * Draws lines of text over the top-left corner of the display, with a
+     * built-in 5x7 pixel font.
+     *
+     * The text is kept as a small texture of glyph indices, uploaded only
+     * when it changes, so drawing costs a single quad the size of the
+     * overlay. Lowercase letters are shown as uppercase, and characters
+     * missing from the font as blanks.
+     */
+    class HudStage : public ProcessingStage
+    {
+        public:
+        static const char* VERTEX_SHADER_SOURCE_PATH;
+        static const char* FRAGMENT_SHADER_SOURCE_PATH;
+
+        static const GLint TEXT_TEXTURE_UNIT_INDEX;
+        static const GLint FONT_TEXTURE_UNIT_INDEX;
+
+        /**
+         * Size of a font pixel in display pixels.
+         */
+        static const unsigned int PIXEL_SCALE;
+
+        /**
+         * Creates stage.
+         */
+        HudStage();
+
+        /**
+         * Initializes stage.
+         */
+        bool Initialize() override;
+
+        /**
+         * Executes stage, blending the overlay over the default frame
+         * buffer.
+         */
+        void Execute() override;
+
+        /**
+         * Checks whether the overlay is drawn.
+         */
+        bool is_visible() const;
+        /**
+         * Sets whether the overlay is drawn.
+         */
+        void set_is_visible(bool value);
+
+        /**
+         * Gets text, one line per '\n'-separated part.
+         */
+        const std::string& text() const;
+        /**
+         * Sets text, one line per '\n'-separated part.
+         */
+        void set_text(const std::string& value);
+
+        /**
+         * Gets display window size.
+         */
+        const Vector2u& display_size() const;
+        /**
+         * Sets display window size.
+         */
+        void set_display_size(const Vector2u& value);
+
+        private:
+        // Glyph and cell sizes, and the margin around the text, in font
+        // pixels. Match the fragment shader's.
+        static const Vector2u GLYPH_SIZE;
+        static const Vector2u CELL_SIZE;
+        static const unsigned int PADDING;
+
+        bool InitializeTextures();
+        bool InitializeUniforms();
+
+        void UpdateText();
+
+        bool is_visible_ = false;
+
+        std::string text_;
+        Vector2u text_size_ = Vector2u(1, 1);
+        Vector2u display_size_;
+
+        std::unique_ptr<oogl::Texture> text_texture_;
+        std::unique_ptr<oogl::Texture> font_texture_;
+
+        oogl::Uniform1i uniform_text_;
+        oogl::Uniform1i uniform_font_;
+
+        bool text_needs_update_ = true;
+    };
+}
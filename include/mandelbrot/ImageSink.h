@@ -0,0 +1,161 @@
+/**
+ * Streaming image output.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class writes an image to file incrementally, so that images far
+     * larger than available memory may be produced.
+     *
+     * Pixels are fed either as whole rows, top to bottom, or as tiles in
+     * row-major order (left to right, then top to bottom). Tiles are
+     * gathered into a single band of rows spanning the image's width,
+     * which is encoded as soon as it is complete; memory use thus depends
+     * on the image's width and tile height, but not on its height.
+     *
+     * Subclasses implement a particular file format.
+     */
+    class ImageSink
+    {
+        public:
+        /**
+         * Creates a sink for the format matching given path's extension
+         * (PPM for ".ppm", PNG otherwise).
+         */
+        static std::unique_ptr<ImageSink> FromPath(const std::string& path);
+
+        /**
+         * Closes the file if still open, leaving it incomplete.
+         */
+        virtual ~ImageSink();
+
+        /**
+         * Creates file and writes its header.
+         *
+         * @param path          File path.
+         * @param width         Image width in pixels.
+         * @param height        Image height in pixels.
+         * @param channel_count Number of 8-bit channels per pixel.
+         *
+         * @returns Value indicating whether operation was succesful.
+         */
+        bool Open
+        (
+            const std::string& path,
+            unsigned int width, unsigned int height,
+            unsigned int channel_count
+        );
+        /**
+         * Writes tightly packed, full-width rows.
+         *
+         * @param pixels        Pixel rows.
+         * @param row_count     Number of rows.
+         * @param is_bottom_up
+         *      Whether the first row is the bottom one, as is the case for
+         *      data read back from OpenGL.
+         *
+         * @returns Value indicating whether operation was succesful.
+         */
+        bool WriteRows
+        (
+            const unsigned char* pixels,
+            unsigned int row_count,
+            bool is_bottom_up
+        );
+        /**
+         * Writes the next tile. Tiles in the same band must have the same
+         * height, and their widths must add up to the image's width.
+         *
+         * @param pixels        Tile rows.
+         * @param width         Tile width in pixels.
+         * @param height        Tile height in pixels.
+         * @param row_length    Distance between rows in pixels.
+         * @param is_bottom_up  Whether the first row is the bottom one.
+         *
+         * @returns Value indicating whether operation was succesful.
+         */
+        bool WriteTile
+        (
+            const unsigned char* pixels,
+            unsigned int width, unsigned int height,
+            unsigned int row_length,
+            bool is_bottom_up
+        );
+        /**
+         * Writes the file's trailer and closes it.
+         *
+         * @returns
+         *      Value indicating whether all rows were written and the
+         *      file is complete.
+         */
+        bool Close();
+
+        /**
+         * Checks whether a file is open.
+         */
+        bool is_open() const;
+        /**
+         * Gets image width.
+         */
+        unsigned int width() const;
+        /**
+         * Gets image height.
+         */
+        unsigned int height() const;
+        /**
+         * Gets number of channels per pixel.
+         */
+        unsigned int channel_count() const;
+        /**
+         * Gets number of rows written so far.
+         */
+        unsigned int row_count() const;
+
+        protected:
+        /**
+         * Writes the file's header.
+         */
+        virtual bool WriteHeader() = 0;
+        /**
+         * Writes a single row of width() * channel_count() bytes.
+         */
+        virtual bool WriteRow(const unsigned char* row) = 0;
+        /**
+         * Writes the file's trailer.
+         */
+        virtual bool WriteTrailer() = 0;
+
+        /**
+         * Gets output file.
+         */
+        std::ofstream& file();
+
+        private:
+        bool WriteBand();
+
+        std::ofstream file_;
+
+        unsigned int width_ = 0;
+        unsigned int height_ = 0;
+        unsigned int channel_count_ = 0;
+        unsigned int row_count_ = 0;
+
+        // Band of rows gathered from tiles, top-down.
+        std::vector<unsigned char> band_;
+        unsigned int band_height_ = 0;
+        unsigned int band_width_ = 0;
+    };
+}
@@ -0,0 +1,119 @@
+/**
+ * Recorded input sessions.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mandelbrot/Stopwatch.h>
+#include <mandelbrot/Vector2.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class holds the key events and frame times of an interactive
+     * session, so that it may be replayed exactly.
+     *
+     * Sessions are stored as text, one entry per line, which also makes
+     * them easy to write by hand:
+     *
+     *      mandelbrot-input 1
+     *      camera <x> <y> <zoom factor>        (optional)
+     *      k <key> <action> <modifiers>        (GLFW codes)
+     *      f <microseconds> [count]
+     *
+     * Key events apply to the frame that follows them. A frame line may
+     * stand for several consecutive frames of equal duration.
+     */
+    class InputLog
+    {
+        public:
+        struct KeyEvent
+        {
+            int key;
+            int action;
+            int modifiers;
+        };
+        struct Frame
+        {
+            // Key events processed before the frame's camera update.
+            std::vector<KeyEvent> key_events;
+            // Time elapsed since the previous frame.
+            Stopwatch::Duration duration;
+            // Number of consecutive frames this entry stands for.
+            unsigned int count = 1;
+        };
+
+        /**
+         * Reads a session from file, replacing the current one.
+         *
+         * @returns Value indicating success.
+         */
+        bool Read(const std::string& path);
+        /**
+         * Writes the session to file.
+         *
+         * @returns Value indicating success.
+         */
+        bool Write(const std::string& path) const;
+
+        /**
+         * Discards recorded frames and the camera.
+         */
+        void Clear();
+
+        /**
+         * Records a key event, to be processed before the next frame.
+         */
+        void RecordKey(int key, int action, int modifiers);
+        /**
+         * Records a frame, along with the key events recorded since the
+         * previous one.
+         */
+        void RecordFrame(const Stopwatch::Duration& duration);
+
+        /**
+         * Gets recorded frames.
+         */
+        const std::vector<Frame>& frames() const;
+        /**
+         * Gets the total number of frames.
+         */
+        unsigned int frame_count() const;
+
+        /**
+         * Checks whether the session starts from a given camera.
+         */
+        bool has_camera() const;
+        /**
+         * Gets the session's starting camera position.
+         */
+        const Vector2d& camera_position() const;
+        /**
+         * Gets the session's starting camera zoom factor.
+         */
+        double camera_zoom_factor() const;
+        /**
+         * Sets the session's starting camera.
+         */
+        void set_camera(const Vector2d& position, double zoom_factor);
+
+        private:
+        static const char* HEADER;
+        static const unsigned int VERSION;
+
+        std::vector<Frame> frames_;
+        std::vector<KeyEvent> pending_key_events_;
+
+        bool has_camera_ = false;
+        Vector2d camera_position_;
+        double camera_zoom_factor_ = 1;
+    };
+}
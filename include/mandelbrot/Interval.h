@@ -0,0 +1,94 @@
+/**
+ * Interval arithmetic.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace mandelbrot
+{
+    /**
+     * Closed interval of reals. Results of arithmetic contain every result
+     * of the same operation on members of the operands.
+     *
+     * Bounds are widened by one ulp after each operation, which covers the
+     * rounding error of the operation itself.
+     */
+    class Interval
+    {
+        public:
+        Interval() : Interval(0, 0) {}
+        Interval(double value) : Interval(value, value) {}
+        Interval(double lower, double upper) : lower(lower), upper(upper) {}
+
+        double lower, upper;
+
+        /**
+         * Gets the interval's width.
+         */
+        double width() const { return upper - lower; }
+
+        // operator + //
+
+        friend Interval operator+(const Interval& lhs, const Interval& rhs)
+        {
+            return Widen(lhs.lower + rhs.lower, lhs.upper + rhs.upper);
+        }
+
+        // operator - //
+
+        Interval operator-() const
+        {
+            return Interval(-upper, -lower);
+        }
+        friend Interval operator-(const Interval& lhs, const Interval& rhs)
+        {
+            return lhs + -rhs;
+        }
+
+        // operator * //
+
+        friend Interval operator*(const Interval& lhs, const Interval& rhs)
+        {
+            const double a = lhs.lower * rhs.lower;
+            const double b = lhs.lower * rhs.upper;
+            const double c = lhs.upper * rhs.lower;
+            const double d = lhs.upper * rhs.upper;
+
+            return Widen(std::min({ a, b, c, d }), std::max({ a, b, c, d }));
+        }
+        /**
+         * Squares an interval. Tighter than multiplying it by itself, as 
+         * the result is never negative.
+         */
+        friend Interval Square(const Interval& value)
+        {
+            if (value.lower >= 0 || value.upper <= 0) 
+            { 
+                return value * value; 
+            }
+
+            const double extent = std::max(-value.lower, value.upper);
+            return Widen(0, extent * extent);
+        }
+
+        private:
+        static Interval Widen(const double lower, const double upper)
+        {
+            const double infinity = std::numeric_limits<double>::infinity();
+            return Interval
+            (
+                std::nextafter(lower, -infinity),
+                std::nextafter(upper, infinity)
+            );
+        }
+    };
+}
@@ -108,6 +108,9 @@ namespace mandelbrot
 
         private:
         static const int KEY_DEBUG;
+        static const int KEY_WRITE_TRACE;
+        static const int KEY_TOGGLE_HUD;
+        static const int KEY_TOGGLE_COST_HEATMAP;
 
         static void ProcessAxis
         (
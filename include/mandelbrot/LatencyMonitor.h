@@ -0,0 +1,115 @@
+/**
+ * Input-to-display latency measurement.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <deque>
+
+#include <mandelbrot/Stopwatch.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class follows key events through to the frames that show their
+     * effect, keeping the last measurements for rolling statistics.
+     *
+     * Two latencies are measured:
+     *  - Preview: from the earliest key event that moved the camera, to
+     *    the presentation of the next frame, which shows the previous image
+     *    under the new view.
+     *  - Final: from the latest key event, to the presentation of the first
+     *    complete image rendered after the camera moved. For a held key
+     *    this is measured from its release.
+     *
+     * @note Not thread-safe. Meant to be used from the display thread.
+     */
+    class LatencyMonitor
+    {
+        public:
+        /**
+         * Rolling statistics in milliseconds.
+         */
+        struct Statistics
+        {
+            unsigned int sample_count = 0;
+            double median = 0;
+            double percentile_90 = 0;
+            double percentile_99 = 0;
+            double maximum = 0;
+        };
+
+        static const unsigned int DEFAULT_SAMPLE_CAPACITY;
+
+        /**
+         * Marks the arrival of a key event.
+         */
+        void RecordInput();
+        /**
+         * Marks a camera update, following the key events since the last
+         * one if it moved the camera, and dropping them otherwise.
+         */
+        void RecordCameraUpdate(bool is_camera_changed);
+        /**
+         * Marks the presentation of a frame.
+         *
+         * @param is_image_complete Whether the frame shows a complete image
+         *                          rendered since its last reset.
+         */
+        void RecordPresent(bool is_image_complete);
+
+        /**
+         * Discards kept measurements.
+         */
+        void Clear();
+
+        /**
+         * Gets statistics of input-to-first-preview latencies.
+         */
+        Statistics preview_statistics() const;
+        /**
+         * Gets statistics of input-to-final-image latencies.
+         */
+        Statistics final_statistics() const;
+
+        /**
+         * Gets the number of measurements kept of each kind.
+         */
+        unsigned int sample_capacity() const;
+        /**
+         * Sets the number of measurements kept of each kind.
+         */
+        void set_sample_capacity(unsigned int value);
+
+        private:
+        typedef Stopwatch::TimePoint TimePoint;
+
+        static Statistics GetStatistics(const std::deque<double>& samples);
+
+        void AddSample
+        (
+            std::deque<double>& samples,
+            const TimePoint& begin,
+            const TimePoint& end
+        );
+
+        // Key events not yet followed by a camera update.
+        bool has_pending_input_ = false;
+        TimePoint pending_input_time_;
+        TimePoint latest_input_time_;
+
+        bool is_awaiting_preview_ = false;
+        TimePoint preview_input_time_;
+        bool is_awaiting_final_ = false;
+
+        // Milliseconds, oldest first.
+        std::deque<double> preview_samples_;
+        std::deque<double> final_samples_;
+        unsigned int sample_capacity_ = DEFAULT_SAMPLE_CAPACITY;
+    };
+}
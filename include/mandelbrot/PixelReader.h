@@ -0,0 +1,101 @@
+/**
+ * Asynchronous texture readback.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <oogl/Fence.hpp>
+#include <oogl/Texture.hpp>
+#include <oogl/VertexBuffer.hpp>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class downloads RGB texture data without stalling the pipeline.
+     * 
+     * Each read is copied into one of a ring of pixel buffer objects and 
+     * guarded by a fence. Buffers are mapped on a later frame, once the
+     * GPU is done with them, and handed to the read's callback.
+     */
+    class PixelReader
+    {
+        public:
+        /**
+         * Receives the pixels of a completed read, or null if the data
+         * could not be mapped. Data is valid for the duration of the call 
+         * only.
+         */
+        typedef std::function
+        <
+            void
+            (
+                const unsigned char* pixels, 
+                unsigned int width, 
+                unsigned int height
+            )
+        > Callback;
+
+        static const unsigned int CHANNEL_COUNT;
+        static const unsigned int DEFAULT_CAPACITY;
+
+        /**
+         * Creates a reader with default capacity.
+         */
+        PixelReader();
+        /**
+         * Creates a reader with room for given number of reads in flight.
+         */
+        PixelReader(unsigned int capacity);
+
+        /**
+         * Issues a read of given texture's base level.
+         *
+         * @returns 
+         *      Value indicating whether the read was issued - i.e. whether
+         *      there was room for it.
+         */
+        bool Read(oogl::Texture& texture, const Callback& callback);
+        /**
+         * Completes reads the GPU is done with, in order of issue.
+         *
+         * @returns Value indicating whether any reads were completed.
+         */
+        bool Poll();
+        /**
+         * Blocks until all issued reads are complete.
+         */
+        void Finish();
+
+        /**
+         * Checks whether any reads are in flight.
+         */
+        bool is_busy() const;
+
+        private:
+        struct Slot
+        {
+            std::unique_ptr<oogl::VertexBuffer> buffer;
+            GLsizeiptr buffer_size = 0;
+
+            std::unique_ptr<oogl::Fence> fence;
+            unsigned int width = 0;
+            unsigned int height = 0;
+            Callback callback;
+        };
+
+        void Complete(Slot& slot);
+
+        std::vector<Slot> slots_;
+        unsigned int first_ = 0;
+        unsigned int count_ = 0;
+    };
+}
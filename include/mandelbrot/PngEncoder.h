@@ -0,0 +1,124 @@
+/**
+ * PNG image encoder.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+namespace mandelbrot
+{
+    /**
+     * Encodes 8-bit grayscale, RGB or RGBA images as PNG files.
+     *
+     * Large images are split into horizontal stripes that are filtered and
+     * compressed concurrently. Every stripe is deflated independently and 
+     * padded to a byte boundary, so the compressed stripes concatenate 
+     * into a single valid zlib stream, which is stored as one IDAT chunk 
+     * per stripe.
+     */
+    class PngEncoder
+    {
+        public:
+        /**
+         * Creates an encoder using all hardware threads.
+         */
+        PngEncoder();
+        /**
+         * Creates an encoder.
+         *
+         * @param thread_count Maximum number of stripes encoded at once.
+         */
+        explicit PngEncoder(unsigned int thread_count);
+
+        /**
+         * Encodes an image to memory.
+         *
+         * @param pixels        Tightly packed pixel rows.
+         * @param width         Width in pixels.
+         * @param height        Height in pixels.
+         * @param channel_count One of {1, 3, 4}.
+         * @param is_bottom_up  
+         *      Whether the first row is the bottom of the image, as is the 
+         *      case for data read back from OpenGL.
+         * @param[out] output   Encoded file contents.
+         */
+        void Encode
+        (
+            const unsigned char* pixels,
+            unsigned int width, unsigned int height,
+            unsigned int channel_count,
+            bool is_bottom_up,
+            std::vector<unsigned char>& output
+        ) const;
+        /**
+         * Encodes an image to file.
+         *
+         * @returns Value indicating whether operation was succesful.
+         */
+        bool Write
+        (
+            const char* path,
+            const unsigned char* pixels,
+            unsigned int width, unsigned int height,
+            unsigned int channel_count,
+            bool is_bottom_up
+        ) const;
+
+        /**
+         * Writes the PNG signature and header chunk.
+         */
+        static void WriteHeader
+        (
+            unsigned int width, unsigned int height,
+            unsigned int channel_count,
+            std::vector<unsigned char>& output
+        );
+        /**
+         * Writes a chunk.
+         */
+        static void WriteChunk
+        (
+            const char* type,
+            const unsigned char* data,
+            std::size_t size,
+            std::vector<unsigned char>& output
+        );
+        /**
+         * Filters a row with whichever of the five PNG filters yields the 
+         * smallest sum of absolute differences.
+         *
+         * @param row           Row to filter.
+         * @param previous_row  Row above, or null for the first row.
+         * @param row_size      Row size in bytes.
+         * @param pixel_size    Pixel size in bytes.
+         * @param[out] output   
+         *      Filter type byte followed by the filtered row 
+         *      (row_size + 1 bytes).
+         */
+        static void FilterRow
+        (
+            const unsigned char* row,
+            const unsigned char* previous_row,
+            std::size_t row_size,
+            unsigned int pixel_size,
+            unsigned char* output
+        );
+
+        /**
+         * Gets maximum number of stripes encoded at once.
+         */
+        unsigned int thread_count() const;
+
+        private:
+        static const std::size_t MIN_STRIPE_SIZE;
+
+        unsigned int thread_count_;
+    };
+}
@@ -0,0 +1,47 @@
+/**
+ * Streaming PNG output.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <mandelbrot/Checksum.h>
+#include <mandelbrot/Deflater.h>
+#include <mandelbrot/ImageSink.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class writes PNG files row by row.
+     *
+     * Compressed data is written out in IDAT chunks of bounded size as it
+     * is produced, and only the previous row is retained for filtering.
+     */
+    class PngSink : public ImageSink
+    {
+        protected:
+        bool WriteHeader() override;
+        bool WriteRow(const unsigned char* row) override;
+        bool WriteTrailer() override;
+
+        private:
+        static const std::size_t CHUNK_SIZE;
+
+        bool WriteData(bool is_final);
+
+        Deflater deflater_;
+        Adler32 adler_;
+
+        std::vector<unsigned char> previous_row_;
+        std::vector<unsigned char> filtered_row_;
+        std::vector<unsigned char> stream_;
+        std::vector<unsigned char> chunk_;
+    };
+}
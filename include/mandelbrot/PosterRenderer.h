@@ -0,0 +1,172 @@
+/**
+ * Tiled rendering of arbitrarily large images.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <functional>
+
+#include <glew/glew.h>
+
+#include <mandelbrot/Box2.h>
+#include <mandelbrot/Renderer.h>
+#include <mandelbrot/Vector2.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class renders an image larger than the renderer's maximum
+     * resolution as a grid of tiles, each rendered in full by the
+     * renderer at its own sub-viewport.
+     *
+     * Tile viewports are placed at whole multiples of the pixel pitch, so
+     * the pixel grids of adjacent tiles line up with each other and edges
+     * are seamless. With symmetry, the grid is shifted by less than half a
+     * pixel vertically to align with the real axis, as a single tile 
+     * would be.
+     * Tiles are numbered in row-major order starting from the top-left.
+     */
+    class PosterRenderer
+    {
+        public:
+        /**
+         * Describes a single tile.
+         */
+        struct Tile
+        {
+            unsigned int index;
+            unsigned int column;
+            unsigned int row;
+
+            // Top-left corner and size within the poster, in pixels.
+            // Tiles along the right and bottom edges may be smaller.
+            Vector2u position;
+            Vector2u size;
+
+            // Viewport whose size spans the tile's longer side.
+            Box2d viewport;
+        };
+
+        /**
+         * Receives a finished tile, whose image is in the renderer's cache.
+         * Returning false aborts rendering.
+         */
+        typedef std::function<bool(const Tile& tile)> TileCallback;
+        /**
+         * Receives progress after each finished tile.
+         *
+         * @param tile              Finished tile.
+         * @param rendered_count    Number of tiles rendered so far.
+         * @param remaining_count   Number of tiles left to render.
+         * @param seconds           Time taken by the tile.
+         */
+        typedef std::function
+        <
+            void
+            (
+                const Tile& tile,
+                unsigned int rendered_count,
+                unsigned int remaining_count,
+                double seconds
+            )
+        > ProgressCallback;
+
+        /**
+         * Gets the largest tile size supported by the current context and
+         * the renderer.
+         */
+        static unsigned int GetMaxTileSize();
+
+        /**
+         * Creates a poster renderer using given renderer.
+         */
+        explicit PosterRenderer(Renderer& renderer);
+
+        /**
+         * Renders tiles in order, starting from given index.
+         *
+         * @param first_tile_index  Index of first tile to render.
+         * @param tile_callback     Receives finished tiles.
+         * @param progress_callback Receives progress (optional).
+         *
+         * @returns Value indicating whether all tiles were rendered.
+         */
+        bool Render
+        (
+            unsigned int first_tile_index,
+            const TileCallback& tile_callback,
+            const ProgressCallback& progress_callback = nullptr
+        );
+
+        /**
+         * Gets tile with given index.
+         */
+        Tile tile(unsigned int index) const;
+        /**
+         * Gets number of tiles.
+         */
+        unsigned int tile_count() const;
+        /**
+         * Gets number of tile columns.
+         */
+        unsigned int column_count() const;
+        /**
+         * Gets number of tile rows.
+         */
+        unsigned int row_count() const;
+
+        /**
+         * Gets poster size in pixels.
+         */
+        const Vector2u& size() const;
+        /**
+         * Sets poster size in pixels.
+         */
+        void set_size(const Vector2u& value);
+
+        /**
+         * Gets tile size in pixels.
+         */
+        unsigned int tile_size() const;
+        /**
+         * Sets tile size in pixels.
+         */
+        void set_tile_size(unsigned int value);
+
+        /**
+         * Gets viewport center position.
+         */
+        const Vector2d& viewport_position() const;
+        /**
+         * Sets viewport center position.
+         */
+        void set_viewport_position(const Vector2d& value);
+        /**
+         * Gets viewport size along the poster's larger dimension.
+         */
+        double viewport_size() const;
+        /**
+         * Sets viewport size along the poster's larger dimension.
+         */
+        void set_viewport_size(double value);
+
+        private:
+        static const unsigned int MAX_TILE_SIZE;
+        static const GLuint64 FENCE_TIMEOUT_NANOSECONDS;
+
+        void RenderTile(const Tile& tile);
+
+        Renderer* renderer_;
+
+        Vector2u size_ = Vector2u(1, 1);
+        unsigned int tile_size_ = 512;
+
+        Vector2d viewport_position_ = Vector2d(-0.5, 0);
+        double viewport_size_ = 3;
+    };
+}
@@ -0,0 +1,32 @@
+/**
+ * Streaming PPM output.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include <mandelbrot/ImageSink.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class writes binary Netpbm files row by row: PGM for single
+     * channel images, PPM otherwise (alpha is dropped).
+     */
+    class PpmSink : public ImageSink
+    {
+        protected:
+        bool WriteHeader() override;
+        bool WriteRow(const unsigned char* row) override;
+        bool WriteTrailer() override;
+
+        private:
+        std::vector<unsigned char> row_;
+    };
+}
@@ -8,23 +8,38 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 
+#include <oogl/Instrumentation.hpp>
 #include <oogl/Shader.hpp>
 #include <oogl/Program.hpp>
 #include <oogl/VertexArray.hpp>
 #include <oogl/VertexBuffer.hpp>
 
+#include <mandelbrot/GpuTimer.h>
+#include <mandelbrot/ProgramCache.h>
+#include <mandelbrot/TexturePool.h>
+
 
 namespace mandelbrot
 {
     /**
      * Compiles program object and renders a full-screen quad.
+     *
+     * Programs may come in variants, built from the same sources with 
+     * different preprocessor definitions. Each variant is built on first 
+     * use and cached, in memory and on disk.
      */
     class ProcessingStage
     {
         public:
+        /**
+         * Gets the on-disk program cache shared by all stages.
+         */
+        static ProgramCache& program_cache();
+
         /**
          * Creates a new stage from given shader source files.
          */
@@ -52,22 +67,68 @@ namespace mandelbrot
          * Gets status string.
          */
         const char* status_message() const;
+        /**
+         * Gets the current program variant's definitions as a string.
+         */
+        const char* variant_name() const;
+        /**
+         * Gets the pool of the stage's resizable textures.
+         */
+        const TexturePool& texture_pool() const;
+        /**
+         * Gets the GPU timer of the stage's execution, which the stage's 
+         * owner begins and ends around it.
+         */
+        GpuTimer& timer();
+        const GpuTimer& timer() const;
 
         protected:
+        /**
+         * Gets the definitions of the variant to use. None by default.
+         */
+        virtual oogl::Shader::Definitions GetDefinitions() const;
+        /**
+         * Switches to the program variant with given definitions, building
+         * it if needed. The current program is kept on failure.
+         *
+         * @returns Value indicating whether the variant is in use.
+         */
+        bool SelectProgram(const oogl::Shader::Definitions& definitions);
+
         /**
          * Draws full-screen quad.
          */
         void DrawScreenQuad();
 
-        std::unique_ptr<oogl::Program> program_;
+        oogl::Program* program_ = nullptr;
         std::string status_message_;
+        TexturePool texture_pool_;
 
         private:
         static const GLuint ATTRIBUTE_POSITION_INDEX;
         static const GLfloat SCREEN_QUAD_TRIANGLES[2 * 3 * 3];
 
-        bool InitializeShaders();
-        bool InitializeProgram();
+        static std::string GetVariantName
+        (
+            const oogl::Shader::Definitions& definitions
+        );
+
+        std::unique_ptr<oogl::Program> LoadProgram
+        (
+            const oogl::Shader::Definitions& definitions
+        );
+        bool ReadSource
+        (
+            const std::string& path,
+            const oogl::Shader::Definitions& definitions,
+            std::string& source
+        );
+        bool InitializeShaders
+        (
+            const std::string& vertex_shader_source,
+            const std::string& fragment_shader_source
+        );
+        std::unique_ptr<oogl::Program> InitializeProgram();
 
         void CreateAttributes();
         void CreatePositionAttribute();
@@ -78,7 +139,12 @@ namespace mandelbrot
         std::unique_ptr<oogl::Shader> vertex_shader_;
         std::unique_ptr<oogl::Shader> fragment_shader_;
 
+        std::map<std::string, std::unique_ptr<oogl::Program>> programs_;
+        std::string variant_name_;
+
         std::unique_ptr<oogl::VertexArray> vertex_array_;
         std::unique_ptr<oogl::VertexBuffer> position_buffer_;
+
+        GpuTimer timer_;
     };
 }
@@ -0,0 +1,86 @@
+/**
+ * On-disk cache of linked program binaries.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <oogl/Program.hpp>
+
+
+namespace mandelbrot
+{
+    /**
+     * Stores linked programs as driver-specific binaries, so later launches
+     * skip compiling and linking.
+     *
+     * Entries are keyed by a hash of the driver's identification and the
+     * program's sources, so a driver update or a changed shader misses the
+     * cache. A binary the driver still rejects is treated as a miss too, 
+     * and overwritten once the program has been rebuilt.
+     */
+    class ProgramCache
+    {
+        public:
+        static const char* DEFAULT_DIRECTORY;
+
+        /**
+         * Gets cache key of a program built from given sources with the
+         * current context's driver.
+         */
+        static std::string GetKey(const std::vector<std::string>& sources);
+
+        /**
+         * Loads the program stored under given key.
+         *
+         * @returns Linked program, or null on a miss.
+         */
+        std::unique_ptr<oogl::Program> Load(const std::string& key);
+        /**
+         * Stores a linked program under given key. Failure is not an error;
+         * the program is rebuilt on the next launch.
+         *
+         * @note Build the program with its binary retrievable hint set.
+         */
+        void Store(const std::string& key, const oogl::Program& program);
+
+        /**
+         * Gets the cache directory. Empty if caching is disabled.
+         */
+        std::string directory() const;
+        /**
+         * Sets the cache directory, which is created on first store. 
+         * Empty disables caching. Must be set before programs are built.
+         */
+        void set_directory(const std::string& value);
+
+        /**
+         * Gets the number of programs loaded from the cache.
+         */
+        unsigned int hit_count() const;
+        /**
+         * Gets the number of programs not found in the cache, including
+         * all programs while caching is disabled.
+         */
+        unsigned int miss_count() const;
+
+        private:
+        static const char MAGIC[4];
+
+        std::string GetPath(const std::string& key) const;
+
+        std::string directory_ = DEFAULT_DIRECTORY;
+
+        // Programs are built on both the display and compute threads.
+        std::atomic<unsigned int> hit_count_{ 0 };
+        std::atomic<unsigned int> miss_count_{ 0 };
+    };
+}
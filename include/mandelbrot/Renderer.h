@@ -9,11 +9,16 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <mandelbrot/ColorArray.h>
 #include <mandelbrot/ComputationStage.h>
+#include <mandelbrot/CostMap.h>
 #include <mandelbrot/SmoothColoringStage.h>
 #include <mandelbrot/DisplayStage.h>
+#include <mandelbrot/HudStage.h>
+#include <mandelbrot/ImageSink.h>
+#include <mandelbrot/PixelReader.h>
 #include <mandelbrot/Box2.h>
 #include <mandelbrot/Vector2.h>
 
@@ -26,6 +31,15 @@ namespace mandelbrot
     class Renderer
     {
         public:
+        /**
+         * GPU time of a stage's executions.
+         */
+        struct StageTime
+        {
+            const char* stage;
+            GpuTimer::Statistics statistics;
+        };
+
         enum class Resolution : unsigned int
         {
             Size_2    = 1,  // Power-of-two
@@ -47,9 +61,22 @@ namespace mandelbrot
          * Should be called once before attempting to render.
          */
         bool Initialize();
+        /**
+         * Initializes computation and coloring resources in the current 
+         * context.
+         */
+        bool InitializeComputation();
+        /**
+         * Initializes display resources in the current context.
+         */
+        bool InitializeDisplay();
 
         /**
          * Resets any rendering that is currently in progress.
+         *
+         * @note
+         *      Issues no OpenGL commands. The computation is cleared by 
+         *      the next call to RenderStep() or BeginStep().
          */
         void Reset();
         /**
@@ -57,11 +84,43 @@ namespace mandelbrot
          * function for a fixed amount of iterations.
          */
         void RenderStep();
+        /**
+         * Begins a rendering step, as the first of RenderStep()'s parts.
+         * GPU mode steps are issued in full, CPU mode steps are only 
+         * prepared.
+         *
+         * @returns 
+         *      Value indicating whether ExecuteCpuStep() must be called 
+         *      before EndStep().
+         */
+        bool BeginStep();
+        /**
+         * Evaluates a CPU mode step begun by BeginStep(). Touches only CPU
+         * mode's buffers, so the caller need not hold exclusive access to
+         * the renderer meanwhile, as long as it does from BeginStep() and
+         * around EndStep().
+         */
+        void ExecuteCpuStep();
+        /**
+         * Ends a rendering step. A step is discarded if the renderer was 
+         * reset since it began.
+         *
+         * @returns Value indicating whether the step was counted.
+         */
+        bool EndStep();
         /**
          * Finalizes the current rendering operation, colors the image and
          * saves it to the cache.
          */
         void Flush();
+        /**
+         * Colors the current rendering without saving it to the cache.
+         */
+        void Color();
+        /**
+         * Saves the most recently colored image to the cache.
+         */
+        void UpdateCache();
         /**
          * Renders image from cache.
          */
@@ -71,6 +130,40 @@ namespace mandelbrot
          * Gets rendering's image data.
          */
         void GetImagePixels(unsigned char* buffer);
+        /**
+         * Gets the iterations executed per pixel of the cached image, rows
+         * bottom first.
+         *
+         * @returns 
+         *      Value indicating whether they were recorded for the cached
+         *      image since the last reset.
+         */
+        bool GetCostMap(CostMap& map);
+        /**
+         * Issues an asynchronous read of the rendering's image data.
+         *
+         * @returns Value indicating whether the read was issued.
+         */
+        bool ReadImagePixels
+        (
+            PixelReader& reader, 
+            const PixelReader::Callback& callback
+        );
+        /**
+         * Feeds the top-left part of the rendering's image to given sink 
+         * as its next tile.
+         *
+         * @param sink      RGB image sink.
+         * @param width     Tile width, at most the image's width.
+         * @param height    Tile height, at most the image's height.
+         *
+         * @returns Value indicating whether the tile was accepted.
+         */
+        bool WriteImageTile
+        (
+            ImageSink& sink, 
+            unsigned int width, unsigned int height
+        );
 
         /**
          * Checks whether the renderer is properly initialized.
@@ -85,26 +178,33 @@ namespace mandelbrot
          * Checks whether rendering is complete.
          */
         bool is_done() const;
+        /**
+         * Gets the number of rendering steps since the last reset.
+         */
+        unsigned int step_count() const;
+        /**
+         * Gets the number of pixel iterations issued since initialization,
+         * including those of pixels already done.
+         */
+        unsigned long long iteration_count() const;
 
         /**
-         * Gets image size.
+         * Gets display size.
          */
         const Vector2u& display_size() const;
         /**
-         * Sets image size.
+         * Sets display size. 
+         * The rendered image's size follows its proportions.
          */
         void set_display_size(const Vector2u& value);
 
         /**
-         * Gets resolution.
+         * Gets resolution - i.e. the rendered image's longer side.
          */
         unsigned int resolution() const;
         /**
-         * Sets resolution.
-         *
-         * @note 
-         *      Given value will be ceil'd towards the nearest 
-         *      power-of-two that contains it.
+         * Sets resolution - i.e. the rendered image's longer side. 
+         * The shorter side follows the display's proportions.
          */
         void set_resolution(unsigned int value);
         /**
@@ -112,6 +212,16 @@ namespace mandelbrot
          */
         void set_resolution(Resolution value);
 
+        /**
+         * Gets rendered image size.
+         */
+        const Vector2u& image_size() const;
+        /**
+         * Sets rendered image size explicitly, regardless of the display's
+         * proportions, until the resolution or display size change.
+         */
+        void set_image_size(const Vector2u& value);
+
         /**
          * Gets color map.
          */
@@ -132,6 +242,54 @@ namespace mandelbrot
          */
         void set_iterations_per_step(unsigned int value);
 
+        /**
+         * Gets floating point precision of GPU iteration.
+         */
+        ComputationStage::Precision precision() const;
+        /**
+         * Sets floating point precision of GPU iteration.
+         */
+        void set_precision(ComputationStage::Precision value);
+        /**
+         * Gets magnitude beyond which orbits escape.
+         */
+        double escape_radius() const;
+        /**
+         * Sets magnitude beyond which orbits escape, at least 2.
+         */
+        void set_escape_radius(double value);
+        /**
+         * Gets value indicating whether the GPU stops iterating orbits
+         * attracted to a cycle.
+         */
+        bool detects_interior() const;
+        /**
+         * Sets value indicating whether the GPU stops iterating orbits
+         * attracted to a cycle.
+         */
+        void set_detects_interior(bool value);
+        /**
+         * Gets the definitions of the computation kernel variant in use.
+         */
+        const char* computation_variant_name() const;
+        /**
+         * Gets the combined memory usage of the stages' texture pools.
+         */
+        TexturePool::Statistics texture_pool_statistics() const;
+        /**
+         * Gets rolling GPU times of the computation, coloring and display
+         * stages, in that order.
+         */
+        std::vector<StageTime> stage_times() const;
+        /**
+         * Discards the stages' GPU times.
+         */
+        void ClearStageTimes();
+        /**
+         * Waits for the stages' pending GPU times.
+         */
+        void FinishStageTimes();
+
         /**
          * Gets the maximum number of rendering steps.
          */
@@ -142,7 +300,66 @@ namespace mandelbrot
         void set_max_step_count(unsigned int value);
 
         /**
-         * Gets viewport.
+         * Gets value indicating whether rows mirrored across the real axis
+         * are copied instead of computed.
+         */
+        bool is_symmetric() const;
+        /**
+         * Sets value indicating whether rows mirrored across the real axis
+         * are copied instead of computed.
+         */
+        void set_is_symmetric(bool value);
+
+        /**
+         * Gets computation mode.
+         */
+        ComputationStage::Mode computation_mode() const;
+        /**
+         * Sets computation mode.
+         */
+        void set_computation_mode(ComputationStage::Mode value);
+        /**
+         * Gets value indicating whether CPU mode only skips pixels proven
+         * to be uniform.
+         */
+        bool is_proven_only() const;
+        /**
+         * Sets value indicating whether CPU mode only skips pixels proven
+         * to be uniform.
+         */
+        void set_is_proven_only(bool value);
+        /**
+         * Gets the fraction of the image proven to be uniform by CPU mode.
+         */
+        double proven_fraction() const;
+        /**
+         * Gets value indicating whether GPU mode counts the pixels still
+         * iterated.
+         */
+        bool counts_active_pixels() const;
+        /**
+         * Sets value indicating whether GPU mode counts the pixels still
+         * iterated.
+         */
+        void set_counts_active_pixels(bool value);
+        /**
+         * Gets the fraction of computed pixels still iterated, as of the
+         * latest count, or a negative value if there is none.
+         */
+        double active_fraction() const;
+        /**
+         * Gets value indicating whether the iterations executed per pixel
+         * are recorded and shown as a heatmap instead of the fractal.
+         */
+        bool shows_cost() const;
+        /**
+         * Sets value indicating whether the iterations executed per pixel
+         * are recorded and shown as a heatmap instead of the fractal.
+         */
+        void set_shows_cost(bool value);
+
+        /**
+         * Gets viewport. Its size spans the image's longer side.
          */
         const Box2d& viewport() const;
         /**
@@ -157,15 +374,38 @@ namespace mandelbrot
          * Gets display viewport.
          */
         const Box2d& display_viewport() const;
+        /**
+         * Gets size of the displayed image.
+         */
+        Vector2u display_image_size() const;
+
+        /**
+         * Gets the performance overlay (read only).
+         */
+        const HudStage& hud() const;
+        /**
+         * Gets the performance overlay, drawn by Render() when visible.
+         */
+        HudStage& hud();
 
         private:
+        void UpdateImageSize();
+
+        unsigned int resolution_ = 512;
+
         unsigned int step_count_ = 0;
         unsigned int max_step_count_ = 1;
+        unsigned long long iteration_count_ = 0;
+
+        bool computation_needs_reset_ = true;
+
+        Box2d colored_viewport_;
 
         std::string status_message_;
 
         ComputationStage computation_stage_;
         SmoothColoringStage coloring_stage_;
         DisplayStage display_stage_;
+        HudStage hud_stage_;
     };
 }
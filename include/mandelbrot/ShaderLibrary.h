@@ -0,0 +1,43 @@
+/**
+ * Shader sources embedded in the executable.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <string>
+
+
+namespace mandelbrot
+{
+    /**
+     * Looks up shader sources, which are embedded at build time from the
+     * shaders directory by a pre-build step. Sources that are not embedded
+     * are read from disk.
+     */
+    class ShaderLibrary
+    {
+        public:
+        /**
+         * Gets the source of the shader at given path. Embedded sources are
+         * matched by file name.
+         *
+         * @returns Value indicating whether the source was found.
+         */
+        static bool ReadSource(const std::string& path, std::string& source);
+
+        private:
+        struct Entry
+        {
+            const char* name;
+            const char* source;
+        };
+
+        static const Entry EMBEDDED_SOURCES[];
+
+        static const Entry* Find(const std::string& path);
+    };
+}
@@ -15,7 +15,6 @@
 #include <oogl/Program.hpp>
 #include <oogl/Texture.hpp>
 #include <oogl/FrameBuffer.hpp>
-#include <oogl/RenderBuffer.hpp>
 
 
 namespace mandelbrot
@@ -33,6 +32,7 @@ namespace mandelbrot
         static const GLint VALUE_TEXTURE_UNIT_INDEX;
         static const GLint LIFETIME_TEXTURE_UNIT_INDEX;
         static const GLint LIFETIME_COLOR_MAP_TEXTURE_UNIT_INDEX;
+        static const GLint COST_TEXTURE_UNIT_INDEX;
 
         /**
          * Creates a new stage.
@@ -52,7 +52,7 @@ namespace mandelbrot
         /**
          * Sets expected input/output texture size.
          */
-        void set_texture_size(GLint value);
+        void set_texture_size(const Vector2u& value);
         /**
          * Sets value texture source.
          */
@@ -61,6 +61,11 @@ namespace mandelbrot
          * Sets escape time texture source.
          */
         void set_lifetime_texture(oogl::Texture& value);
+        /**
+         * Sets the texture of iterations executed per pixel, to be shown 
+         * as a heatmap instead of the fractal. Null restores the fractal.
+         */
+        void set_cost_texture(oogl::Texture* value);
 
         /**
          * Gets color map.
@@ -75,12 +80,23 @@ namespace mandelbrot
          * Sets maximum escape time.
          */
         void set_max_lifetime(GLint value);
+        /**
+         * Sets magnitude beyond which orbits escape.
+         */
+        void set_escape_radius(double value);
 
         /**
          * Gets output colored texture.
          */
         const oogl::Texture& colored_texture() const;
 
+        protected:
+        /**
+         * Gets the definitions of the heatmap variant when a cost texture 
+         * is set, none otherwise.
+         */
+        oogl::Shader::Definitions GetDefinitions() const override;
+
         private:
         static const unsigned char DEFAULT_COLOR_MAP_DATA[];
 
@@ -90,27 +106,34 @@ namespace mandelbrot
 
         void UpdateTextureSize();
         void UpdateColorMap();
+        void UpdateProgram();
         void UpdateUniforms();
 
-        GLint texture_size_;
+        Vector2u texture_size_ = Vector2u(1, 1);
         ColorArray color_map_;
         GLint max_lifetime_;
+        double escape_radius_ = 2;
 
         oogl::Texture* in_value_texture_;
         oogl::Texture* in_lifetime_texture_;
+        oogl::Texture* in_cost_texture_ = nullptr;
         std::unique_ptr<oogl::Texture> in_lifetime_color_map_texture_;
         std::unique_ptr<oogl::Texture> out_colored_texture_;
+        std::unique_ptr<oogl::Texture> depth_texture_;
 
         std::unique_ptr<oogl::FrameBuffer> frame_buffer_;
-        std::unique_ptr<oogl::RenderBuffer> depth_render_buffer_;
 
         oogl::Uniform1i uniform_value_texture_;
         oogl::Uniform1i uniform_lifetime_texture_;
         oogl::Uniform1i uniform_lifetime_color_map_texture_;
         oogl::Uniform1i uniform_max_lifetime_;
+        oogl::Uniform1f uniform_escape_radius_;
+        oogl::Uniform1i uniform_cost_texture_;
 
         bool texture_size_needs_update_ = true;
         bool color_map_needs_update_ = true;
         bool max_lifetime_needs_update_ = true;
+        bool escape_radius_needs_update_ = true;
+        bool variant_needs_update_ = false;
     };
 }
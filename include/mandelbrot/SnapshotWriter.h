@@ -0,0 +1,157 @@
+/**
+ * Background snapshot encoding and file output.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class encodes images and writes files on a pool of worker 
+     * threads, so that saving never stalls the display thread.
+     *
+     * Image data is copied into one of a bounded set of recycled pixel
+     * buffers; when all of them are in use, further images are refused
+     * rather than queued without limit. Outcomes are reported back 
+     * through PollReport().
+     */
+    class SnapshotWriter
+    {
+        public:
+        enum class Format
+        {
+            Bmp,
+            Png
+        };
+
+        /**
+         * Outcome of a write.
+         */
+        struct Report
+        {
+            std::string path;
+            bool is_successful;
+        };
+
+        static const unsigned int DEFAULT_THREAD_COUNT;
+        static const unsigned int DEFAULT_BUFFER_COUNT;
+
+        /**
+         * Gets the format matching given path's extension (BMP unless the
+         * path ends with ".png").
+         */
+        static Format GetFormat(const std::string& path);
+        /**
+         * Gets the file extension of given format, including the dot.
+         */
+        static const char* GetExtension(Format format);
+
+        /**
+         * Creates a writer with default thread and buffer counts.
+         */
+        SnapshotWriter();
+        /**
+         * Creates a writer.
+         *
+         * @param thread_count Number of worker threads.
+         * @param buffer_count Maximum number of images queued at once.
+         */
+        SnapshotWriter(unsigned int thread_count, unsigned int buffer_count);
+        /**
+         * Completes all pending writes and stops the workers.
+         */
+        ~SnapshotWriter();
+
+        /**
+         * Queues an RGB image for encoding. Rows are expected bottom-up,
+         * as read back from OpenGL.
+         *
+         * @returns 
+         *      Value indicating whether the image was queued - i.e. whether
+         *      a pixel buffer was available.
+         */
+        bool WriteImage
+        (
+            const std::string& path,
+            const unsigned char* pixels,
+            unsigned int width, unsigned int height
+        );
+        /**
+         * Queues a text file.
+         */
+        void WriteText
+        (
+            const std::string& path,
+            const std::string& text
+        );
+        /**
+         * Queues a binary file.
+         */
+        void WriteData
+        (
+            const std::string& path,
+            std::vector<unsigned char> data
+        );
+
+        /**
+         * Retrieves the outcome of a completed write.
+         *
+         * @returns Value indicating whether a report was retrieved.
+         */
+        bool PollReport(Report& report);
+        /**
+         * Blocks until all queued writes are complete.
+         */
+        void Finish();
+
+        /**
+         * Sets a function called from a worker whenever a report becomes
+         * available.
+         */
+        void set_notifier(const std::function<void()>& value);
+
+        SnapshotWriter(const SnapshotWriter&) = delete;
+        SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+        private:
+        static const unsigned int CHANNEL_COUNT;
+
+        struct Job
+        {
+            std::string path;
+            bool is_image;
+            std::vector<unsigned char> data;
+            unsigned int width;
+            unsigned int height;
+        };
+
+        void Run();
+        bool Execute(const Job& job) const;
+
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable job_condition_;
+        std::condition_variable idle_condition_;
+
+        std::deque<Job> jobs_;
+        std::vector<std::vector<unsigned char>> free_buffers_;
+        unsigned int active_job_count_ = 0;
+        bool is_running_ = true;
+
+        std::deque<Report> reports_;
+        std::function<void()> notifier_;
+    };
+}
@@ -0,0 +1,96 @@
+/**
+ * Mirrors computation results across the real axis.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <memory>
+
+#include <mandelbrot/ProcessingStage.h>
+
+#include <oogl/Program.hpp>
+#include <oogl/Texture.hpp>
+#include <oogl/FrameBuffer.hpp>
+
+
+namespace mandelbrot
+{
+    /**
+     * Copies value and escape time textures, replacing a range of rows
+     * with the conjugated mirror image of their counterparts across the
+     * real axis.
+     */
+    class SymmetryStage : public ProcessingStage
+    {
+        public:
+        static const char* VERTEX_SHADER_SOURCE_PATH;
+        static const char* FRAGMENT_SHADER_SOURCE_PATH;
+
+        static const GLint VALUE_TEXTURE_UNIT_INDEX;
+        static const GLint LIFETIME_TEXTURE_UNIT_INDEX;
+
+        /**
+         * Creates a new stage.
+         */
+        SymmetryStage();
+
+        /**
+         * Initializes stage.
+         */
+        bool Initialize() override;
+
+        /**
+         * Executes stage.
+         */
+        void Execute() override;
+
+        /**
+         * Sets value and escape time texture sources.
+         */
+        void set_source_textures
+        (
+            oogl::Texture& value,
+            oogl::Texture& lifetime
+        );
+        /**
+         * Sets value and escape time texture targets. Must not be the
+         * sources.
+         */
+        void set_target_textures
+        (
+            oogl::Texture& value,
+            oogl::Texture& lifetime
+        );
+
+        /**
+         * Sets the mirrored rows.
+         *
+         * @param begin First mirrored row.
+         * @param end   Row past the last mirrored row.
+         * @param axis
+         *      Twice the real axis' position, in pixels from the bottom;
+         *      row i mirrors row (axis - 1 - i).
+         */
+        void set_mirrored_rows(GLint begin, GLint end, GLint axis);
+
+        private:
+        bool InitializeBuffers();
+        bool InitializeUniforms();
+
+        oogl::Texture* in_value_texture_ = nullptr;
+        oogl::Texture* in_lifetime_texture_ = nullptr;
+        oogl::Texture* out_value_texture_ = nullptr;
+        oogl::Texture* out_lifetime_texture_ = nullptr;
+
+        std::unique_ptr<oogl::FrameBuffer> frame_buffer_;
+
+        oogl::Uniform1i uniform_value_texture_;
+        oogl::Uniform1i uniform_lifetime_texture_;
+        oogl::Uniform2i uniform_mirrored_rows_;
+        oogl::Uniform1i uniform_mirror_axis_;
+    };
+}
@@ -0,0 +1,114 @@
+/**
+ * Pool of immutable textures.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+
+#include <glew/glew.h>
+
+#include <oogl/Texture.hpp>
+
+
+namespace mandelbrot
+{
+    /**
+     * Keeps released textures for reuse by later requests of the same 
+     * target, format and size, so toggling between sizes does not 
+     * allocate once each size has been seen.
+     *
+     * Textures are allocated with immutable storage, which needs a sized
+     * internal format. Idle textures beyond the pool's capacity are deleted,
+     * least recently released first.
+     *
+     * @note Not thread-safe. Textures are reused by the context that 
+     *       released them.
+     */
+    class TexturePool
+    {
+        public:
+        struct Statistics
+        {
+            // Bytes held by textures from the pool, in use or idle.
+            std::size_t allocated_bytes = 0;
+            // Bytes held by idle textures.
+            std::size_t idle_bytes = 0;
+            // Number of textures allocated so far.
+            unsigned int allocation_count = 0;
+
+            Statistics& operator+=(const Statistics& other);
+        };
+
+        static const std::size_t DEFAULT_CAPACITY;
+
+        /**
+         * Deletes idle textures.
+         */
+        ~TexturePool();
+
+        /**
+         * Gets a texture of given specifications, reusing an idle one if
+         * possible. Its contents are undefined.
+         */
+        std::unique_ptr<oogl::Texture> Acquire
+        (
+            oogl::Texture::Binding target,
+            GLint internal_format,
+            GLsizei width, GLsizei height
+        );
+        /**
+         * Replaces a texture acquired from the pool with one of the same
+         * target and format and of given size, unless it is of that size 
+         * already. The previous texture is released.
+         *
+         * @returns Value indicating whether the texture was replaced.
+         */
+        bool Resize
+        (
+            std::unique_ptr<oogl::Texture>& texture,
+            GLsizei width, GLsizei height
+        );
+        /**
+         * Returns a texture acquired from the pool. Null is ignored.
+         */
+        void Release(std::unique_ptr<oogl::Texture> texture);
+        /**
+         * Deletes idle textures.
+         */
+        void Clear();
+
+        /**
+         * Gets the maximum number of idle textures.
+         */
+        std::size_t capacity() const;
+        /**
+         * Sets the maximum number of idle textures.
+         */
+        void set_capacity(std::size_t value);
+
+        /**
+         * Gets memory usage.
+         */
+        const Statistics& statistics() const;
+
+        private:
+        static std::size_t GetSize(const oogl::Texture& texture);
+        static std::size_t GetPixelSize(GLenum target, GLint internal_format);
+
+        void Trim();
+
+        // Least recently released first.
+        std::list<std::unique_ptr<oogl::Texture>> idle_textures_;
+        std::size_t capacity_ = DEFAULT_CAPACITY;
+
+        Statistics statistics_;
+    };
+}
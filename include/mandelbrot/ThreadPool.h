@@ -0,0 +1,85 @@
+/**
+ * Fixed set of worker threads for data-parallel loops.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace mandelbrot
+{
+    /**
+     * This class spreads the indices of a loop over a set of worker 
+     * threads and the calling thread, which claim them one at a time until
+     * none are left. Tasks are meant to be coarse (rows, bands, tiles), so
+     * that claiming costs little next to running them.
+     *
+     * @note Run() is not reentrant: one loop runs at a time.
+     */
+    class ThreadPool
+    {
+        public:
+        typedef std::function<void(std::size_t)> Task;
+
+        /**
+         * Gets the number of worker threads to use alongside the calling
+         * thread to occupy every hardware thread.
+         */
+        static unsigned int GetDefaultThreadCount();
+
+        /**
+         * Creates a pool with the default number of threads.
+         */
+        ThreadPool();
+        /**
+         * Creates a pool. Without worker threads, loops run on the calling
+         * thread alone.
+         */
+        explicit ThreadPool(unsigned int thread_count);
+        /**
+         * Stops the workers.
+         */
+        ~ThreadPool();
+
+        /**
+         * Runs given task once for every index in [0, count), and blocks 
+         * until all are done.
+         */
+        void Run(std::size_t count, const Task& task);
+
+        /**
+         * Gets the number of worker threads.
+         */
+        unsigned int thread_count() const;
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        private:
+        typedef std::unique_lock<std::mutex> Lock;
+
+        void Work();
+        void RunTasks(Lock& lock);
+
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable task_condition_;
+        std::condition_variable done_condition_;
+
+        const Task* task_ = nullptr;
+        std::size_t task_count_ = 0;
+        std::size_t next_task_index_ = 0;
+        std::size_t done_task_count_ = 0;
+        bool is_running_ = true;
+    };
+}
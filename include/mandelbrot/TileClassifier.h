@@ -0,0 +1,77 @@
+/**
+ * Proves uniform regions of the mandelbrot fractal.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <mandelbrot/Interval.h>
+
+
+namespace mandelbrot
+{
+    /**
+     * Iterates a whole rectangle of the complex plane in interval
+     * arithmetic, to prove that every point in it escapes at the same
+     * iteration, or that it lies within the main cardioid or the period-2
+     * bulb.
+     *
+     * Unlike sampling, a proof cannot miss features thinner than a pixel.
+     */
+    class TileClassifier
+    {
+        public:
+        enum class Result
+        {
+            Unknown,    // Not proven yet
+            Escaped,    // Every point escapes at lifetime()
+            Interior,   // Every point is inside the set
+            Mixed       // Cannot be proven
+        };
+
+        /**
+         * Creates a classifier of given rectangle.
+         *
+         * @param real          Range of real parts.
+         * @param imaginary     Range of imaginary parts.
+         * @param escape_radius Magnitude beyond which orbits escape.
+         */
+        TileClassifier
+        (
+            const Interval& real, 
+            const Interval& imaginary,
+            double escape_radius
+        );
+
+        /**
+         * Evaluates further iterations, unless a result has been reached.
+         */
+        void Iterate(unsigned int count);
+
+        /**
+         * Gets classification result.
+         */
+        Result result() const;
+        /**
+         * Gets number of evaluated iterations. If escaped, this is the
+         * lifetime of every point.
+         */
+        int lifetime() const;
+
+        private:
+        static bool IsInsideKnownComponent
+        (
+            const Interval& real,
+            const Interval& imaginary
+        );
+
+        Interval c_real_, c_imaginary_;
+        Interval z_real_, z_imaginary_;
+        double escape_norm_;
+        int lifetime_ = 0;
+        Result result_ = Result::Unknown;
+    };
+}
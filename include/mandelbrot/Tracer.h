@@ -0,0 +1,149 @@
+/**
+ * Timeline tracing.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <oogl/Query.hpp>
+
+
+namespace mandelbrot
+{
+    /**
+     * Records timed zones of every thread into a ring buffer, and writes
+     * them as a Chrome trace event file, which opens in Perfetto or
+     * chrome://tracing.
+     *
+     * Zones may also be timed on the GPU with timestamp queries, whose
+     * results are read back in later zones once available, and shifted
+     * onto the CPU clock. GPU zones appear on a track of their own next to
+     * the thread that issued them.
+     *
+     * Recording is lock-free. When tracing is disabled, a zone costs a
+     * single atomic load.
+     */
+    class Tracer
+    {
+        public:
+        /**
+         * Records its lifetime, if tracing is enabled.
+         */
+        class Zone
+        {
+            public:
+            /**
+             * Starts the zone.
+             *
+             * @param name          Zone name. Must outlive the tracer.
+             * @param is_gpu_timed  Whether to also time the commands
+             *                      issued within the zone on the GPU.
+             *                      Needs a current context.
+             */
+            explicit Zone(const char* name, bool is_gpu_timed = false);
+            /**
+             * Ends the zone.
+             */
+            ~Zone();
+
+            Zone(const Zone&) = delete;
+            Zone& operator=(const Zone&) = delete;
+
+            private:
+            const char* name_;
+            std::int64_t begin_ = -1;
+            std::unique_ptr<oogl::Query> gpu_begin_;
+        };
+
+        static const std::size_t CAPACITY;
+        static const char* DEFAULT_PATH;
+
+        /**
+         * Checks whether zones are recorded.
+         */
+        static bool is_enabled();
+        /**
+         * Sets whether zones are recorded.
+         */
+        static void set_is_enabled(bool value);
+
+        /**
+         * Names the calling thread's track.
+         *
+         * @param name Thread name. Must outlive the tracer.
+         */
+        static void SetThreadName(const char* name);
+        /**
+         * Deletes the calling thread's GPU queries. Must be called while
+         * the thread's context is still current, if GPU zones were used.
+         */
+        static void ReleaseThread();
+
+        /**
+         * Writes recorded zones as a Chrome trace event file.
+         *
+         * @returns Value indicating success.
+         */
+        static bool Write(const std::string& path);
+
+        private:
+        struct Slot
+        {
+            // Index of the event plus one once written, zero while being
+            // written.
+            std::atomic<std::uint64_t> sequence { 0 };
+            std::atomic<const char*> name { nullptr };
+            std::atomic<std::int64_t> begin { 0 };
+            std::atomic<std::int64_t> duration { 0 };
+            std::atomic<std::uint32_t> track { 0 };
+        };
+        struct GpuThread;
+
+        static const std::size_t MAX_THREAD_COUNT;
+        static const std::uint32_t GPU_TRACK_OFFSET;
+        static const std::int64_t CALIBRATION_INTERVAL_NANOSECONDS;
+
+        /**
+         * Gets nanoseconds elapsed since the tracer's epoch.
+         */
+        static std::int64_t Now();
+        /**
+         * Gets the calling thread's track, numbered from one.
+         */
+        static std::uint32_t GetThreadTrack();
+        /**
+         * Gets the calling thread's GPU state, creating it if needed.
+         */
+        static GpuThread& GetGpuThread();
+        /**
+         * Gets the calling thread's GPU state, null if none.
+         */
+        static GpuThread*& current_gpu_thread();
+        /**
+         * Records GPU zones whose timestamps are available.
+         */
+        static void PollGpuThread(GpuThread& thread);
+
+        static void Record
+        (
+            const char* name,
+            std::uint32_t track,
+            std::int64_t begin, std::int64_t duration
+        );
+
+        static std::atomic<bool> is_enabled_;
+        static std::atomic<std::uint64_t> next_index_;
+        static std::unique_ptr<Slot[]> slots_;
+        static std::atomic<std::uint32_t> thread_count_;
+        static std::unique_ptr<std::atomic<const char*>[]> thread_names_;
+    };
+}
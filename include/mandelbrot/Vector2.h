@@ -231,6 +231,16 @@ namespace mandelbrot
         return vector / Length(vector);
     }
 
+    /**
+     * Scales given size so that its longer side measures one.
+     */
+    template <typename T>
+    Vector2<double> Proportions(const Vector2<T>& size)
+    {
+        const double longer_side = Max(size);
+        return Vector2<double>(size.x / longer_side, size.y / longer_side);
+    }
+
     template <typename T>
     Vector2<T> Inverse(const Vector2<T>& vector)
     {
@@ -0,0 +1,40 @@
+#include <oogl/Fence.hpp>
+
+
+namespace oogl
+{
+    inline Fence::Fence()
+        : handle_(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)) {}
+
+    inline Fence::~Fence()
+    {
+        glDeleteSync(handle_);
+    }
+
+    inline bool Fence::Wait(const GLuint64 timeout_nanoseconds)
+    {
+        const GLenum status = glClientWaitSync
+        (
+            handle_, 
+            GL_SYNC_FLUSH_COMMANDS_BIT, 
+            timeout_nanoseconds
+        );
+        return status == GL_ALREADY_SIGNALED ||
+               status == GL_CONDITION_SATISFIED;
+    }
+    inline void Fence::WaitOnServer()
+    {
+        glWaitSync(handle_, 0, GL_TIMEOUT_IGNORED);
+    }
+
+    inline bool Fence::is_signaled() const
+    {
+        GLint status;
+        glGetSynciv(handle_, GL_SYNC_STATUS, 1, nullptr, &status);
+        return status == GL_SIGNALED;
+    }
+    inline GLsync Fence::handle() const
+    {
+        return handle_;
+    }
+}
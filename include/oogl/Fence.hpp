@@ -0,0 +1,68 @@
+/**
+ * Fence Sync Object.
+ *
+ * @author Raoul Harel
+ * @url github/rharel/cpp-oogl
+ */
+
+
+#pragma once
+
+#include <glew/glew.h>
+
+
+namespace oogl
+{
+    /**
+     * This class wraps around OpenGL fence sync objects.
+     * A fence is signaled once all commands issued before its creation 
+     * have completed. Fences are shared between contexts.
+     *
+     * @note Sync objects are not named by a GLuint, hence this is not a 
+     *       GLObject.
+     */
+    class Fence
+    {
+        public:
+        /**
+         * Inserts a new fence into the command stream.
+         */
+        Fence();
+        /**
+         * Deletes fence.
+         */
+        ~Fence();
+
+        /**
+         * Blocks until the fence is signaled or given time has elapsed.
+         * Flushes the current context's command stream.
+         *
+         * @returns Value indicating whether the fence is signaled.
+         */
+        bool Wait(GLuint64 timeout_nanoseconds);
+        /**
+         * Makes the current context's later commands wait for the fence on
+         * the GPU, without blocking the calling thread.
+         *
+         * @note The context creating the fence must have flushed it.
+         */
+        void WaitOnServer();
+
+        /**
+         * Checks whether the fence is signaled, without blocking.
+         */
+        bool is_signaled() const;
+        /**
+         * Gets underlying sync object.
+         */
+        GLsync handle() const;
+
+        Fence(const Fence&) = delete;
+        Fence& operator=(const Fence&) = delete;
+
+        private:
+        GLsync handle_;
+    };
+}
+
+#include <oogl/Fence.cpp>
@@ -8,7 +8,17 @@ namespace oogl
     inline FrameBuffer::FrameBuffer(const Binding target)
     {
         GLuint handle;
-        glGenFramebuffers(1, &handle);
+        if (StateCache::is_dsa_enabled())
+        {
+            glCreateFramebuffers(1, &handle);
+            Instrumentation::RecordCall("glCreateFramebuffers");
+        }
+        else
+        {
+            glGenFramebuffers(1, &handle);
+            Instrumentation::RecordCall("glGenFramebuffers");
+        }
+
         Initialize(handle);
         set_binding_target(target);
     }
@@ -16,12 +26,23 @@ namespace oogl
     inline FrameBuffer::~FrameBuffer()
     {
         const GLuint object = handle();
+        StateCache::current().ForgetFrameBuffer(object);
         glDeleteFramebuffers(1, &object);
+        Instrumentation::RecordCall("glDeleteFramebuffers");
+    }
+
+    inline void FrameBuffer::BindDefault(const Binding target)
+    {
+        StateCache::current().BindFrameBuffer
+        (
+            static_cast<GLenum>(target), 
+            0
+        );
     }
 
     inline void FrameBuffer::Bind()
     {
-        glBindFramebuffer(binding_target(), handle());
+        StateCache::current().BindFrameBuffer(binding_target(), handle());
     }
     inline void FrameBuffer::BindToTarget(const Binding target)
     {
@@ -35,6 +56,22 @@ namespace oogl
         const GLenum attachment_point
     )
     {
+        const Instrumentation::Scope scope("FrameBuffer::AttachRenderBuffer");
+
+        if (StateCache::is_dsa_enabled())
+        {
+            glNamedFramebufferRenderbuffer
+            (
+                handle(),
+                attachment_point,
+                GL_RENDERBUFFER,
+                buffer.handle()
+            );
+            Instrumentation::RecordCall("glNamedFramebufferRenderbuffer");
+            return;
+        }
+
+        Bind();
         glFramebufferRenderbuffer
         (
             binding_target(),
@@ -42,6 +79,7 @@ namespace oogl
             GL_RENDERBUFFER,
             buffer.handle()
         );
+        Instrumentation::RecordCall("glFramebufferRenderbuffer");
     }
     inline void FrameBuffer::AttachTexture
     (
@@ -50,6 +88,22 @@ namespace oogl
         const GLint level
     )
     {
+        const Instrumentation::Scope scope("FrameBuffer::AttachTexture");
+
+        if (StateCache::is_dsa_enabled())
+        {
+            glNamedFramebufferTexture
+            (
+                handle(),
+                attachment_point,
+                texture.handle(),
+                level
+            );
+            Instrumentation::RecordCall("glNamedFramebufferTexture");
+            return;
+        }
+
+        Bind();
         glFramebufferTexture
         (
             binding_target(),
@@ -57,6 +111,23 @@ namespace oogl
             texture.handle(),
             level
         );
+        Instrumentation::RecordCall("glFramebufferTexture");
+    }
+
+    inline void FrameBuffer::Detach(const GLenum attachment_point)
+    {
+        const Instrumentation::Scope scope("FrameBuffer::Detach");
+
+        if (StateCache::is_dsa_enabled())
+        {
+            glNamedFramebufferTexture(handle(), attachment_point, 0, 0);
+            Instrumentation::RecordCall("glNamedFramebufferTexture");
+            return;
+        }
+
+        Bind();
+        glFramebufferTexture(binding_target(), attachment_point, 0, 0);
+        Instrumentation::RecordCall("glFramebufferTexture");
     }
 
     inline void FrameBuffer::set_binding_target(const Binding value)
@@ -66,7 +137,27 @@ namespace oogl
 
     inline bool FrameBuffer::is_complete(GLenum& status) const
     {
-        status = glCheckFramebufferStatus(binding_target());
+        const Instrumentation::Scope scope("FrameBuffer::is_complete");
+
+        if (StateCache::is_dsa_enabled())
+        {
+            status = glCheckNamedFramebufferStatus
+            (
+                handle(), 
+                binding_target()
+            );
+            Instrumentation::RecordCall("glCheckNamedFramebufferStatus");
+        }
+        else
+        {
+            StateCache::current().BindFrameBuffer
+            (
+                binding_target(), 
+                handle()
+            );
+            status = glCheckFramebufferStatus(binding_target());
+            Instrumentation::RecordCall("glCheckFramebufferStatus");
+        }
         return status == GL_FRAMEBUFFER_COMPLETE;
     }
     inline bool FrameBuffer::is_complete(std::string& status_message) const
@@ -14,6 +14,7 @@
 
 #include <oogl/GLObject.hpp>
 #include <oogl/RenderBuffer.hpp>
+#include <oogl/StateCache.hpp>
 #include <oogl/Texture.hpp>
 
 
@@ -22,6 +23,9 @@ namespace oogl
     /**
      * This class wraps around OpenGL frame buffer objects.
      * Frame buffers are used to render to off-screen locations.
+     *
+     * Operations bind the buffer as needed, unless direct state access is
+     * enabled.
      */
     class FrameBuffer : public GLObject
     {
@@ -33,6 +37,11 @@ namespace oogl
             Dual = GL_FRAMEBUFFER
         };
         
+        /**
+         * Binds the default frame buffer, i.e. the window, to the context.
+         */
+        static void BindDefault(Binding target = Binding::Dual);
+
         /**
          * Creates a new buffer with binding target set to 'dual' - 
          * i.e. both read and write access.
@@ -75,6 +84,10 @@ namespace oogl
             GLenum attachment_point,
             GLint level = 0
         );
+        /**
+         * Detaches whatever is attached to given point on this.
+         */
+        void Detach(GLenum attachment_point);
 
         /**
          * Sets binding target.
@@ -0,0 +1,245 @@
+#include <oogl/Instrumentation.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+
+namespace oogl
+{
+    inline Instrumentation::Frame& Instrumentation::Frame::operator+=
+    (
+        const Frame& other
+    )
+    {
+        for (const auto& entry_point : other.entry_points)
+        {
+            entry_points[entry_point.first] += entry_point.second;
+        }
+        for (const auto& wrapper : other.wrappers)
+        {
+            WrapperTime& time = wrappers[wrapper.first];
+            time.call_count += wrapper.second.call_count;
+            time.milliseconds += wrapper.second.milliseconds;
+        }
+        uploaded_bytes += other.uploaded_bytes;
+        downloaded_bytes += other.downloaded_bytes;
+        draw_count += other.draw_count;
+
+        return *this;
+    }
+
+    inline Instrumentation::Scope::Scope(const char* wrapper)
+        : wrapper_(wrapper),
+          is_timed_(is_enabled())
+    {
+        if (is_timed_) { start_ = Clock::now(); }
+    }
+    inline Instrumentation::Scope::~Scope()
+    {
+        if (!is_timed_) { return; }
+
+        const std::chrono::duration<double, std::milli> elapsed = 
+            Clock::now() - start_;
+
+        State& state = Instrumentation::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        WrapperTime& time = state.current_frame.wrappers[wrapper_];
+        ++ time.call_count;
+        time.milliseconds += elapsed.count();
+    }
+
+    inline bool Instrumentation::is_enabled()
+    {
+        return state().is_enabled.load(std::memory_order_relaxed);
+    }
+    inline void Instrumentation::set_is_enabled(const bool value)
+    {
+        state().is_enabled = value;
+    }
+
+    inline void Instrumentation::RecordCall
+    (
+        const char* entry_point, 
+        const unsigned int count
+    )
+    {
+        State& state = Instrumentation::state();
+        state.issued_count += count;
+
+        if (!is_enabled()) { return; }
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.current_frame.entry_points[entry_point] += count;
+    }
+    inline void Instrumentation::RecordElidedBind()
+    {
+        ++ state().elided_count;
+    }
+    inline void Instrumentation::RecordUpload(const std::size_t byte_count)
+    {
+        if (!is_enabled()) { return; }
+
+        State& state = Instrumentation::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.current_frame.uploaded_bytes += byte_count;
+    }
+    inline void Instrumentation::RecordDownload(const std::size_t byte_count)
+    {
+        if (!is_enabled()) { return; }
+
+        State& state = Instrumentation::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.current_frame.downloaded_bytes += byte_count;
+    }
+    inline void Instrumentation::RecordDraw()
+    {
+        if (!is_enabled()) { return; }
+
+        State& state = Instrumentation::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        ++ state.current_frame.draw_count;
+    }
+
+    inline void Instrumentation::EndFrame()
+    {
+        State& state = Instrumentation::state();
+
+        CallCounts counts;
+        counts.issued = state.issued_count.exchange(0);
+        counts.elided = state.elided_count.exchange(0);
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.last_frame_call_counts = counts;
+
+        if (!is_enabled()) { return; }
+
+        state.history.push_back(std::move(state.current_frame));
+        state.current_frame = Frame();
+        while (state.history.size() > state.history_length)
+        {
+            state.history.pop_front();
+        }
+    }
+
+    inline Instrumentation::CallCounts 
+           Instrumentation::last_frame_call_counts()
+    {
+        State& state = Instrumentation::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        return state.last_frame_call_counts;
+    }
+
+    inline Instrumentation::Frame Instrumentation::GetSummary
+    (
+        unsigned int& frame_count
+    )
+    {
+        State& state = Instrumentation::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        Frame summary;
+        for (const Frame& frame : state.history) { summary += frame; }
+        frame_count = static_cast<unsigned int>(state.history.size());
+
+        return summary;
+    }
+    inline void Instrumentation::PrintSummary(std::ostream& stream)
+    {
+        unsigned int frame_count;
+        const Frame summary = GetSummary(frame_count);
+
+        if (frame_count == 0)
+        {
+            stream << "GL statistics: no frames recorded" << std::endl;
+            return;
+        }
+
+        const double KIBIBYTE = 1024.0;
+        const double n = frame_count;
+
+        stream << std::fixed << std::setprecision(1)
+               << "GL statistics, per frame over the last " 
+               << frame_count << " frames:" << std::endl
+               << "  Draw calls: " << summary.draw_count / n << std::endl
+               << "  Uploaded: " 
+               << summary.uploaded_bytes / KIBIBYTE / n << " KiB" 
+               << std::endl
+               << "  Downloaded: " 
+               << summary.downloaded_bytes / KIBIBYTE / n << " KiB" 
+               << std::endl;
+
+        std::vector<std::pair<std::string, WrapperTime>> wrappers
+        (
+            summary.wrappers.begin(), 
+            summary.wrappers.end()
+        );
+        std::sort
+        (
+            wrappers.begin(), wrappers.end(),
+            [](const std::pair<std::string, WrapperTime>& a,
+               const std::pair<std::string, WrapperTime>& b)
+            {
+                return a.second.milliseconds > b.second.milliseconds;
+            }
+        );
+        stream << "  Wrapper time (calls, ms):" << std::endl;
+        for (const auto& wrapper : wrappers)
+        {
+            stream << std::setprecision(1)
+                   << "    " << std::left << std::setw(36) << wrapper.first
+                   << std::right << std::setw(8) 
+                   << wrapper.second.call_count / n
+                   << std::setprecision(3) << std::setw(10) 
+                   << wrapper.second.milliseconds / n
+                   << std::endl;
+        }
+
+        std::vector<std::pair<std::string, unsigned long long>> entry_points
+        (
+            summary.entry_points.begin(), 
+            summary.entry_points.end()
+        );
+        std::sort
+        (
+            entry_points.begin(), entry_points.end(),
+            [](const std::pair<std::string, unsigned long long>& a,
+               const std::pair<std::string, unsigned long long>& b)
+            {
+                return a.second > b.second;
+            }
+        );
+        stream << "  Entry points (calls):" << std::endl;
+        for (const auto& entry_point : entry_points)
+        {
+            stream << std::setprecision(1)
+                   << "    " << std::left << std::setw(36) << entry_point.first
+                   << std::right << std::setw(8) << entry_point.second / n
+                   << std::endl;
+        }
+    }
+
+    inline unsigned int Instrumentation::history_length()
+    {
+        State& state = Instrumentation::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        return state.history_length;
+    }
+    inline void Instrumentation::set_history_length(const unsigned int value)
+    {
+        State& state = Instrumentation::state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.history_length = std::max(value, 1U);
+        while (state.history.size() > state.history_length)
+        {
+            state.history.pop_front();
+        }
+    }
+
+    inline Instrumentation::State& Instrumentation::state()
+    {
+        static State state;
+        return state;
+    }
+}
@@ -0,0 +1,185 @@
+/**
+ * GL call statistics.
+ *
+ * @author Raoul Harel
+ * @url github/rharel/cpp-oogl
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+
+namespace oogl
+{
+    /**
+     * This class records the GL calls issued by the wrappers, frame by 
+     * frame. 
+     *
+     * Totals of issued calls and elided binds are always kept. When 
+     * enabled, calls are also broken down by entry point, along with bytes
+     * transferred, draw calls and time spent in each wrapper, and the last
+     * frames are kept for a rolling summary.
+     *
+     * Calls from every thread are recorded into the same frame.
+     */
+    class Instrumentation
+    {
+        public:
+        /**
+         * Number of calls made through the wrappers.
+         */
+        struct CallCounts
+        {
+            // Calls issued to the driver.
+            unsigned int issued = 0;
+            // Binds skipped as redundant.
+            unsigned int elided = 0;
+        };
+        /**
+         * Time spent in a wrapper method.
+         */
+        struct WrapperTime
+        {
+            unsigned long long call_count = 0;
+            // Includes time spent in nested wrapper methods.
+            double milliseconds = 0;
+        };
+        /**
+         * Statistics of one or more frames.
+         */
+        struct Frame
+        {
+            std::map<std::string, unsigned long long> entry_points;
+            std::map<std::string, WrapperTime> wrappers;
+            unsigned long long uploaded_bytes = 0;
+            unsigned long long downloaded_bytes = 0;
+            unsigned long long draw_count = 0;
+
+            Frame& operator+=(const Frame& other);
+        };
+
+        /**
+         * Times the enclosing wrapper method, if instrumentation is 
+         * enabled.
+         */
+        class Scope
+        {
+            public:
+            /**
+             * Starts timing.
+             *
+             * @param wrapper Name of the wrapper method. Must outlive the
+             *                scope.
+             */
+            explicit Scope(const char* wrapper);
+            /**
+             * Records time elapsed since construction.
+             */
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            private:
+            typedef std::chrono::steady_clock Clock;
+
+            const char* wrapper_;
+            Clock::time_point start_;
+            bool is_timed_;
+        };
+
+        static const unsigned int DEFAULT_HISTORY_LENGTH = 120;
+
+        /**
+         * Checks whether detailed statistics are recorded.
+         */
+        static bool is_enabled();
+        /**
+         * Sets whether detailed statistics are recorded.
+         */
+        static void set_is_enabled(bool value);
+
+        /**
+         * Records calls to given entry point.
+         */
+        static void RecordCall
+        (
+            const char* entry_point, 
+            unsigned int count = 1
+        );
+        /**
+         * Records a bind skipped as redundant.
+         */
+        static void RecordElidedBind();
+        /**
+         * Records bytes uploaded to the GPU.
+         */
+        static void RecordUpload(std::size_t byte_count);
+        /**
+         * Records bytes downloaded from the GPU.
+         */
+        static void RecordDownload(std::size_t byte_count);
+        /**
+         * Records a draw call.
+         */
+        static void RecordDraw();
+
+        /**
+         * Closes the current frame and starts the next one.
+         */
+        static void EndFrame();
+
+        /**
+         * Gets call counts of the last closed frame.
+         */
+        static CallCounts last_frame_call_counts();
+
+        /**
+         * Gets statistics summed over the kept frames.
+         *
+         * @param[out] frame_count Number of frames summed.
+         */
+        static Frame GetSummary(unsigned int& frame_count);
+        /**
+         * Writes per-frame averages over the kept frames.
+         */
+        static void PrintSummary(std::ostream& stream);
+
+        /**
+         * Gets number of frames kept for the summary.
+         */
+        static unsigned int history_length();
+        /**
+         * Sets number of frames kept for the summary.
+         */
+        static void set_history_length(unsigned int value);
+
+        private:
+        struct State
+        {
+            std::atomic<bool> is_enabled { false };
+            std::atomic<unsigned int> issued_count { 0 };
+            std::atomic<unsigned int> elided_count { 0 };
+
+            // Guards the members below.
+            std::mutex mutex;
+            CallCounts last_frame_call_counts;
+            Frame current_frame;
+            std::deque<Frame> history;
+            unsigned int history_length = DEFAULT_HISTORY_LENGTH;
+        };
+
+        static State& state();
+    };
+}
+
+#include <oogl/Instrumentation.cpp>
@@ -5,11 +5,25 @@ namespace oogl
 {
     inline Program* Program::Build
     (
-        std::initializer_list<const Shader*> shaders
+        std::initializer_list<const Shader*> shaders,
+        const bool is_binary_retrievable
     )
     {
+        const Instrumentation::Scope scope("Program::Build");
+
         Program* program = new Program();
 
+        if (is_binary_retrievable)
+        {
+            glProgramParameteri
+            (
+                program->handle(), 
+                GL_PROGRAM_BINARY_RETRIEVABLE_HINT, 
+                GL_TRUE
+            );
+            Instrumentation::RecordCall("glProgramParameteri");
+        }
+
         for (const Shader* shader : shaders)
         {
             program->AttachShader(*shader);
@@ -27,15 +41,39 @@ namespace oogl
 
         return program;
     }
+    inline Program* Program::BuildFromBinary
+    (
+        const GLenum format,
+        const void* binary,
+        const GLsizei length
+    )
+    {
+        const Instrumentation::Scope scope("Program::BuildFromBinary");
+
+        Program* program = new Program();
+
+        glProgramBinary(program->handle(), format, binary, length);
+        Instrumentation::RecordCall("glProgramBinary");
+        if (!program->ReadLinkStatus())
+        {
+            program->info_log_ = 
+                "Binary loading failure:\n" + program->info_log_;
+        }
+
+        return program;
+    }
 
     inline Program::Program()
     {
         Initialize(glCreateProgram());
+        Instrumentation::RecordCall("glCreateProgram");
     }
 
     inline Program::~Program()
     {
+        StateCache::current().ForgetProgram(handle());
         glDeleteProgram(handle());
+        Instrumentation::RecordCall("glDeleteProgram");
     }
     inline void Program::Bind()
     {
@@ -45,22 +83,32 @@ namespace oogl
     inline void Program::AttachShader(const Shader& shader)
     {
         glAttachShader(handle(), shader.handle());
+        Instrumentation::RecordCall("glAttachShader");
     }
     inline void Program::DetachShader(const Shader& shader)
     {
         glDetachShader(handle(), shader.handle());
+        Instrumentation::RecordCall("glDetachShader");
     }
 
     inline bool Program::Link()
     {
-        glLinkProgram(handle());
+        const Instrumentation::Scope scope("Program::Link");
 
+        glLinkProgram(handle());
+        Instrumentation::RecordCall("glLinkProgram");
+        return ReadLinkStatus();
+    }
+    inline bool Program::ReadLinkStatus()
+    {
         GLint link_status;
         glGetProgramiv(handle(), GL_LINK_STATUS, &link_status);
+        Instrumentation::RecordCall("glGetProgramiv");
         is_linked_ = link_status == GL_TRUE;
 
         GLint info_log_length;
         glGetProgramiv(handle(), GL_INFO_LOG_LENGTH, &info_log_length);
+        Instrumentation::RecordCall("glGetProgramiv");
 
         GLsizei max_log_length = info_log_length;
         GLsizei actual_log_length;
@@ -71,19 +119,52 @@ namespace oogl
             max_log_length, &actual_log_length,
             info_log
         );
+        Instrumentation::RecordCall("glGetProgramInfoLog");
         info_log_ = std::string(info_log);
         delete[] info_log;
 
         return is_linked_;
     }
 
+    inline bool Program::GetBinary
+    (
+        GLenum& format, 
+        std::vector<unsigned char>& binary
+    ) const
+    {
+        const Instrumentation::Scope scope("Program::GetBinary");
+
+        if (!is_linked_) { return false; }
+
+        GLint length;
+        glGetProgramiv(handle(), GL_PROGRAM_BINARY_LENGTH, &length);
+        Instrumentation::RecordCall("glGetProgramiv");
+        if (length <= 0) { return false; }
+
+        binary.resize(length);
+
+        GLsizei actual_length;
+        glGetProgramBinary
+        (
+            handle(), 
+            length, &actual_length, 
+            &format, 
+            binary.data()
+        );
+        Instrumentation::RecordCall("glGetProgramBinary");
+        binary.resize(actual_length);
+
+        return actual_length > 0;
+    }
+
     inline void Program::Use()
     {
-        glUseProgram(handle());
+        StateCache::current().UseProgram(handle());
     }
 
     inline GLint Program::GetUniformLocation(const char* name) const
     {
+        Instrumentation::RecordCall("glGetUniformLocation");
         return glGetUniformLocation(handle(), name);
     }
     template <typename T, unsigned int D, GLsizei N>
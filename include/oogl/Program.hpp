@@ -9,11 +9,13 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <glew/glew.h>
 
 #include <oogl/GLObject.hpp>
 #include <oogl/Shader.hpp>
+#include <oogl/StateCache.hpp>
 #include <oogl/VectorUniform.hpp>
 
 
@@ -28,10 +30,26 @@ namespace oogl
         public:
         /**
          * Creates, compiles, and links a program from shader list.
+         *
+         * @param is_binary_retrievable 
+         *      Hints that the linked binary will be retrieved with 
+         *      GetBinary().
          */
         static Program* Build
         (
-            std::initializer_list<const Shader*> shaders
+            std::initializer_list<const Shader*> shaders,
+            bool is_binary_retrievable = false
+        );
+        /**
+         * Creates a program from a binary previously retrieved with 
+         * GetBinary(). Loading fails if the binary is not accepted by the
+         * current driver, in which case the program is not linked.
+         */
+        static Program* BuildFromBinary
+        (
+            GLenum format,
+            const void* binary,
+            GLsizei length
         );
 
         /**
@@ -63,6 +81,16 @@ namespace oogl
          * @returns Value indicating whether operation was succesful.
          */
         bool Link();
+        /**
+         * Gets the linked program's binary in a driver-specific format.
+         *
+         * @returns Value indicating whether operation was succesful.
+         */
+        bool GetBinary
+        (
+            GLenum& format, 
+            std::vector<unsigned char>& binary
+        ) const;
         /**
          * Binds to context.
          */
@@ -88,6 +116,8 @@ namespace oogl
         const char* info_log() const;
 
         private:
+        bool ReadLinkStatus();
+
         bool is_linked_ = false;
         std::string info_log_ = "";
     };
@@ -0,0 +1,66 @@
+#include <oogl/Query.hpp>
+
+
+namespace oogl
+{
+    inline GLint64 Query::GetTimestamp()
+    {
+        GLint64 value;
+        glGetInteger64v(GL_TIMESTAMP, &value);
+        Instrumentation::RecordCall("glGetInteger64v");
+        return value;
+    }
+
+    inline Query::Query(const Target target)
+    {
+        GLuint handle;
+        glGenQueries(1, &handle);
+        Instrumentation::RecordCall("glGenQueries");
+        Initialize(handle);
+        set_binding_target(static_cast<GLenum>(target));
+    }
+    inline Query::~Query()
+    {
+        const GLuint object = handle();
+        glDeleteQueries(1, &object);
+        Instrumentation::RecordCall("glDeleteQueries");
+    }
+
+    inline void Query::Bind() {}
+
+    inline void Query::Begin()
+    {
+        glBeginQuery(binding_target(), handle());
+        Instrumentation::RecordCall("glBeginQuery");
+    }
+    inline void Query::End()
+    {
+        glEndQuery(binding_target());
+        Instrumentation::RecordCall("glEndQuery");
+    }
+    inline void Query::RecordTimestamp()
+    {
+        glQueryCounter(handle(), GL_TIMESTAMP);
+        Instrumentation::RecordCall("glQueryCounter");
+    }
+
+    inline bool Query::is_result_available() const
+    {
+        GLuint is_available;
+        glGetQueryObjectuiv
+        (
+            handle(), 
+            GL_QUERY_RESULT_AVAILABLE, 
+            &is_available
+        );
+        Instrumentation::RecordCall("glGetQueryObjectuiv");
+        return is_available == GL_TRUE;
+    }
+    inline GLuint64 Query::result() const
+    {
+        GLuint64 value;
+        glGetQueryObjectui64v(handle(), GL_QUERY_RESULT, &value);
+        Instrumentation::RecordCall("glGetQueryObjectui64v");
+        return value;
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * Query Object.
+ *
+ * @author Raoul Harel
+ * @url github/rharel/cpp-oogl
+ */
+
+
+#pragma once
+
+#include <glew/glew.h>
+
+#include <oogl/GLObject.hpp>
+#include <oogl/Instrumentation.hpp>
+
+
+namespace oogl
+{
+    /**
+     * This class wraps around OpenGL query objects.
+     * Queries measure the commands issued between their beginning and end, 
+     * and their result becomes available once those commands complete.
+     *
+     * @note Queries are not shared between contexts. Only one query per 
+     *       target may be active at a time.
+     */
+    class Query : public GLObject
+    {
+        public:
+        enum class Target : GLenum
+        {
+            TimeElapsed = GL_TIME_ELAPSED,
+            SamplesPassed = GL_SAMPLES_PASSED,
+            AnySamplesPassed = GL_ANY_SAMPLES_PASSED,
+            PrimitivesGenerated = GL_PRIMITIVES_GENERATED,
+            Timestamp = GL_TIMESTAMP
+        };
+
+        /**
+         * Gets the GPU time in nanoseconds once all previously issued 
+         * commands have reached the GPU, without waiting for them to 
+         * complete.
+         */
+        static GLint64 GetTimestamp();
+
+        /**
+         * Creates a new query of given target.
+         */
+        Query(Target target);
+        /**
+         * Deletes query.
+         */
+        ~Query() override;
+
+        /**
+         * No-op.
+         */
+        void Bind() override;
+
+        /**
+         * Starts measuring.
+         */
+        void Begin();
+        /**
+         * Stops measuring.
+         */
+        void End();
+        /**
+         * Records the GPU time in nanoseconds once all previously issued
+         * commands have completed. Only for timestamp queries.
+         */
+        void RecordTimestamp();
+
+        /**
+         * Checks whether the result is available, without blocking.
+         */
+        bool is_result_available() const;
+        /**
+         * Gets the result, blocking until it is available. Elapsed time
+         * is in nanoseconds.
+         */
+        GLuint64 result() const;
+    };
+}
+
+#include <oogl/Query.cpp>
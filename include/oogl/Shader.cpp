@@ -8,12 +8,20 @@ namespace oogl
     inline Shader* Shader::BuildFromString
     (
         const Type type, 
-        const char* source
+        const char* source,
+        const Definitions& definitions
     )
     {
         auto shader = new Shader(type);
         
-        shader->SourceFromString(source);
+        if (definitions.empty()) { shader->SourceFromString(source); }
+        else
+        {
+            shader->SourceFromString
+            (
+                InjectDefinitions(source, definitions).c_str()
+            );
+        }
         if (!shader->Compile())
         {
             shader->info_log_ = 
@@ -26,7 +34,8 @@ namespace oogl
     inline Shader* Shader::BuildFromPath
     (
         const Type type,
-        const char* path
+        const char* path,
+        const Definitions& definitions
     )
     {
         Shader* shader;
@@ -39,11 +48,51 @@ namespace oogl
         }
         else 
         { 
-            shader = BuildFromString(type, source.c_str()); 
+            shader = BuildFromString(type, source.c_str(), definitions); 
         }
 
         return shader;
     }
+    inline std::string Shader::InjectDefinitions
+    (
+        const std::string& source,
+        const Definitions& definitions
+    )
+    {
+        std::size_t offset = 0;
+        unsigned int line_number = 1;
+
+        const std::size_t version = source.find("#version");
+        if (version != std::string::npos)
+        {
+            const std::size_t line_end = source.find('\n', version);
+            offset = line_end == std::string::npos ? 
+                     source.size() : line_end + 1;
+
+            for (std::size_t i = 0; i < offset; ++i)
+            {
+                if (source[i] == '\n') { ++ line_number; }
+            }
+        }
+
+        std::string directives;
+        if (offset == source.size() && offset > 0 && 
+            source[offset - 1] != '\n')
+        {
+            directives += "\n";
+        }
+        for (const auto& definition : definitions)
+        {
+            directives += 
+                "#define " + definition.first + " " + 
+                definition.second + "\n";
+        }
+        directives += "#line " + std::to_string(line_number) + "\n";
+
+        std::string result = source;
+        result.insert(offset, directives);
+        return result;
+    }
 
     inline Shader::Shader(const Type type)
         : type_(type)
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <map>
 #include <string>
 
 #include <glew/glew.h>
@@ -35,14 +36,42 @@ namespace oogl
             Compute = GL_COMPUTE_SHADER
         };
 
+        /**
+         * Preprocessor macro values by name.
+         */
+        typedef std::map<std::string, std::string> Definitions;
+
         /**
          * Creates and compiles shader from string.
+         *
+         * @param definitions Macros defined ahead of the source.
          */
-        static Shader* BuildFromString(Type type, const char* source);
+        static Shader* BuildFromString
+        (
+            Type type, 
+            const char* source,
+            const Definitions& definitions = Definitions()
+        );
         /**
          * Creates and compiles shader from path.
+         *
+         * @param definitions Macros defined ahead of the source.
+         */
+        static Shader* BuildFromPath
+        (
+            Type type, 
+            const char* path,
+            const Definitions& definitions = Definitions()
+        );
+        /**
+         * Inserts #define directives after the source's #version directive,
+         * which must come first. Line numbers in the info log are kept.
          */
-        static Shader* BuildFromPath(Type type, const char* path);
+        static std::string InjectDefinitions
+        (
+            const std::string& source,
+            const Definitions& definitions
+        );
 
         /**
          * Creates a new shader with given type.
@@ -0,0 +1,215 @@
+#include <oogl/StateCache.hpp>
+
+
+namespace oogl
+{
+    inline StateCache& StateCache::current()
+    {
+        thread_local StateCache cache;
+        return cache;
+    }
+
+    inline bool StateCache::is_dsa_supported()
+    {
+        return GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+    }
+    inline bool StateCache::is_dsa_enabled()
+    {
+        return !is_dsa_disabled() && is_dsa_supported();
+    }
+    inline void StateCache::set_is_dsa_enabled(const bool value)
+    {
+        is_dsa_disabled() = !value;
+    }
+    inline bool& StateCache::is_dsa_disabled()
+    {
+        static bool value = false;
+        return value;
+    }
+
+    inline StateCache::StateCache()
+    {
+        Invalidate();
+    }
+
+    inline void StateCache::Invalidate()
+    {
+        program_ = UNKNOWN;
+        draw_frame_buffer_ = UNKNOWN;
+        read_frame_buffer_ = UNKNOWN;
+        vertex_array_ = UNKNOWN;
+        active_texture_unit_ = UNKNOWN;
+
+        buffers_.clear();
+        textures_.clear();
+    }
+
+    inline bool StateCache::Update
+    (
+        GLuint& binding, 
+        const GLuint value,
+        const char* entry_point
+    )
+    {
+        if (binding == value)
+        {
+            Instrumentation::RecordElidedBind();
+            return false;
+        }
+        binding = value;
+        Instrumentation::RecordCall(entry_point);
+        return true;
+    }
+
+    inline void StateCache::UseProgram(const GLuint program)
+    {
+        if (Update(program_, program, "glUseProgram")) 
+        { 
+            glUseProgram(program); 
+        }
+    }
+    inline void StateCache::BindFrameBuffer
+    (
+        const GLenum target, 
+        const GLuint frame_buffer
+    )
+    {
+        if (target == GL_DRAW_FRAMEBUFFER)
+        {
+            if (Update
+                (
+                    draw_frame_buffer_, 
+                    frame_buffer, 
+                    "glBindFramebuffer"
+                ))
+            {
+                glBindFramebuffer(target, frame_buffer);
+            }
+        }
+        else if (target == GL_READ_FRAMEBUFFER)
+        {
+            if (Update
+                (
+                    read_frame_buffer_, 
+                    frame_buffer, 
+                    "glBindFramebuffer"
+                ))
+            {
+                glBindFramebuffer(target, frame_buffer);
+            }
+        }
+        else if (draw_frame_buffer_ != frame_buffer || 
+                 read_frame_buffer_ != frame_buffer)
+        {
+            draw_frame_buffer_ = read_frame_buffer_ = frame_buffer;
+            glBindFramebuffer(target, frame_buffer);
+            Instrumentation::RecordCall("glBindFramebuffer");
+        }
+        else { Instrumentation::RecordElidedBind(); }
+    }
+    inline void StateCache::BindVertexArray(const GLuint vertex_array)
+    {
+        if (Update(vertex_array_, vertex_array, "glBindVertexArray")) 
+        { 
+            glBindVertexArray(vertex_array); 
+        }
+    }
+    inline void StateCache::BindBuffer
+    (
+        const GLenum target, 
+        const GLuint buffer
+    )
+    {
+        auto binding = buffers_.emplace(target, UNKNOWN).first;
+        if (Update(binding->second, buffer, "glBindBuffer")) 
+        { 
+            glBindBuffer(target, buffer); 
+        }
+    }
+    inline void StateCache::BindTexture
+    (
+        const GLenum target, 
+        const GLuint texture
+    )
+    {
+        if (active_texture_unit_ == UNKNOWN)
+        {
+            // The texture is bound to whichever unit is active.
+            glActiveTexture(GL_TEXTURE0);
+            active_texture_unit_ = 0;
+            Instrumentation::RecordCall("glActiveTexture");
+        }
+        auto binding = textures_.emplace
+        (
+            std::make_pair(active_texture_unit_, target), 
+            UNKNOWN
+        ).first;
+        if (Update(binding->second, texture, "glBindTexture")) 
+        { 
+            glBindTexture(target, texture); 
+        }
+    }
+    inline void StateCache::BindTextureUnit
+    (
+        const GLuint unit,
+        const GLenum target, 
+        const GLuint texture
+    )
+    {
+        auto binding = textures_.emplace
+        (
+            std::make_pair(unit, target), 
+            UNKNOWN
+        ).first;
+        const char* entry_point = 
+            is_dsa_enabled() ? "glBindTextureUnit" : "glBindTexture";
+        if (!Update(binding->second, texture, entry_point)) { return; }
+
+        if (is_dsa_enabled())
+        {
+            glBindTextureUnit(unit, texture);
+            return;
+        }
+        if (active_texture_unit_ != unit)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            active_texture_unit_ = unit;
+            Instrumentation::RecordCall("glActiveTexture");
+        }
+        glBindTexture(target, texture);
+    }
+
+    inline void StateCache::ForgetProgram(const GLuint program)
+    {
+        if (program_ == program) { program_ = UNKNOWN; }
+    }
+    inline void StateCache::ForgetFrameBuffer(const GLuint frame_buffer)
+    {
+        if (draw_frame_buffer_ == frame_buffer) 
+        { 
+            draw_frame_buffer_ = UNKNOWN; 
+        }
+        if (read_frame_buffer_ == frame_buffer) 
+        { 
+            read_frame_buffer_ = UNKNOWN; 
+        }
+    }
+    inline void StateCache::ForgetVertexArray(const GLuint vertex_array)
+    {
+        if (vertex_array_ == vertex_array) { vertex_array_ = UNKNOWN; }
+    }
+    inline void StateCache::ForgetBuffer(const GLuint buffer)
+    {
+        for (auto& binding : buffers_)
+        {
+            if (binding.second == buffer) { binding.second = UNKNOWN; }
+        }
+    }
+    inline void StateCache::ForgetTexture(const GLuint texture)
+    {
+        for (auto& binding : textures_)
+        {
+            if (binding.second == texture) { binding.second = UNKNOWN; }
+        }
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * Shadow copy of context binding state.
+ *
+ * @author Raoul Harel
+ * @url github/rharel/cpp-oogl
+ */
+
+
+#pragma once
+
+#include <map>
+#include <utility>
+
+#include <glew/glew.h>
+
+#include <oogl/Instrumentation.hpp>
+
+
+namespace oogl
+{
+    /**
+     * This class mirrors the bindings of the current context, so the 
+     * wrappers skip binds that would not change anything. 
+     *
+     * Each thread has its own cache, as each thread has its own context
+     * current. Binds must go through the cache, or it must be invalidated
+     * afterwards.
+     *
+     * Where direct state access (GL 4.5) is available, the wrappers use it
+     * to operate on objects without binding them at all.
+     */
+    class StateCache
+    {
+        public:
+        /**
+         * Gets the calling thread's cache.
+         */
+        static StateCache& current();
+
+        /**
+         * Checks whether the driver supports direct state access.
+         * Requires an initialized context.
+         */
+        static bool is_dsa_supported();
+        /**
+         * Checks whether the wrappers use direct state access.
+         */
+        static bool is_dsa_enabled();
+        /**
+         * Sets whether the wrappers use direct state access, if supported.
+         * Must be set before objects are created.
+         */
+        static void set_is_dsa_enabled(bool value);
+
+        /**
+         * Creates a cache with every binding unknown.
+         */
+        StateCache();
+
+        /**
+         * Marks every binding unknown, after binds made around the cache.
+         */
+        void Invalidate();
+
+        void UseProgram(GLuint program);
+        void BindFrameBuffer(GLenum target, GLuint frame_buffer);
+        void BindVertexArray(GLuint vertex_array);
+        void BindBuffer(GLenum target, GLuint buffer);
+        /**
+         * Binds texture to the active unit.
+         */
+        void BindTexture(GLenum target, GLuint texture);
+        /**
+         * Binds texture to given unit.
+         */
+        void BindTextureUnit(GLuint unit, GLenum target, GLuint texture);
+
+        // Deleting an object unbinds it from the current context only, so
+        // its bindings become unknown rather than zero.
+
+        /**
+         * Forgets a program about to be deleted.
+         */
+        void ForgetProgram(GLuint program);
+        /**
+         * Forgets a frame buffer about to be deleted.
+         */
+        void ForgetFrameBuffer(GLuint frame_buffer);
+        /**
+         * Forgets a vertex array about to be deleted.
+         */
+        void ForgetVertexArray(GLuint vertex_array);
+        /**
+         * Forgets a buffer about to be deleted.
+         */
+        void ForgetBuffer(GLuint buffer);
+        /**
+         * Forgets a texture about to be deleted.
+         */
+        void ForgetTexture(GLuint texture);
+
+        StateCache(const StateCache&) = delete;
+        StateCache& operator=(const StateCache&) = delete;
+
+        private:
+        static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+        static bool& is_dsa_disabled();
+
+        /**
+         * Updates a cached binding, recording the bind as issued to given
+         * entry point or as elided.
+         *
+         * @returns Value indicating whether the binding changed.
+         */
+        static bool Update
+        (
+            GLuint& binding, 
+            GLuint value, 
+            const char* entry_point
+        );
+
+        GLuint program_;
+        GLuint draw_frame_buffer_;
+        GLuint read_frame_buffer_;
+        GLuint vertex_array_;
+        GLuint active_texture_unit_;
+
+        // Missing entries are unknown.
+        std::map<GLenum, GLuint> buffers_;
+        std::map<std::pair<GLuint, GLenum>, GLuint> textures_;
+    };
+}
+
+#include <oogl/StateCache.cpp>
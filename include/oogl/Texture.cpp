@@ -7,6 +7,36 @@ namespace oogl
     {
         return GL_TEXTURE0 + index;
     }
+    inline std::size_t Texture::GetPixelByteCount
+    (
+        const GLenum format, 
+        const GLenum type
+    )
+    {
+        std::size_t component_count;
+        switch (format)
+        {
+            case GL_RED: case GL_GREEN: case GL_BLUE: 
+            case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: 
+                component_count = 1; break;
+            case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:
+                component_count = 2; break;
+            case GL_RGB: case GL_BGR: 
+            case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+                component_count = 3; break;
+            default:
+                component_count = 4; break;
+        }
+        switch (type)
+        {
+            case GL_UNSIGNED_BYTE: case GL_BYTE: 
+                return component_count;
+            case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT:
+                return 2 * component_count;
+            default:
+                return 4 * component_count;
+        }
+    }
 
     inline Texture::Texture()
         : Texture(Binding::Texture2D, GL_RGB, 1, 1) {}
@@ -22,7 +52,17 @@ namespace oogl
           height_(height)
     {
         GLuint handle;
-        glGenTextures(1, &handle);
+        if (StateCache::is_dsa_enabled())
+        {
+            glCreateTextures(static_cast<GLenum>(target), 1, &handle);
+            Instrumentation::RecordCall("glCreateTextures");
+        }
+        else
+        {
+            glGenTextures(1, &handle);
+            Instrumentation::RecordCall("glGenTextures");
+        }
+
         Initialize(handle);
         set_binding_target(target);
     }
@@ -30,16 +70,22 @@ namespace oogl
     inline Texture::~Texture()
     {
         const GLuint object = handle();
+        StateCache::current().ForgetTexture(object);
         glDeleteTextures(1, &object);
+        Instrumentation::RecordCall("glDeleteTextures");
     }
     inline void Texture::Bind()
     {
-        glBindTexture(binding_target(), handle());
+        StateCache::current().BindTexture(binding_target(), handle());
     }
     inline void Texture::BindToUnit(const GLint index)
     {
-        glActiveTexture(Texture::GetUnit(index));
-        Bind();
+        StateCache::current().BindTextureUnit
+        (
+            static_cast<GLuint>(index), 
+            binding_target(), 
+            handle()
+        );
     }
     inline void Texture::BindToTarget(const Binding target)
     {
@@ -55,31 +101,103 @@ namespace oogl
         const GLvoid* data
     )
     {
-        if (binding_target() == 
-            static_cast<GLenum>(Binding::Texture1D))
+        const Instrumentation::Scope scope("Texture::UploadData");
+
+        if (data != nullptr)
         {
-            glTexImage1D
+            Instrumentation::RecordUpload
             (
-                binding_target(),
-                level,
-                internal_format_,
-                width_, 0,
-                format, type,
-                data
+                GetPixelByteCount(format, type) * width_ * height_
             );
         }
+        if (is_immutable_ && StateCache::is_dsa_enabled())
+        {
+            if (binding_target() == 
+                static_cast<GLenum>(Binding::Texture1D))
+            {
+                glTextureSubImage1D
+                (
+                    handle(), 
+                    level, 
+                    0, width_, 
+                    format, type, 
+                    data
+                );
+                Instrumentation::RecordCall("glTextureSubImage1D");
+            }
+            else
+            {
+                glTextureSubImage2D
+                (
+                    handle(), 
+                    level, 
+                    0, 0, width_, height_, 
+                    format, type, 
+                    data
+                );
+                Instrumentation::RecordCall("glTextureSubImage2D");
+            }
+            return;
+        }
+
+        Bind();
+        if (binding_target() == 
+            static_cast<GLenum>(Binding::Texture1D))
+        {
+            if (is_immutable_)
+            {
+                glTexSubImage1D
+                (
+                    binding_target(),
+                    level,
+                    0, width_,
+                    format, type,
+                    data
+                );
+                Instrumentation::RecordCall("glTexSubImage1D");
+            }
+            else
+            {
+                glTexImage1D
+                (
+                    binding_target(),
+                    level,
+                    internal_format_,
+                    width_, 0,
+                    format, type,
+                    data
+                );
+                Instrumentation::RecordCall("glTexImage1D");
+            }
+        }
         else if (binding_target() == 
                  static_cast<GLenum>(Binding::Texture2D))
         {
-            glTexImage2D
-            (
-                binding_target(),
-                level,
-                internal_format_,
-                width_, height_, 0,
-                format, type,
-                data
-            );
+            if (is_immutable_)
+            {
+                glTexSubImage2D
+                (
+                    binding_target(),
+                    level,
+                    0, 0, width_, height_,
+                    format, type,
+                    data
+                );
+                Instrumentation::RecordCall("glTexSubImage2D");
+            }
+            else
+            {
+                glTexImage2D
+                (
+                    binding_target(),
+                    level,
+                    internal_format_,
+                    width_, height_, 0,
+                    format, type,
+                    data
+                );
+                Instrumentation::RecordCall("glTexImage2D");
+            }
         }
     }
     inline void Texture::DownloadData
@@ -90,6 +208,28 @@ namespace oogl
         GLvoid* data
     ) const
     {
+        const Instrumentation::Scope scope("Texture::DownloadData");
+
+        Instrumentation::RecordDownload
+        (
+            GetPixelByteCount(format, type) * width_ * height_
+        );
+        if (StateCache::is_dsa_enabled())
+        {
+            // Reads into a pixel pack buffer are bounded by the buffer.
+            glGetTextureImage
+            (
+                handle(), 
+                level, 
+                format, type, 
+                (std::numeric_limits<GLsizei>::max)(), 
+                data
+            );
+            Instrumentation::RecordCall("glGetTextureImage");
+            return;
+        }
+
+        StateCache::current().BindTexture(binding_target(), handle());
         glGetTexImage
         ( 	
             binding_target(),
@@ -97,10 +237,22 @@ namespace oogl
   	        format,type,
   	        data
         );
+        Instrumentation::RecordCall("glGetTexImage");
     }
     inline void Texture::CopyData(const Texture& source)
     {
-        Resize(source.width_, source.height_);
+        const Instrumentation::Scope scope("Texture::CopyData");
+
+        if (width_ != source.width_ || height_ != source.height_)
+        {
+            Resize(source.width_, source.height_);
+
+            // Immutable storage keeps its size.
+            if (width_ != source.width_ || height_ != source.height_)
+            {
+                return;
+            }
+        }
         glCopyImageSubData
         (
             source.handle(), 
@@ -113,6 +265,7 @@ namespace oogl
             0, 0, 0,
             source.width_, source.height_, 1
         );
+        Instrumentation::RecordCall("glCopyImageSubData");
     }
     inline void Texture::ClearData
     (
@@ -122,20 +275,128 @@ namespace oogl
         const GLvoid* data
     )
     {
+        const Instrumentation::Scope scope("Texture::ClearData");
+
         glClearTexImage(handle(), level, format, type, data);
+        Instrumentation::RecordCall("glClearTexImage");
     }
 
+    inline void Texture::DefineStorage(const GLsizei level_count)
+    {
+        const Instrumentation::Scope scope("Texture::DefineStorage");
+
+        if (StateCache::is_dsa_enabled())
+        {
+            if (binding_target() == 
+                static_cast<GLenum>(Binding::Texture1D))
+            {
+                glTextureStorage1D
+                (
+                    handle(), 
+                    level_count, 
+                    internal_format_, 
+                    width_
+                );
+                Instrumentation::RecordCall("glTextureStorage1D");
+            }
+            else
+            {
+                glTextureStorage2D
+                (
+                    handle(), 
+                    level_count, 
+                    internal_format_, 
+                    width_, height_
+                );
+                Instrumentation::RecordCall("glTextureStorage2D");
+            }
+            is_immutable_ = true;
+            return;
+        }
+
+        Bind();
+        if (binding_target() == 
+            static_cast<GLenum>(Binding::Texture1D))
+        {
+            glTexStorage1D
+            (
+                binding_target(), 
+                level_count, 
+                internal_format_, 
+                width_
+            );
+            Instrumentation::RecordCall("glTexStorage1D");
+        }
+        else
+        {
+            glTexStorage2D
+            (
+                binding_target(), 
+                level_count, 
+                internal_format_, 
+                width_, height_
+            );
+            Instrumentation::RecordCall("glTexStorage2D");
+        }
+        is_immutable_ = true;
+    }
     inline void Texture::Resize
     (
         const GLsizei width,
         const GLsizei height
     )
     {
+        const Instrumentation::Scope scope("Texture::Resize");
+
+        // Immutable storage cannot be reallocated. Pooled textures are 
+        // resized by their pool, which swaps them for another.
+        assert(!is_immutable_);
+        if (is_immutable_) { return; }
+
         width_ = width;
         height_ = height;
-        
+
+        // Without data, the format and type only have to be compatible
+        // with the internal format, e.g. integer formats take integer data.
+        GLint format, type;
+        glGetInternalformativ
+        (
+            binding_target(), internal_format_, 
+            GL_TEXTURE_IMAGE_FORMAT, 1, &format
+        );
+        Instrumentation::RecordCall("glGetInternalformativ");
+        glGetInternalformativ
+        (
+            binding_target(), internal_format_, 
+            GL_TEXTURE_IMAGE_TYPE, 1, &type
+        );
+        Instrumentation::RecordCall("glGetInternalformativ");
+
+        UploadData
+        (
+            0, 
+            static_cast<GLenum>(format), static_cast<GLenum>(type), 
+            nullptr
+        );
+    }
+
+    inline void Texture::SetParameter
+    (
+        const GLenum name, 
+        const GLint value
+    )
+    {
+        const Instrumentation::Scope scope("Texture::SetParameter");
+
+        if (StateCache::is_dsa_enabled())
+        {
+            glTextureParameteri(handle(), name, value);
+            Instrumentation::RecordCall("glTextureParameteri");
+            return;
+        }
         Bind();
-        UploadData(0, GL_RED, GL_FLOAT, nullptr);
+        glTexParameteri(binding_target(), name, value);
+        Instrumentation::RecordCall("glTexParameteri");
     }
 
     inline void Texture::set_binding_target(const Binding value)
@@ -145,21 +406,11 @@ namespace oogl
 
     inline void Texture::set_minification_filter(const Filter filter)
     {
-        glTexParameteri
-        (
-            binding_target(),
-            GL_TEXTURE_MIN_FILTER,
-            static_cast<GLint>(filter)
-        );
+        SetParameter(GL_TEXTURE_MIN_FILTER, static_cast<GLint>(filter));
     }
     inline void Texture::set_magnification_filter(const Filter filter)
     {
-        glTexParameteri
-        (
-            binding_target(),
-            GL_TEXTURE_MAG_FILTER,
-            static_cast<GLint>(filter)
-        );
+        SetParameter(GL_TEXTURE_MAG_FILTER, static_cast<GLint>(filter));
     }
     inline void Texture::set_filters(const Filter filter)
     {
@@ -169,21 +420,11 @@ namespace oogl
 
     inline void Texture::set_s_wrapper(const Wrapper wrapper)
     {
-        glTexParameteri
-        (
-            binding_target(),
-            GL_TEXTURE_WRAP_S,
-            static_cast<GLint>(wrapper)
-        );
+        SetParameter(GL_TEXTURE_WRAP_S, static_cast<GLint>(wrapper));
     }
     inline void Texture::set_t_wrapper(const Wrapper wrapper)
     {
-        glTexParameteri
-        (
-            binding_target(),
-            GL_TEXTURE_WRAP_T,
-            static_cast<GLint>(wrapper)
-        );
+        SetParameter(GL_TEXTURE_WRAP_T, static_cast<GLint>(wrapper));
     }
     inline void Texture::set_wrappers(const Wrapper wrapper)
     {
@@ -199,4 +440,12 @@ namespace oogl
     {
         return height_;
     }
+    inline GLint Texture::internal_format() const
+    {
+        return internal_format_;
+    }
+    inline bool Texture::is_immutable() const
+    {
+        return is_immutable_;
+    }
 }
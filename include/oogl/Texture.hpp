@@ -8,9 +8,14 @@
 
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <limits>
+
 #include <glew/glew.h>
 
 #include <oogl/GLObject.hpp>
+#include <oogl/StateCache.hpp>
 
 
 namespace oogl
@@ -20,6 +25,9 @@ namespace oogl
      * Textures can be used as input to shaders or as render targets.
      *
      * @note Currently only catering to 1D and 2D textures.
+     *
+     * Operations bind the texture to the active unit as needed, unless 
+     * direct state access is enabled.
      */
     class Texture : public GLObject
     {
@@ -108,7 +116,9 @@ namespace oogl
             GLvoid* data
         ) const;
         /**
-         * Copies pixel data from another texture.
+         * Copies pixel data from another texture, resizing this one if 
+         * sizes differ. Nothing is copied into an immutable texture of 
+         * another size.
          */
         void CopyData(const Texture& source);
         /**
@@ -122,7 +132,14 @@ namespace oogl
         );
 
         /**
-         * Resizes texture and clears it to black.
+         * Allocates immutable storage of the texture's format and size.
+         * Afterwards, uploads update the existing storage and the texture
+         * may no longer be resized.
+         */
+        void DefineStorage(GLsizei level_count = 1);
+        /**
+         * Resizes mutable texture, leaving its contents undefined.
+         * Immutable textures are left as they are.
          */
         void Resize(GLsizei width, GLsizei height);
 
@@ -165,10 +182,26 @@ namespace oogl
          * Gets height in pixels.
          */
         GLint height() const;
+        /**
+         * Gets internal format.
+         */
+        GLint internal_format() const;
+        /**
+         * Checks whether storage is immutable.
+         */
+        bool is_immutable() const;
         
         private:
+        /**
+         * Gets size of a pixel in client memory.
+         */
+        static std::size_t GetPixelByteCount(GLenum format, GLenum type);
+
+        void SetParameter(GLenum name, GLint value);
+
         GLint internal_format_;
         GLsizei width_, height_;
+        bool is_immutable_ = false;
     };
 }
 
@@ -6,6 +6,7 @@ namespace oogl
     template <typename T, GLsizei N>
     inline UniformBase<T, N>::UniformBase()
         : program_(nullptr), 
+          location_(-1),
           name_("") {}
     template <typename T, GLsizei N>
     inline UniformBase<T, N>::UniformBase
@@ -6,88 +6,176 @@ namespace oogl
     template <unsigned int D, GLsizei N>
     inline void VectorUniformBase<GLint, D, N>::set(const GLint* value)
     {
+        if (!is_valid()) { return; }
+
         switch (D)
         {
             case 1:
-                glUniform1iv(location(), N, value);
+                glProgramUniform1iv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform1iv");
                 break;
             case 2:
-                glUniform2iv(location(), N, value);
+                glProgramUniform2iv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform2iv");
                 break;
             case 3:
-                glUniform3iv(location(), N, value);
+                glProgramUniform3iv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform3iv");
                 break;
             case 4:
-                glUniform4iv(location(), N, value);
+                glProgramUniform4iv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform4iv");
                 break;
             default:
-                glUniform1iv(location(), N, value);
+                glProgramUniform1iv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform1iv");
                 break;
         }
     }
     template <unsigned int D, GLsizei N>
     inline void VectorUniformBase<GLuint, D, N>::set(const GLuint* value)
     {
+        if (!is_valid()) { return; }
+
         switch (D)
         {
             case 1:
-                glUniform1uiv(location(), N, value);
+                glProgramUniform1uiv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform1uiv");
                 break;
             case 2:
-                glUniform2uiv(location(), N, value);
+                glProgramUniform2uiv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform2uiv");
                 break;
             case 3:
-                glUniform3uiv(location(), N, value);
+                glProgramUniform3uiv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform3uiv");
                 break;
             case 4:
-                glUniform4uiv(location(), N, value);
+                glProgramUniform4uiv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform4uiv");
                 break;
             default:
-                glUniform1uiv(location(), N, value);
+                glProgramUniform1uiv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform1uiv");
                 break;
         }
     }
     template <unsigned int D, GLsizei N>
     inline void VectorUniformBase<GLfloat, D, N>::set(const GLfloat* value)
     {
+        if (!is_valid()) { return; }
+
         switch (D)
         {
             case 1:
-                glUniform1fv(location(), N, value);
+                glProgramUniform1fv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform1fv");
                 break;
             case 2:
-                glUniform2fv(location(), N, value);
+                glProgramUniform2fv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform2fv");
                 break;
             case 3:
-                glUniform3fv(location(), N, value);
+                glProgramUniform3fv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform3fv");
                 break;
             case 4:
-                glUniform4fv(location(), N, value);
+                glProgramUniform4fv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform4fv");
                 break;
             default:
-                glUniform1fv(location(), N, value);
+                glProgramUniform1fv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform1fv");
                 break;
         }
     }
     template <unsigned int D, GLsizei N>
     inline void VectorUniformBase<GLdouble, D, N>::set(const GLdouble* value)
     {
+        if (!is_valid()) { return; }
+
         switch (D)
         {
             case 1:
-                glUniform1dv(location(), N, value);
+                glProgramUniform1dv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform1dv");
                 break;
             case 2:
-                glUniform2dv(location(), N, value);
+                glProgramUniform2dv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform2dv");
                 break;
             case 3:
-                glUniform3dv(location(), N, value);
+                glProgramUniform3dv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform3dv");
                 break;
             case 4:
-                glUniform4dv(location(), N, value);
+                glProgramUniform4dv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform4dv");
                 break;
             default:
-                glUniform1dv(location(), N, value);
+                glProgramUniform1dv
+                (
+                    program().handle(), location(), N, value
+                );
+                Instrumentation::RecordCall("glProgramUniform1dv");
                 break;
         }
     }
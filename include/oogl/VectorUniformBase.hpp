@@ -9,6 +9,7 @@
 
 #include <glew/glew.h>
 
+#include <oogl/StateCache.hpp>
 #include <oogl/UniformBase.hpp>
 
 
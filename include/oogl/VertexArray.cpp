@@ -7,26 +7,45 @@ namespace oogl
     {
         GLuint handle;
         glGenVertexArrays(1, &handle);
+        Instrumentation::RecordCall("glGenVertexArrays");
         Initialize(handle);
     }
     inline VertexArray::~VertexArray()
     {
         const GLuint object = handle();
+        StateCache::current().ForgetVertexArray(object);
         glDeleteVertexArrays(1, &object);
+        Instrumentation::RecordCall("glDeleteVertexArrays");
     }
 
     inline void VertexArray::Bind()
     {
-        glBindVertexArray(handle());
+        StateCache::current().BindVertexArray(handle());
+    }
+    inline void VertexArray::Draw
+    (
+        const GLenum mode, 
+        const GLint first, 
+        const GLsizei count
+    )
+    {
+        const Instrumentation::Scope scope("VertexArray::Draw");
+
+        Bind();
+        glDrawArrays(mode, first, count);
+        Instrumentation::RecordCall("glDrawArrays");
+        Instrumentation::RecordDraw();
     }
 
     inline void VertexArray::EnableAttribute(const GLuint index)
     {
         glEnableVertexAttribArray(index);
+        Instrumentation::RecordCall("glEnableVertexAttribArray");
     }
     inline void VertexArray::DisableAttribute(const GLuint index)
     {
         glDisableVertexAttribArray(index);
+        Instrumentation::RecordCall("glDisableVertexAttribArray");
     }
 
     inline void VertexArray::EnableAttributeRange
@@ -11,6 +11,7 @@
 #include <glew/glew.h>
 
 #include <oogl/GLObject.hpp>
+#include <oogl/StateCache.hpp>
 
 
 namespace oogl
@@ -56,6 +57,11 @@ namespace oogl
         ~VertexArray() override;
 
         void Bind() override;
+
+        /**
+         * Binds to context and draws a range of vertices.
+         */
+        void Draw(GLenum mode, GLint first, GLsizei count);
     };
 }
 
@@ -15,7 +15,17 @@ namespace oogl
         : usage_(usage)
     {
         GLuint handle;
-        glGenBuffers(1, &handle);
+        if (StateCache::is_dsa_enabled())
+        {
+            glCreateBuffers(1, &handle);
+            Instrumentation::RecordCall("glCreateBuffers");
+        }
+        else
+        {
+            glGenBuffers(1, &handle);
+            Instrumentation::RecordCall("glGenBuffers");
+        }
+
         Initialize(handle);
         set_binding_target(target);
     }
@@ -23,12 +33,19 @@ namespace oogl
     inline VertexBuffer::~VertexBuffer()
     {
         const GLuint object = handle();
+        StateCache::current().ForgetBuffer(object);
         glDeleteBuffers(1, &object);
+        Instrumentation::RecordCall("glDeleteBuffers");
+    }
+
+    inline void VertexBuffer::Unbind(const Binding target)
+    {
+        StateCache::current().BindBuffer(static_cast<GLenum>(target), 0);
     }
     
     inline void VertexBuffer::Bind()
     {
-        glBindBuffer(binding_target(), handle());
+        StateCache::current().BindBuffer(binding_target(), handle());
     }
 
     inline void VertexBuffer::BindToTarget(const Binding target)
@@ -43,12 +60,73 @@ namespace oogl
         const GLvoid* data
     )
     {
+        const Instrumentation::Scope scope("VertexBuffer::UploadData");
+
+        if (data != nullptr) { Instrumentation::RecordUpload(byte_count); }
+        if (StateCache::is_dsa_enabled())
+        {
+            glNamedBufferData
+            (
+                handle(),
+                byte_count, data,
+                static_cast<GLenum>(usage_)
+            );
+            Instrumentation::RecordCall("glNamedBufferData");
+            return;
+        }
+
+        Bind();
         glBufferData
         (
             binding_target(),
             byte_count, data,
             static_cast<GLenum>(usage_)
         );
+        Instrumentation::RecordCall("glBufferData");
+    }
+
+    inline GLvoid* VertexBuffer::MapRange
+    (
+        const GLintptr offset,
+        const GLsizeiptr byte_count,
+        const GLbitfield access
+    )
+    {
+        const Instrumentation::Scope scope("VertexBuffer::MapRange");
+
+        if (StateCache::is_dsa_enabled())
+        {
+            Instrumentation::RecordCall("glMapNamedBufferRange");
+            return glMapNamedBufferRange
+            (
+                handle(),
+                offset, byte_count,
+                access
+            );
+        }
+
+        Bind();
+        Instrumentation::RecordCall("glMapBufferRange");
+        return glMapBufferRange
+        (
+            binding_target(),
+            offset, byte_count,
+            access
+        );
+    }
+    inline bool VertexBuffer::Unmap()
+    {
+        const Instrumentation::Scope scope("VertexBuffer::Unmap");
+
+        if (StateCache::is_dsa_enabled())
+        {
+            Instrumentation::RecordCall("glUnmapNamedBuffer");
+            return glUnmapNamedBuffer(handle()) == GL_TRUE;
+        }
+
+        Bind();
+        Instrumentation::RecordCall("glUnmapBuffer");
+        return glUnmapBuffer(binding_target()) == GL_TRUE;
     }
 
     inline void VertexBuffer::set_binding_target(const Binding value)
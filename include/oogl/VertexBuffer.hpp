@@ -11,6 +11,7 @@
 #include <glew/glew.h>
 
 #include <oogl/GLObject.hpp>
+#include <oogl/StateCache.hpp>
 
 
 namespace oogl
@@ -18,6 +19,9 @@ namespace oogl
     /**
      * This class wraps around OpenGL vertex buffer objects.
      * Vertex buffers store vertex data to be used in the rendering pipeline.
+     *
+     * Operations bind the buffer as needed, unless direct state access is
+     * enabled.
      */
     class VertexBuffer : public GLObject
     {
@@ -54,6 +58,11 @@ namespace oogl
             StreamCopy = GL_STREAM_COPY
         };
 
+        /**
+         * Unbinds any buffer from given target.
+         */
+        static void Unbind(Binding target);
+
         /**
          * Creates a new buffer.
          * Default binding target is the array buffer.
@@ -93,6 +102,24 @@ namespace oogl
             GLsizeiptr byte_count,
             const GLvoid* data
         );
+        /**
+         * Maps a range of the buffer's data into client memory.
+         *
+         * @returns Pointer to mapped data, or null on failure.
+         */
+        GLvoid* MapRange
+        (
+            GLintptr offset,
+            GLsizeiptr byte_count,
+            GLbitfield access
+        );
+        /**
+         * Releases the buffer's mapping.
+         *
+         * @returns Value indicating whether data remained valid while 
+         *          mapped.
+         */
+        bool Unmap();
 
         /**
          * Sets the binding target.
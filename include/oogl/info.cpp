@@ -15,4 +15,34 @@ namespace oogl
             )
         );
     }
+    inline std::string vendor_string()
+    {
+        return std::string
+        (
+            reinterpret_cast<const char*>
+            (
+                glGetString(GL_VENDOR)
+            )
+        );
+    }
+    inline std::string renderer_string()
+    {
+        return std::string
+        (
+            reinterpret_cast<const char*>
+            (
+                glGetString(GL_RENDERER)
+            )
+        );
+    }
+    inline std::string shading_language_version_string()
+    {
+        return std::string
+        (
+            reinterpret_cast<const char*>
+            (
+                glGetString(GL_SHADING_LANGUAGE_VERSION)
+            )
+        );
+    }
 }
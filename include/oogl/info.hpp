@@ -14,6 +14,9 @@
 namespace oogl
 {
     std::string version_string();
+    std::string vendor_string();
+    std::string renderer_string();
+    std::string shading_language_version_string();
 }
 
 #include <oogl/info.cpp>
@@ -0,0 +1,53 @@
+# Embeds shader sources in the executable.
+#
+# Writes an initializer list of { file name, source } pairs, included by
+# src/ShaderLibrary.cpp. Sources are split into raw string literals short
+# enough for the compiler. The output is only rewritten when it changes, so
+# unchanged shaders do not trigger a rebuild.
+#
+# @author Raoul Harel
+# @url github.com/rharel/cpp-mandelbrot
+
+param
+(
+    [Parameter(Mandatory = $true)] [string] $SourceDirectory,
+    [Parameter(Mandatory = $true)] [string] $OutputPath
+)
+
+$ErrorActionPreference = "Stop"
+
+$MaxLiteralLength = 4096
+$Delimiter = "glsl"
+
+$lines = @("// Generated by EmbedShaders.ps1. Do not edit.")
+foreach ($file in Get-ChildItem -Path $SourceDirectory -Filter *.glsl | Sort-Object Name)
+{
+    $source = [System.IO.File]::ReadAllText($file.FullName) -replace "`r`n", "`n"
+    if ($source.Contains(")$Delimiter`""))
+    {
+        throw "$($file.Name) contains the raw string delimiter"
+    }
+
+    $lines += "{"
+    $lines += "    `"$($file.Name)`","
+    for ($offset = 0; $offset -lt $source.Length; $offset += $MaxLiteralLength)
+    {
+        $length = [Math]::Min($MaxLiteralLength, $source.Length - $offset)
+        $lines += "    R`"$Delimiter(" + $source.Substring($offset, $length) + ")$Delimiter`""
+    }
+    if ($source.Length -eq 0) { $lines += "    `"`"" }
+    $lines += "},"
+}
+$output = ($lines -join "`r`n") + "`r`n"
+
+$directory = Split-Path -Parent $OutputPath
+if ($directory -and -not (Test-Path $directory))
+{
+    New-Item -ItemType Directory -Path $directory | Out-Null
+}
+if ((Test-Path $OutputPath) -and 
+    [System.IO.File]::ReadAllText($OutputPath) -eq $output)
+{
+    exit 0
+}
+[System.IO.File]::WriteAllText($OutputPath, $output)
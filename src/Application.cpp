@@ -1,19 +1,28 @@
 #include <mandelbrot/Application.h>
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <fstream>
 #include <limits>
-
-#include <soil/soil.h>
+#include <sstream>
 
 #include <oogl/info.hpp>
+#include <oogl/Instrumentation.hpp>
+#include <oogl/StateCache.hpp>
+
+#include <mandelbrot/Tracer.h>
 
 
 using namespace mandelbrot;
 
 
 const char* Application::WINDOW_TITLE = "Mandelbrot Explorer";
+
+const double Application::PENDING_IMAGE_TIMEOUT_SECONDS = 0.001;
+const double Application::PENDING_STEP_TIMEOUT_SECONDS = 0.1;
+const double Application::HUD_REFRESH_INTERVAL_SECONDS = 0.25;
 std::unique_ptr<Application> Application::instance_;
 
 void Application::Initialize
@@ -59,11 +68,29 @@ void Application::WindowSizeCallback
     const int height
 )
 {
-    window_size_ = Vector2u(width, height);
+    {
+        const auto lock = compute_thread_.Acquire();
 
-    renderer_.set_display_size(Vector2u(width, height));
-    renderer_.Reset();
-    Step();
+        window_size_ = Vector2u(width, height);
+
+        renderer_.set_display_size(Vector2u(width, height));
+        renderer_.Reset();
+        Step();
+
+        needs_redraw_ = true;
+    }
+    compute_thread_.Notify();
+}
+
+void Application::WindowRefreshCallback(GLFWwindow* window)
+{
+    auto application = 
+        static_cast<Application*>(glfwGetWindowUserPointer(window));
+
+    if (application != nullptr)
+    {
+        application->needs_redraw_ = true;
+    }
 }
 
 void Application::KeyCallback
@@ -91,7 +118,16 @@ void Application::KeyCallback
     const int modifiers
 )
 {
-    keyboard_controller_.Process(key, action, modifiers);
+    latency_monitor_.RecordInput();
+    if (is_recording_input_)
+    {
+        input_log_.RecordKey(key, action, modifiers);
+    }
+    {
+        const auto lock = compute_thread_.Acquire();
+        keyboard_controller_.Process(key, action, modifiers);
+    }
+    compute_thread_.Notify();
 }
 
 Application::Application
@@ -100,11 +136,21 @@ Application::Application
     const unsigned int window_height
 )
     : window_size_(window_width, window_height),
-      keyboard_controller_(*this) {}
+      keyboard_controller_(*this),
+      compute_thread_(renderer_) {}
 
 bool Application::Launch()
 {
+    Tracer::SetThreadName("Display");
+    startup_stopwatch_.Start();
     if (!Initialize()) { return false; }
+
+    if (!input_recording_path_.empty())
+    {
+        input_log_.Clear();
+        input_log_.set_camera(camera_.position(), camera_.zoom_factor());
+        is_recording_input_ = true;
+    }
     
     Play();
     EnterMainLoop();
@@ -112,11 +158,99 @@ bool Application::Launch()
 
     return true;
 }
+bool Application::LaunchPoster(const PosterSettings& settings)
+{
+    is_synchronous_ = true;
+    is_window_visible_ = false;
+
+    if (!Initialize()) { return false; }
+
+    const bool success = RenderPoster(settings);
+    Dispose();
+
+    return success;
+}
+bool Application::LaunchBenchmark(const BenchmarkSettings& settings)
+{
+    is_synchronous_ = true;
+    is_window_visible_ = false;
+
+    if (!Initialize()) { return false; }
+
+    const bool success = RunBenchmark(settings);
+    Dispose();
+
+    return success;
+}
+bool Application::LaunchReplay(const ReplaySettings& settings)
+{
+    is_synchronous_ = true;
+    is_window_visible_ = false;
+
+    if (!Initialize()) { return false; }
+
+    Play();
+    const bool success = ReplayInput(settings);
+    Dispose();
+
+    return success;
+}
 void Application::Close()
 {
     glfwSetWindowShouldClose(window_, GLFW_TRUE);
 }
 
+SnapshotWriter::Format Application::snapshot_format() const
+{
+    return snapshot_format_;
+}
+void Application::set_snapshot_format(const SnapshotWriter::Format value)
+{
+    snapshot_format_ = value;
+}
+
+const std::string& Application::gl_statistics_path() const
+{
+    return gl_statistics_path_;
+}
+void Application::set_gl_statistics_path(const std::string& value)
+{
+    gl_statistics_path_ = value;
+}
+const std::string& Application::input_recording_path() const
+{
+    return input_recording_path_;
+}
+void Application::set_input_recording_path(const std::string& value)
+{
+    input_recording_path_ = value;
+}
+const std::string& Application::trace_path() const
+{
+    return trace_path_;
+}
+void Application::set_trace_path(const std::string& value)
+{
+    trace_path_ = value;
+}
+const std::string& Application::stage_times_path() const
+{
+    return stage_times_path_;
+}
+void Application::set_stage_times_path(const std::string& value)
+{
+    stage_times_path_ = value;
+}
+
+bool Application::is_synchronous() const
+{
+    return is_synchronous_;
+}
+void Application::set_is_synchronous(const bool value)
+{
+    is_synchronous_ = value;
+}
+
 bool Application::Initialize()
 {
     return InitializeWindow() &&
@@ -127,6 +261,7 @@ bool Application::InitializeWindow()
 {
     if (!glfwInit()) { return false; }
 
+    glfwWindowHint(GLFW_VISIBLE, is_window_visible_ ? GLFW_TRUE : GLFW_FALSE);
     window_ = glfwCreateWindow
     (
         window_size_.x,
@@ -134,6 +269,7 @@ bool Application::InitializeWindow()
         WINDOW_TITLE, 
         nullptr, nullptr
     );
+    glfwDefaultWindowHints();
     if (window_ == nullptr)
     {
         glfwTerminate();
@@ -143,6 +279,13 @@ bool Application::InitializeWindow()
     glfwSetWindowUserPointer(window_, this);
     glfwSetWindowSizeCallback(window_, Application::WindowSizeCallback);
     glfwSetKeyCallback(window_, Application::KeyCallback);
+    glfwSetWindowRefreshCallback
+    (
+        window_, 
+        Application::WindowRefreshCallback
+    );
+
+    snapshot_writer_.set_notifier([] { glfwPostEmptyEvent(); });
 
     return true;
 }
@@ -162,10 +305,26 @@ bool Application::InitializeOpenGL()
 }
 bool Application::InitializeRenderer()
 {
-    if (!renderer_.Initialize())
+    if (is_synchronous_)
     {
-        std::cout << renderer_.status_message() << std::endl;
-        return false;
+        if (!renderer_.Initialize())
+        {
+            std::cout << renderer_.status_message() << std::endl;
+            return false;
+        }
+    }
+    else
+    {
+        if (!renderer_.InitializeDisplay())
+        {
+            std::cout << renderer_.status_message() << std::endl;
+            return false;
+        }
+        if (!compute_thread_.Start(window_))
+        {
+            std::cout << compute_thread_.status_message() << std::endl;
+            return false;
+        }
     }
     renderer_.set_display_size(window_size_);
     UpdateViewport();
@@ -175,7 +334,370 @@ bool Application::InitializeRenderer()
 
 void Application::Dispose()
 {
+    pixel_reader_.Finish();
+    snapshot_writer_.Finish();
+    PrintSnapshotReports();
+
+    compute_thread_.Stop();
+    if (is_recording_input_)
+    {
+        if (input_log_.Write(input_recording_path_))
+        {
+            std::cout << "Saved: " << input_recording_path_ << std::endl;
+        }
+        else
+        {
+            std::cout << "Error saving: " 
+                      << input_recording_path_ 
+                      << std::endl;
+        }
+        is_recording_input_ = false;
+    }
+    if (!trace_path_.empty()) { WriteTrace(); }
+    Tracer::ReleaseThread();
     glfwTerminate();
+
+    WriteGLStatistics();
+    WriteStageTimes();
+}
+void Application::WriteTrace()
+{
+    if (!Tracer::is_enabled())
+    {
+        std::cout << "Tracing is disabled, see --trace" << std::endl;
+        return;
+    }
+    const std::string path = 
+        trace_path_.empty() ? std::string(Tracer::DEFAULT_PATH) : trace_path_;
+
+    if (Tracer::Write(path))
+    {
+        std::cout << "Trace written to " << path << std::endl;
+    }
+    else { std::cout << "Could not write trace to " << path << std::endl; }
+}
+void Application::WriteGLStatistics() const
+{
+    if (gl_statistics_path_.empty()) { return; }
+
+    std::ofstream file(gl_statistics_path_);
+    oogl::Instrumentation::PrintSummary(file);
+    if (file.fail())
+    {
+        std::cout << "Could not write GL statistics to " 
+                  << gl_statistics_path_ 
+                  << std::endl;
+    }
+}
+void Application::WriteStageTimes() const
+{
+    if (stage_times_path_.empty()) { return; }
+
+    std::ofstream file(stage_times_path_);
+    file << "stage,samples,min_ms,avg_ms,p99_ms" << std::endl
+         << std::fixed << std::setprecision(4);
+    for (const Renderer::StageTime& time : renderer_.stage_times())
+    {
+        file << time.stage << ","
+             << time.statistics.sample_count << ","
+             << time.statistics.minimum << ","
+             << time.statistics.average << ","
+             << time.statistics.percentile_99
+             << std::endl;
+    }
+    if (file.fail())
+    {
+        std::cout << "Could not write stage times to " 
+                  << stage_times_path_ 
+                  << std::endl;
+    }
+}
+
+bool Application::RenderPoster(const PosterSettings& settings)
+{
+    PosterRenderer poster(renderer_);
+    poster.set_size(settings.size);
+    poster.set_tile_size
+    (
+        settings.tile_size == 0 ? 
+        PosterRenderer::GetMaxTileSize() : 
+        settings.tile_size
+    );
+    poster.set_viewport_position(camera_.position());
+    poster.set_viewport_size(camera_.zoom_factor());
+
+    if (settings.first_tile_index >= poster.tile_count())
+    {
+        std::cout << "Error: first tile index exceeds tile count ("
+                  << poster.tile_count() << ")" 
+                  << std::endl;
+        return false;
+    }
+
+    // A single file is streamed from top to bottom and cannot be resumed
+    // midway; tiled output can.
+    std::unique_ptr<ImageSink> sink;
+    if (!settings.is_tiled)
+    {
+        if (settings.first_tile_index != 0)
+        {
+            std::cout << "Error: resuming requires tiled output" 
+                      << std::endl;
+            return false;
+        }
+        sink = ImageSink::FromPath(settings.path);
+        if (!sink->Open
+            (
+                settings.path, 
+                poster.size().x, poster.size().y, 
+                PixelReader::CHANNEL_COUNT
+            ))
+        {
+            std::cout << "Error opening: " << settings.path << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Rendering " 
+              << poster.size().x << "x" << poster.size().y 
+              << " poster as " 
+              << poster.column_count() << "x" << poster.row_count() 
+              << " tiles of " << poster.tile_size() << " pixels"
+              << std::endl;
+
+    double total_seconds = 0;
+    const bool success = poster.Render
+    (
+        settings.first_tile_index,
+        [this, &settings, &sink](const PosterRenderer::Tile& tile)
+        {
+            if (sink != nullptr)
+            {
+                return renderer_.WriteImageTile
+                (
+                    *sink, 
+                    tile.size.x, tile.size.y
+                );
+            }
+
+            const std::string tile_path = 
+                GetPosterTilePath(settings.path, tile);
+            std::unique_ptr<ImageSink> tile_sink = 
+                ImageSink::FromPath(tile_path);
+
+            const bool is_written =
+                tile_sink->Open
+                (
+                    tile_path, 
+                    tile.size.x, tile.size.y, 
+                    PixelReader::CHANNEL_COUNT
+                ) &&
+                renderer_.WriteImageTile
+                (
+                    *tile_sink, 
+                    tile.size.x, tile.size.y
+                ) &&
+                tile_sink->Close();
+
+            if (!is_written)
+            {
+                std::cout << "Error saving: " << tile_path << std::endl;
+            }
+            return is_written;
+        },
+        [this, &total_seconds]
+        (
+            const PosterRenderer::Tile& tile,
+            const unsigned int rendered_count,
+            const unsigned int remaining_count,
+            const double seconds
+        )
+        {
+            total_seconds += seconds;
+            const double remaining_seconds = 
+                total_seconds / rendered_count * remaining_count;
+
+            std::cout << std::setprecision(1) << std::fixed
+                      << "Tile " << tile.index 
+                      << " (row " << tile.row 
+                      << ", column " << tile.column << "): "
+                      << seconds << " s, "
+                      << remaining_count << " left, about "
+                      << remaining_seconds << " s remaining"
+                      << std::endl;
+            PrintRenderReport();
+        }
+    );
+
+    if (sink != nullptr && !sink->Close())
+    {
+        std::cout << "Error saving: " << settings.path << std::endl;
+        return false;
+    }
+    if (success && settings.is_tiled)
+    {
+        std::cout << "Saved: " 
+                  << poster.tile_count() - settings.first_tile_index 
+                  << " tiles" 
+                  << std::endl;
+    }
+    else if (success)
+    {
+        std::cout << "Saved: " << settings.path << std::endl;
+    }
+    return success;
+}
+std::string Application::GetPosterTilePath
+(
+    const std::string& path,
+    const PosterRenderer::Tile& tile
+)
+{
+    const std::size_t extension_offset = path.find_last_of('.');
+    const bool has_extension = 
+        extension_offset != std::string::npos &&
+        path.find_first_of("/\\", extension_offset) == std::string::npos;
+
+    const std::string stem = 
+        has_extension ? path.substr(0, extension_offset) : path;
+    const std::string extension = 
+        has_extension ? path.substr(extension_offset) : ".png";
+
+    return stem + 
+           "_" + std::to_string(tile.row) + 
+           "_" + std::to_string(tile.column) + 
+           extension;
+}
+
+bool Application::RunBenchmark(const BenchmarkSettings& settings)
+{
+    std::vector<Benchmark::Scene> scenes;
+    for (const std::string& path : 
+         Benchmark::FindStatePaths(settings.state_directory))
+    {
+        Benchmark::Scene scene;
+        if (Benchmark::LoadScene(path, scene)) { scenes.push_back(scene); }
+        else { std::cout << "Error loading: " << path << std::endl; }
+    }
+    if (scenes.empty())
+    {
+        std::cout << "Error: no states found in " 
+                  << settings.state_directory 
+                  << std::endl;
+        return false;
+    }
+
+    std::cout << "Benchmarking " << scenes.size() << " scenes at "
+              << renderer_.image_size().x << "x" 
+              << renderer_.image_size().y 
+              << std::endl;
+
+    Benchmark benchmark(renderer_);
+
+    // Untimed, so that first-use costs in the driver are not counted
+    // against the first scene.
+    benchmark.Run(scenes.front());
+
+    std::vector<Benchmark::Result> results;
+    for (const Benchmark::Scene& scene : scenes)
+    {
+        results.push_back(benchmark.Run(scene));
+        std::cout << std::setprecision(1) << std::fixed
+                  << scene.name << ": " 
+                  << results.back().milliseconds << " ms"
+                  << std::endl;
+    }
+
+    if (!benchmark.Write(settings.path, results))
+    {
+        std::cout << "Error saving: " << settings.path << std::endl;
+        return false;
+    }
+    std::cout << "Saved: " << settings.path << std::endl;
+
+    return true;
+}
+
+bool Application::ReplayInput(const ReplaySettings& settings)
+{
+    InputLog log;
+    if (!log.Read(settings.path))
+    {
+        std::cout << "Error loading: " << settings.path << std::endl;
+        return false;
+    }
+    if (log.has_camera())
+    {
+        camera_.set_position(log.camera_position());
+        camera_.set_zoom_factor(log.camera_zoom_factor());
+        UpdateViewport();
+    }
+
+    const Stopwatch::Duration timestep = 
+        std::chrono::duration_cast<Stopwatch::Duration>
+        (
+            std::chrono::duration<double>(settings.timestep_seconds)
+        );
+
+    std::cout << "Replaying " << log.frame_count() << " frames of " 
+              << settings.path 
+              << std::endl;
+
+    // Frames are timed through to the GPU's completion, since nothing 
+    // waits on presentation in a hidden window.
+    std::vector<double> frame_milliseconds;
+    frame_milliseconds.reserve(log.frame_count());
+    for (const InputLog::Frame& frame : log.frames())
+    {
+        if (glfwWindowShouldClose(window_)) { break; }
+
+        for (const InputLog::KeyEvent& event : frame.key_events)
+        {
+            KeyCallback(event.key, 0, event.action, event.modifiers);
+        }
+        for (unsigned int i = 0; i < frame.count; ++i)
+        {
+            Stopwatch stopwatch;
+            stopwatch.Start();
+
+            Advance
+            (
+                settings.timestep_seconds > 0 ? timestep : frame.duration
+            );
+            RenderFrame();
+            glFinish();
+
+            stopwatch.Stop();
+            frame_milliseconds.push_back
+            (
+                stopwatch.nanoseconds().count() * 1e-6
+            );
+        }
+    }
+    if (frame_milliseconds.empty()) { return true; }
+
+    std::sort(frame_milliseconds.begin(), frame_milliseconds.end());
+    const auto percentile = [&frame_milliseconds](const double fraction)
+    {
+        const std::size_t rank = static_cast<std::size_t>
+        (
+            std::ceil
+            (
+                fraction * static_cast<double>(frame_milliseconds.size())
+            )
+        );
+        return frame_milliseconds[std::max<std::size_t>(rank, 1) - 1];
+    };
+
+    std::cout << std::setprecision(2) << std::fixed
+              << "Frame time (ms): p50 " << percentile(0.5)
+              << ", p90 " << percentile(0.9)
+              << ", p99 " << percentile(0.99)
+              << ", max " << frame_milliseconds.back()
+              << std::endl;
+    PrintLatencyReport();
+
+    return true;
 }
 
 void Application::Pause()
@@ -194,6 +716,23 @@ void Application::Step()
 {
     is_stepping_ = true;
 }
+void Application::ToggleHud()
+{
+    HudStage& hud = renderer_.hud();
+    hud.set_is_visible(!hud.is_visible());
+    renderer_.set_counts_active_pixels(hud.is_visible());
+
+    // Restarts the figures, so the first refresh is due right away.
+    hud_refresh_time_ = Stopwatch::TimePoint();
+    hud_frame_count_ = 0;
+    hud_iteration_count_ = renderer_.iteration_count();
+    needs_redraw_ = true;
+}
+void Application::ToggleCostHeatmap()
+{
+    renderer_.set_shows_cost(!renderer_.shows_cost());
+    Step();
+}
 
 void Application::IncreasePrecision()
 {
@@ -210,6 +749,8 @@ void Application::DecreasePrecision()
 
 bool Application::SaveSnapshot(const char* name)
 {
+    const Tracer::Zone zone("SaveSnapshot");
+
     std::string path;
 
     if (name == nullptr)
@@ -222,12 +763,15 @@ bool Application::SaveSnapshot(const char* name)
     }
     else { path = name; }
 
-    const std::string image_path = path + ".bmp";
+    const std::string image_path = 
+        path + SnapshotWriter::GetExtension(snapshot_format_);
     const std::string state_path = path + ".txt";
+    const std::string cost_path = path + "_cost.raw";
 
     const bool success = 
         SaveImage(image_path.c_str()) &&
-        SaveState(state_path.c_str());
+        SaveState(state_path.c_str()) &&
+        (!renderer_.shows_cost() || SaveCost(cost_path.c_str()));
 
     if (success) { ++ session_saved_snapshots_count_; }
 
@@ -235,65 +779,173 @@ bool Application::SaveSnapshot(const char* name)
 }
 bool Application::SaveImage(const char* path)
 {
-    const unsigned int width = renderer_.resolution();
-    const unsigned int height = renderer_.resolution();
-    const unsigned int channel_count = 3;
-
-    std::vector<unsigned char> pixels(channel_count * width * height);
-    renderer_.GetImagePixels(pixels.data());
+    const std::string image_path(path);
 
-    const bool success = SOIL_save_image
+    const bool success = renderer_.ReadImagePixels
     (
-        path, SOIL_SAVE_TYPE_BMP,
-        width, height, channel_count,
-        pixels.data()
-    ) != 0;
+        pixel_reader_,
+        [this, image_path]
+        (
+            const unsigned char* pixels,
+            const unsigned int width,
+            const unsigned int height
+        )
+        {
+            if (pixels == nullptr)
+            {
+                std::cout << "Error reading image: " 
+                          << image_path 
+                          << std::endl;
+            }
+            else if (!snapshot_writer_.WriteImage
+                     (
+                         image_path, 
+                         pixels, 
+                         width, height
+                     ))
+            {
+                std::cout << "Error saving image (too many pending saves): " 
+                          << image_path 
+                          << std::endl;
+            }
+        }
+    );
 
-    if (success)
+    if (!success)
     {
-        std::cout << "Saved image: " 
-                  << path 
-                  << std::endl;
-    }
-    else
-    {
-        std::cout << "Error saving image: " 
-                  << path 
+        std::cout << "Error saving image (too many pending reads): " 
+                  << image_path 
                   << std::endl;
     }
     return success;
 }
 bool Application::SaveState(const char* path)
 {
-    std::ofstream file(path);
-    if (!file.is_open())
-    {
-        std::cout << "Error saving state: " 
-                  << path 
-                  << std::endl;
-        return false;
-    }
-    
     const int double_precision = 
         std::numeric_limits<double>::max_digits10;
     
-    file << std::setprecision(double_precision)
+    std::ostringstream text;
+    text << std::setprecision(double_precision)
          << std::fixed
          << renderer_.display_viewport().position.x
          << std::endl
          << renderer_.display_viewport().position.y
          << std::endl
          << renderer_.display_viewport().size
+         << std::endl
+         << renderer_.display_image_size().x
+         << std::endl
+         << renderer_.display_image_size().y
          << std::endl;
     
-    file.close();
+    snapshot_writer_.WriteText(path, text.str());
+
+    return true;
+}
+bool Application::SaveCost(const char* path)
+{
+    CostMap map;
+    if (!renderer_.GetCostMap(map))
+    {
+        std::cout << "Error saving cost (none recorded since reset): " 
+                  << path 
+                  << std::endl;
+        return false;
+    }
+
+    snapshot_writer_.WriteData(path, map.Encode());
 
-    std::cout << "Saved state: " 
-              << path 
+    const CostMap::Summary summary = map.GetSummary();
+    std::cout << std::setprecision(1) << std::fixed
+              << "Cost of " << map.size().x << "x" << map.size().y 
+              << " pixels: " 
+              << static_cast<double>(summary.total) / 1e6 
+              << " M iterations, mean " << summary.mean
+              << ", max " << summary.maximum
+              << std::endl
+              << "  Top 1% of pixels: " 
+              << 100 * summary.top_1_percent_share << "%"
+              << ", top 10%: " 
+              << 100 * summary.top_10_percent_share << "%"
+              << ", free: " << 100 * summary.free_fraction << "%"
               << std::endl;
 
     return true;
 }
+void Application::PrintSnapshotReports()
+{
+    SnapshotWriter::Report report;
+    while (snapshot_writer_.PollReport(report))
+    {
+        std::cout << (report.is_successful ? "Saved: " : "Error saving: ")
+                  << report.path
+                  << std::endl;
+    }
+}
+void Application::PrintLatencyReport() const
+{
+    const struct
+    {
+        const char* name;
+        LatencyMonitor::Statistics statistics;
+    } 
+    latencies[] =
+    {
+        { "First preview", latency_monitor_.preview_statistics() },
+        { "Final image", latency_monitor_.final_statistics() }
+    };
+
+    std::cout << std::setprecision(1) << std::fixed
+              << "Input latency (ms, p50/p90/p99/max):"
+              << std::endl;
+    for (const auto& latency : latencies)
+    {
+        std::cout << "  " << latency.name << ": ";
+        if (latency.statistics.sample_count == 0)
+        {
+            std::cout << "no samples" << std::endl;
+            continue;
+        }
+        std::cout << latency.statistics.median << " / "
+                  << latency.statistics.percentile_90 << " / "
+                  << latency.statistics.percentile_99 << " / "
+                  << latency.statistics.maximum
+                  << " over " << latency.statistics.sample_count 
+                  << " inputs"
+                  << std::endl;
+    }
+}
+void Application::PrintRenderReport() const
+{
+    if (renderer_.computation_mode() != ComputationStage::Mode::Cpu)
+    {
+        return;
+    }
+    std::cout << std::setprecision(1) << std::fixed
+              << "Proven: " << 100 * renderer_.proven_fraction() 
+              << "% of area"
+              << std::endl;
+}
+void Application::PrintStartupReport()
+{
+    startup_stopwatch_.Stop();
+
+    const auto elapsed_microseconds = 
+        std::chrono::duration_cast<std::chrono::microseconds>
+    (
+        startup_stopwatch_.nanoseconds()
+    ).count();
+
+    const ProgramCache& cache = ProcessingStage::program_cache();
+    std::cout << std::setprecision(1) << std::fixed
+              << "Time to first frame: " 
+              << elapsed_microseconds / 1000.0 << " ms ("
+              << cache.hit_count() << " programs loaded from cache, "
+              << cache.miss_count() << " compiled)"
+              << std::endl;
+
+    is_startup_reported_ = true;
+}
 
 void Application::EnterMainLoop()
 {
@@ -305,22 +957,115 @@ void Application::EnterMainLoop()
 }
 void Application::HandleEvents()
 {
+    const Tracer::Zone zone("HandleEvents");
+
     stopwatch_.Stop();
 
-    glfwPollEvents();
-    if (UpdateCamera())
-    {
-        UpdateViewport();
-        renderer_.Reset();
+    WaitForEvents();
+    if (is_recording_input_) 
+    { 
+        input_log_.RecordFrame(stopwatch_.nanoseconds()); 
     }
+    Advance(stopwatch_.nanoseconds());
 
     stopwatch_.Start();
 }
+void Application::Advance(const Stopwatch::Duration& elapsed)
+{
+    {
+        const auto lock = compute_thread_.Acquire();
+
+        const bool is_camera_changed = UpdateCamera(elapsed);
+        latency_monitor_.RecordCameraUpdate(is_camera_changed);
+        if (is_camera_changed)
+        {
+            UpdateViewport();
+            renderer_.Reset();
+            needs_redraw_ = true;
+        }
+    }
+    compute_thread_.Notify();
+}
+void Application::WaitForEvents()
+{
+    double timeout;
+    {
+        const auto lock = compute_thread_.Acquire();
+
+        const bool is_rendering = 
+            (!is_paused_ || is_stepping_) && !renderer_.is_done();
+
+        if (needs_redraw_ || is_camera_moving() ||
+            (is_synchronous_ && is_rendering))
+        {
+            timeout = 0;
+        }
+        else if (compute_thread_.is_image_pending() ||
+                 pixel_reader_.is_busy())
+        {
+            timeout = PENDING_IMAGE_TIMEOUT_SECONDS;
+        }
+        else if (is_rendering)
+        {
+            timeout = PENDING_STEP_TIMEOUT_SECONDS;
+        }
+        else { timeout = -1; }
+
+        // The overlay keeps refreshing while it is shown.
+        if (renderer_.hud().is_visible() &&
+            (timeout < 0 || timeout > HUD_REFRESH_INTERVAL_SECONDS))
+        {
+            timeout = HUD_REFRESH_INTERVAL_SECONDS;
+        }
+    }
+
+    // Callbacks acquire the lock themselves, so the compute thread may
+    // keep working while we wait.
+    if (timeout == 0) { glfwPollEvents(); }
+    else if (timeout > 0) { glfwWaitEventsTimeout(timeout); }
+    else { glfwWaitEvents(); }
+}
 void Application::RenderFrame()
 {
-    glClear(GL_COLOR_BUFFER_BIT | 
-            GL_DEPTH_BUFFER_BIT);
+    pixel_reader_.Poll();
+    PrintSnapshotReports();
+
+    bool is_drawing;
+    {
+        const auto lock = compute_thread_.Acquire();
 
+        if (is_synchronous_) { StepSynchronous(); }
+        else { StepAsynchronous(); }
+        UpdateHud();
+
+        is_drawing = needs_redraw_;
+        if (is_drawing)
+        {
+            glClear(GL_COLOR_BUFFER_BIT | 
+                    GL_DEPTH_BUFFER_BIT);
+            oogl::Instrumentation::RecordCall("glClear");
+
+            renderer_.Render();
+            needs_redraw_ = false;
+        }
+    }
+    compute_thread_.Notify();
+
+    if (is_drawing) 
+    { 
+        {
+            const Tracer::Zone zone("glfwSwapBuffers");
+            glfwSwapBuffers(window_); 
+        }
+        latency_monitor_.RecordPresent(is_image_complete_);
+        is_image_complete_ = false;
+        ++ hud_frame_count_;
+        oogl::Instrumentation::EndFrame();
+        if (has_image_ && !is_startup_reported_) { PrintStartupReport(); }
+    }
+}
+void Application::StepSynchronous()
+{
     const bool is_rendering = !is_paused_ || is_stepping_;
 
     if (is_rendering && !renderer_.is_done())
@@ -329,22 +1074,108 @@ void Application::RenderFrame()
         if (renderer_.is_done())
         {
             renderer_.Flush();
+            is_image_complete_ = true;
             is_stepping_ = false;
+            needs_redraw_ = true;
+            has_image_ = true;
+
+            PrintRenderReport();
         }
     }
-    renderer_.Render();
+}
+void Application::StepAsynchronous()
+{
+    if (compute_thread_.PollImage())
+    {
+        if (renderer_.is_done()) 
+        { 
+            is_image_complete_ = true;
+            is_stepping_ = false; 
+            PrintRenderReport();
+        }
+        needs_redraw_ = true;
+        has_image_ = true;
+    }
+    compute_thread_.set_is_enabled(!is_paused_ || is_stepping_);
+}
+void Application::UpdateHud()
+{
+    if (!renderer_.hud().is_visible()) { return; }
+
+    const Stopwatch::TimePoint now = Stopwatch::Clock::now();
+    const double elapsed_seconds = 
+        std::chrono::duration<double>(now - hud_refresh_time_).count();
+    if (elapsed_seconds < HUD_REFRESH_INTERVAL_SECONDS) { return; }
+
+    const unsigned long long iteration_count = renderer_.iteration_count();
+    const double iterations_per_second = 
+        static_cast<double>(iteration_count - hud_iteration_count_) /
+        elapsed_seconds;
+
+    // Columns are of fixed width, so the overlay keeps its size.
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1)
+         << std::left << std::setw(12) << "FPS"
+         << std::right << std::setw(10) 
+         << hud_frame_count_ / elapsed_seconds << "\n";
+
+    std::vector<Renderer::StageTime> stage_times = renderer_.stage_times();
+    stage_times.push_back({ "HUD", renderer_.hud().timer().statistics() });
+    text << std::setprecision(3);
+    for (const Renderer::StageTime& time : stage_times)
+    {
+        text << std::left << std::setw(12) << time.stage
+             << std::right << std::setw(7) << time.statistics.average 
+             << " MS\n";
+    }
+
+    const double active_fraction = renderer_.active_fraction();
+    const double MEBIBYTE = 1024.0 * 1024.0;
+    text << std::setprecision(1)
+         << std::left << std::setw(12) << "Steps"
+         << std::right << std::setw(10)
+         << std::to_string(renderer_.step_count()) + "/" +
+            std::to_string(renderer_.max_step_count())
+         << "\n"
+         << std::left << std::setw(12) << "Iterations"
+         << std::right << std::setw(7) 
+         << iterations_per_second * 1e-6 << " M/S\n"
+         << std::left << std::setw(12) << "Active"
+         << std::right << std::setw(9);
+    if (active_fraction < 0) { text << "-" << " \n"; }
+    else { text << 100 * active_fraction << "%\n"; }
+    text << std::left << std::setw(12) << "Depth"
+         << std::right << std::setw(10) 
+         << std::log10(renderer_.viewport().size) << "\n"
+         << std::left << std::setw(12) << "Textures"
+         << std::right << std::setw(6)
+         << renderer_.texture_pool_statistics().allocated_bytes / MEBIBYTE
+         << " MIB";
 
-    glfwSwapBuffers(window_);
+    renderer_.hud().set_text(text.str());
+
+    hud_refresh_time_ = now;
+    hud_frame_count_ = 0;
+    hud_iteration_count_ = iteration_count;
+    needs_redraw_ = true;
 }
 
-bool Application::UpdateCamera()
+bool Application::is_camera_moving()
+{
+    return keyboard_controller_.horizontal_axis().signal() != 0 ||
+           keyboard_controller_.vertical_axis().signal() != 0 ||
+           keyboard_controller_.zoom_axis().signal() != 0;
+}
+bool Application::UpdateCamera(const Stopwatch::Duration& elapsed)
 {
+    const Tracer::Zone zone("UpdateCamera");
+
     bool camera_changed = false;
 
     const auto elapsed_microseconds = 
         std::chrono::duration_cast<std::chrono::microseconds>
     (
-        stopwatch_.nanoseconds()
+        elapsed
     ).count();
     const double elapsed_seconds = elapsed_microseconds / 1000000.0;
 
@@ -407,5 +1238,58 @@ void Application::PrintDebugInformation() const
               << std::endl
               << "Size: "
               << renderer_.viewport().size
+              << std::endl
+              << "Resolution: "
+              << renderer_.image_size().x << "x" << renderer_.image_size().y
+              << std::endl
+              << "Kernel: "
+              << renderer_.computation_variant_name()
               << std::endl;
+
+    const double MEBIBYTE = 1024.0 * 1024.0;
+    const TexturePool::Statistics textures = 
+        renderer_.texture_pool_statistics();
+    std::cout << std::setprecision(1)
+              << "Texture pool: "
+              << textures.allocated_bytes / MEBIBYTE << " MiB, "
+              << textures.idle_bytes / MEBIBYTE << " MiB idle, "
+              << textures.allocation_count << " allocations"
+              << std::endl;
+
+    // Counts include the computation thread's calls since the previous 
+    // frame.
+    const oogl::Instrumentation::CallCounts calls = 
+        oogl::Instrumentation::last_frame_call_counts();
+    std::cout << "GL calls last frame: "
+              << calls.issued << " issued, "
+              << calls.elided << " redundant binds elided"
+              << std::endl
+              << "Direct state access: "
+              << (oogl::StateCache::is_dsa_enabled() ? "on" : "off")
+              << std::endl;
+
+    std::cout << std::setprecision(3)
+              << "GPU time (ms, min/avg/p99):"
+              << std::endl;
+    for (const Renderer::StageTime& time : renderer_.stage_times())
+    {
+        std::cout << "  " << time.stage << ": ";
+        if (time.statistics.sample_count == 0) 
+        { 
+            std::cout << "no samples" << std::endl;
+            continue;
+        }
+        std::cout << time.statistics.minimum << " / "
+                  << time.statistics.average << " / "
+                  << time.statistics.percentile_99
+                  << " over " << time.statistics.sample_count 
+                  << " executions"
+                  << std::endl;
+    }
+    PrintLatencyReport();
+
+    if (oogl::Instrumentation::is_enabled())
+    {
+        oogl::Instrumentation::PrintSummary(std::cout);
+    }
 }
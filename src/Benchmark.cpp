@@ -0,0 +1,221 @@
+#include <mandelbrot/Benchmark.h>
+
+#include <algorithm>
+#include <experimental/filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#include <oogl/Fence.hpp>
+#include <oogl/info.hpp>
+
+#include <mandelbrot/Stopwatch.h>
+
+
+using namespace mandelbrot;
+
+
+const char* Benchmark::DEFAULT_STATE_DIRECTORY = "img/snapshots/states";
+const char* Benchmark::DEFAULT_PATH = "mandelbrot_benchmark.json";
+
+std::vector<std::string> Benchmark::FindStatePaths
+(
+    const std::string& directory
+)
+{
+    namespace filesystem = std::experimental::filesystem;
+
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (filesystem::directory_iterator entry(directory, error), end;
+         !error && entry != end;
+         entry.increment(error))
+    {
+        const filesystem::path& path = entry->path();
+        if (filesystem::is_regular_file(path) &&
+            path.extension() == ".txt")
+        {
+            paths.push_back(path.string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    return paths;
+}
+bool Benchmark::LoadScene(const std::string& path, Scene& scene)
+{
+    std::ifstream file(path);
+    file >> scene.position.x
+         >> scene.position.y
+         >> scene.size;
+    if (file.fail() || scene.size <= 0) { return false; }
+
+    namespace filesystem = std::experimental::filesystem;
+    scene.name = filesystem::path(path).stem().string();
+
+    return true;
+}
+
+Benchmark::Benchmark(Renderer& renderer)
+    : renderer_(&renderer) {}
+
+Benchmark::Result Benchmark::Run(const Scene& scene)
+{
+    const GLuint64 FENCE_TIMEOUT_NANOSECONDS = 1000000;
+
+    renderer_->set_viewport_position(scene.position);
+    renderer_->set_viewport_size(scene.size);
+    renderer_->Reset();
+
+    // Start from an idle GPU, with no times left over from earlier work.
+    glFinish();
+    renderer_->ClearStageTimes();
+
+    Result result;
+    result.scene = scene;
+
+    Stopwatch stopwatch;
+    stopwatch.Start();
+
+    while (!renderer_->is_done())
+    {
+        renderer_->RenderStep();
+        ++ result.step_count;
+
+        // Wait for each step, like the compute thread does, so that stage
+        // times are read back rather than skipped.
+        oogl::Fence step_fence;
+        while (!step_fence.Wait(FENCE_TIMEOUT_NANOSECONDS)) {}
+    }
+    renderer_->Flush();
+    renderer_->Render();
+    glFinish();
+
+    stopwatch.Stop();
+
+    renderer_->FinishStageTimes();
+    result.milliseconds = stopwatch.nanoseconds().count() * 1e-6;
+    result.stage_times = renderer_->stage_times();
+
+    return result;
+}
+
+bool Benchmark::Write
+(
+    const std::string& path,
+    const std::vector<Result>& results
+) const
+{
+    const int double_precision =
+        std::numeric_limits<double>::max_digits10;
+
+    const bool is_gpu =
+        renderer_->computation_mode() == ComputationStage::Mode::Gpu;
+    const bool is_double =
+        renderer_->precision() == ComputationStage::Precision::Double;
+
+    double total_milliseconds = 0;
+    for (const Result& result : results)
+    {
+        total_milliseconds += result.milliseconds;
+    }
+
+    std::ofstream file(path);
+    file << std::fixed << std::setprecision(4)
+         << "{" << std::endl
+         << "  \"system\": {" << std::endl
+         << "    \"gl_vendor\": "
+         << Quote(oogl::vendor_string()) << "," << std::endl
+         << "    \"gl_renderer\": "
+         << Quote(oogl::renderer_string()) << "," << std::endl
+         << "    \"gl_version\": "
+         << Quote(oogl::version_string()) << "," << std::endl
+         << "    \"glsl_version\": "
+         << Quote(oogl::shading_language_version_string()) << ","
+         << std::endl
+         << "    \"cpu_thread_count\": "
+         << std::thread::hardware_concurrency() << std::endl
+         << "  }," << std::endl
+         << "  \"settings\": {" << std::endl
+         << "    \"image_width\": "
+         << renderer_->image_size().x << "," << std::endl
+         << "    \"image_height\": "
+         << renderer_->image_size().y << "," << std::endl
+         << "    \"max_step_count\": "
+         << renderer_->max_step_count() << "," << std::endl
+         << "    \"iterations_per_step\": "
+         << renderer_->iterations_per_step() << "," << std::endl
+         << "    \"mode\": "
+         << (is_gpu ? "\"gpu\"" : "\"cpu\"") << "," << std::endl
+         << "    \"precision\": "
+         << (is_double ? "\"double\"" : "\"single\"") << "," << std::endl
+         << "    \"variant\": "
+         << Quote(renderer_->computation_variant_name()) << ","
+         << std::endl
+         << "    \"is_symmetric\": "
+         << (renderer_->is_symmetric() ? "true" : "false") << std::endl
+         << "  }," << std::endl
+         << "  \"total_ms\": " << total_milliseconds << "," << std::endl
+         << "  \"scenes\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+
+        file << (i == 0 ? "" : ",") << std::endl
+             << "    {" << std::endl
+             << "      \"name\": " << Quote(result.scene.name) << ","
+             << std::endl
+             << std::setprecision(double_precision)
+             << "      \"x\": " << result.scene.position.x << ","
+             << std::endl
+             << "      \"y\": " << result.scene.position.y << ","
+             << std::endl
+             << "      \"size\": " << result.scene.size << "," << std::endl
+             << std::setprecision(4)
+             << "      \"step_count\": " << result.step_count << ","
+             << std::endl
+             << "      \"total_ms\": " << result.milliseconds << ","
+             << std::endl
+             << "      \"stages\": [";
+
+        for (std::size_t j = 0; j < result.stage_times.size(); ++j)
+        {
+            const Renderer::StageTime& time = result.stage_times[j];
+
+            file << (j == 0 ? "" : ",") << std::endl
+                 << "        { "
+                 << "\"stage\": " << Quote(time.stage) << ", "
+                 << "\"samples\": " << time.statistics.sample_count << ", "
+                 << "\"min_ms\": " << time.statistics.minimum << ", "
+                 << "\"avg_ms\": " << time.statistics.average << ", "
+                 << "\"p99_ms\": " << time.statistics.percentile_99
+                 << " }";
+        }
+        file << std::endl << "      ]" << std::endl
+             << "    }";
+    }
+    file << std::endl << "  ]" << std::endl
+         << "}" << std::endl;
+
+    return !file.fail();
+}
+
+std::string Benchmark::Quote(const std::string& text)
+{
+    std::ostringstream quoted;
+    quoted << '"';
+    for (const char character : text)
+    {
+        if (character == '"' || character == '\\') { quoted << '\\'; }
+        if (static_cast<unsigned char>(character) >= 0x20)
+        {
+            quoted << character;
+        }
+    }
+    quoted << '"';
+
+    return quoted.str();
+}
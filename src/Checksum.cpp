@@ -0,0 +1,90 @@
+#include <mandelbrot/Checksum.h>
+
+#include <algorithm>
+#include <array>
+
+
+using namespace mandelbrot;
+
+
+namespace
+{
+    std::array<std::uint32_t, 256> BuildCrc32Table()
+    {
+        std::array<std::uint32_t, 256> table;
+        for (std::uint32_t i = 0; i < 256; ++i)
+        {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return table;
+    }
+}
+
+void Crc32::Update(const unsigned char* data, const std::size_t size)
+{
+    static const std::array<std::uint32_t, 256> table = BuildCrc32Table();
+
+    std::uint32_t c = state_;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        c = table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    }
+    state_ = c;
+}
+std::uint32_t Crc32::value() const
+{
+    return state_ ^ 0xFFFFFFFF;
+}
+
+const std::uint32_t Adler32::MODULUS = 65521;
+// Largest n such that 255n(n+1)/2 + (n+1)(MODULUS-1) fits 32 bits.
+const std::size_t Adler32::MAX_BLOCK_SIZE = 5552;
+
+std::uint32_t Adler32::Combine
+(
+    const std::uint32_t first,
+    const std::uint32_t second,
+    const std::size_t second_size
+)
+{
+    // a = 1 + sum(bytes), b = sum of running a's; shifting the first 
+    // piece by n bytes adds n * (a1 - 1) to b.
+    const std::uint32_t n = static_cast<std::uint32_t>(second_size % MODULUS);
+    const std::uint32_t a1 = first & 0xFFFF;
+    const std::uint32_t b1 = first >> 16;
+    const std::uint32_t a2 = second & 0xFFFF;
+    const std::uint32_t b2 = second >> 16;
+
+    const std::uint32_t a = (a1 + a2 + MODULUS - 1) % MODULUS;
+    const std::uint32_t b = 
+        (b1 + b2 + (n * a1) % MODULUS + MODULUS - n) % MODULUS;
+
+    return (b << 16) | a;
+}
+
+void Adler32::Update(const unsigned char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        const std::size_t block_size = std::min(size, MAX_BLOCK_SIZE);
+        for (std::size_t i = 0; i < block_size; ++i)
+        {
+            a_ += data[i];
+            b_ += a_;
+        }
+        a_ %= MODULUS;
+        b_ %= MODULUS;
+
+        data += block_size;
+        size -= block_size;
+    }
+}
+std::uint32_t Adler32::value() const
+{
+    return (b_ << 16) | a_;
+}
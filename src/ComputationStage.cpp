@@ -1,5 +1,9 @@
 #include <mandelbrot\ComputationStage.h>
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+
 
 using namespace mandelbrot;
 using namespace oogl;
@@ -12,6 +16,9 @@ const char* ComputationStage::FRAGMENT_SHADER_SOURCE_PATH =
 
 const GLint ComputationStage::VALUE_TEXTURE_UNIT_INDEX = 0;
 const GLint ComputationStage::LIFETIME_TEXTURE_UNIT_INDEX = 1;
+const GLint ComputationStage::COST_TEXTURE_UNIT_INDEX = 2;
+
+const double ComputationStage::ACTIVE_PIXEL_COUNT_INTERVAL_SECONDS = 0.1;
 
 ComputationStage::ComputationStage()
     : ProcessingStage
@@ -22,6 +29,12 @@ ComputationStage::ComputationStage()
 
 bool ComputationStage::Initialize()
 {
+    if (!symmetry_stage_.Initialize())
+    {
+        status_message_ = std::string("Symmetry stage:\n") +
+                          symmetry_stage_.status_message();
+        return false;
+    }
     return ProcessingStage::Initialize() &&
            InitializeTextures() &&
            InitializeBuffers() && 
@@ -29,64 +42,66 @@ bool ComputationStage::Initialize()
 }
 bool ComputationStage::InitializeTextures()
 {
-    return InitializeTexture
-    (
-        GL_RG32F, GL_RG, GL_FLOAT, 
-        in_value_texture_
-    ) &&
-    InitializeTexture
-    (
-        GL_R32I, GL_RED_INTEGER, GL_INT, 
-        in_lifetime_texture_
-    ) &&
-    InitializeTexture(
-        GL_RG32F, GL_RG, GL_FLOAT,
-        out_value_texture_
-    ) &&
-    InitializeTexture
-    (
-        GL_R32I, GL_RED_INTEGER, GL_INT, 
-        out_lifetime_texture_
-    );
+    // Room for the previous size's set, to toggle back without allocating.
+    texture_pool_.set_capacity(8);
+
+    AcquireTextures();
+    return true;
+}
+void ComputationStage::AcquireTextures()
+{
+    AcquireTexture(GL_RG32F, in_value_texture_);
+    AcquireTexture(GL_RG32I, in_lifetime_texture_);
+    AcquireTexture(GL_RG32F, out_value_texture_);
+    AcquireTexture(GL_RG32I, out_lifetime_texture_);
+    AcquireTexture(GL_R32F, distance_texture_);
+    AcquireTexture(GL_DEPTH_COMPONENT24, depth_texture_);
+
+    if (records_cost_)
+    {
+        AcquireTexture(GL_R32UI, in_cost_texture_);
+        AcquireTexture(GL_R32UI, out_cost_texture_);
+    }
+    else { ReleaseCostTextures(); }
 }
-bool ComputationStage::InitializeTexture
+void ComputationStage::AcquireTexture
 (
     const GLint internal_format,
-    const GLenum data_format,
-    const GLenum data_type,
     std::unique_ptr<Texture>& texture
 )
 {
-    texture = std::make_unique<Texture>
-    (
-        Texture::Binding::Texture2D,
-        internal_format,
-        resolution_, resolution_
-    );
-    
-    texture->Bind();
-    texture->UploadData(0, data_format, data_type, nullptr);
+    if (texture == nullptr)
+    {
+        texture = texture_pool_.Acquire
+        (
+            Texture::Binding::Texture2D,
+            internal_format,
+            size_.x, size_.y
+        );
+    }
+    else if (!texture_pool_.Resize(texture, size_.x, size_.y)) { return; }
 
     texture->set_filters(Texture::Filter::Nearest);
+}
+void ComputationStage::ReleaseCostTextures()
+{
+    if (out_cost_texture_ == nullptr) { return; }
 
-    return true;
+    if (frame_buffer_ != nullptr) 
+    { 
+        frame_buffer_->Detach(GL_COLOR_ATTACHMENT2); 
+    }
+    texture_pool_.Release(std::move(in_cost_texture_));
+    texture_pool_.Release(std::move(out_cost_texture_));
 }
 bool ComputationStage::InitializeBuffers()
 {
     frame_buffer_ = std::make_unique<FrameBuffer>();
     frame_buffer_->Bind();
 
-    depth_render_buffer_ = std::make_unique<RenderBuffer>();
-    depth_render_buffer_->Bind();
-    RenderBuffer::DefineStorage
-    (
-        GL_DEPTH_COMPONENT, 
-        resolution_, resolution_
-    );
-
-    frame_buffer_->AttachRenderBuffer
+    frame_buffer_->AttachTexture
     (
-        *depth_render_buffer_, 
+        *depth_texture_, 
         GL_DEPTH_ATTACHMENT
     );
     frame_buffer_->AttachTexture
@@ -115,7 +130,7 @@ bool ComputationStage::InitializeUniforms()
     uniform_viewport_bottom_left_ = 
         program_->GetVectorUniform<GLdouble, 2>("viewport_bottom_left");
     uniform_viewport_size_ =
-        program_->GetVectorUniform<GLdouble, 1>("viewport_size");
+        program_->GetVectorUniform<GLdouble, 2>("viewport_size");
 
     uniform_value_texture_ =
         program_->GetVectorUniform<GLint, 1>("value_texture");
@@ -125,13 +140,15 @@ bool ComputationStage::InitializeUniforms()
         program_->GetVectorUniform<GLint, 1>("lifetime_texture");
     uniform_lifetime_texture_.set(LIFETIME_TEXTURE_UNIT_INDEX);
 
-    uniform_iterations_per_step_ = program_->GetVectorUniform<GLint, 1>("dt");
+    // Only in variants recording cost.
+    uniform_cost_texture_ = 
+        program_->GetVectorUniform<GLint, 1>("cost_texture");
+    uniform_cost_texture_.set(COST_TEXTURE_UNIT_INDEX);
 
     return uniform_viewport_bottom_left_.is_valid() &&
            uniform_viewport_size_.is_valid() &&
            uniform_value_texture_.is_valid() &&
-           uniform_lifetime_texture_.is_valid() &&
-           uniform_iterations_per_step_.is_valid();
+           uniform_lifetime_texture_.is_valid();
 }
 
 void ComputationStage::Reset()
@@ -143,75 +160,164 @@ void ComputationStage::Reset()
         GL_RG, GL_FLOAT, 
         null_value_data
     );
-    GLint null_lifetime_data[1] { 0 };
+    GLint null_lifetime_data[2] { 0, 0 };
     out_lifetime_texture_->ClearData
     (
         0, 
-        GL_RED_INTEGER, GL_INT, 
+        GL_RG_INTEGER, GL_INT, 
         null_lifetime_data
     );
+    GLfloat null_distance_data[1] { 0 };
+    distance_texture_->ClearData
+    (
+        0, 
+        GL_RED, GL_FLOAT, 
+        null_distance_data
+    );
+
+    if (out_cost_texture_ != nullptr)
+    {
+        // Both, since rows skipped by symmetry are never written.
+        GLuint null_cost_data[1] { 0 };
+        in_cost_texture_->ClearData
+        (
+            0, 
+            GL_RED_INTEGER, GL_UNSIGNED_INT, 
+            null_cost_data
+        );
+        out_cost_texture_->ClearData
+        (
+            0, 
+            GL_RED_INTEGER, GL_UNSIGNED_INT, 
+            null_cost_data
+        );
+    }
+
+    cpu_computation_.Reset();
+    cpu_results_need_upload_ = false;
+    proven_fraction_ = 0;
 }
 void ComputationStage::Execute()
 {
+    if (mode_ == Mode::Cpu)
+    {
+        PrepareCpuStep();
+        ExecuteCpuStep();
+        FinishCpuStep();
+        return;
+    }
+
+    UpdateProgram();
+
     program_->Use();
     frame_buffer_->Bind();
 
     UpdateUniforms();
-    UpdateResolution();
+    UpdateSize();
     SwapBuffers();
     ComputeStep();
+
+    if (counts_active_pixels_) { CountActivePixels(); }
+}
+
+Shader::Definitions ComputationStage::GetDefinitions() const
+{
+    Shader::Definitions definitions;
+    definitions["DT"] = std::to_string(iterations_per_step_);
+    definitions["ESCAPE_RADIUS"] = std::to_string(escape_radius_);
+    if (precision_ == Precision::Single)
+    {
+        definitions["SINGLE_PRECISION"] = "";
+    }
+    if (detects_interior_)
+    {
+        definitions["DETECT_CYCLES"] = "";
+    }
+    if (records_cost_)
+    {
+        definitions["RECORD_COST"] = "";
+    }
+    return definitions;
+}
+void ComputationStage::UpdateProgram()
+{
+    if (!variant_needs_update_) { return; }
+
+    const Program* previous_program = program_;
+    if (SelectProgram(GetDefinitions()) && program_ != previous_program)
+    {
+        // Uniform locations and values belong to the program.
+        InitializeUniforms();
+        viewport_position_needs_update_ = true;
+        viewport_size_needs_update_ = true;
+    }
+    variant_needs_update_ = false;
 }
 
 void ComputationStage::UpdateUniforms()
 {
-    if (viewport_position_needs_update_)
+    if (viewport_position_needs_update_ || viewport_size_needs_update_)
     {
-        const Vector2d bottom_left =
-            viewport_.position - 0.5 * viewport_.size;
+        const Vector2d extent = viewport_.size * Proportions(size_);
+        Vector2d bottom_left = viewport_.position - 0.5 * extent;
+
+        UpdateMirroredRows(bottom_left);
+        computed_viewport_ = Box2d(bottom_left + 0.5 * extent, viewport_.size);
+
         uniform_viewport_bottom_left_.set
         (
             bottom_left.x, 
             bottom_left.y
         );
+        uniform_viewport_size_.set(extent.x, extent.y);
+        
         viewport_position_needs_update_ = false;
-    }
-    if (viewport_size_needs_update_)
-    {
-        uniform_viewport_size_.set(viewport_.size);
         viewport_size_needs_update_ = false;
     }
-    if (iterations_per_step_needs_update_)
-    {
-        uniform_iterations_per_step_.set(iterations_per_step_);
-        iterations_per_step_needs_update_ = false;
-    }
 }
-void ComputationStage::UpdateResolution()
+void ComputationStage::UpdateMirroredRows(Vector2d& bottom_left)
 {
-    if (!resolution_needs_update_) { return; }
+    mirrored_rows_begin_ = mirrored_rows_end_ = 0;
+    if (!is_symmetric_) { return; }
 
-    in_value_texture_->Bind();
-    in_value_texture_->Resize(resolution_, resolution_);
-    
-    in_lifetime_texture_->Bind();
-    in_lifetime_texture_->Resize(resolution_, resolution_);
-    
-    out_value_texture_->Bind();
-    out_value_texture_->Resize(resolution_, resolution_);
-    
-    out_lifetime_texture_->Bind();
-    out_lifetime_texture_->Resize(resolution_, resolution_);
+    const double pixel_size = viewport_.size / Max(size_);
+    const double height = size_.y;
 
-    depth_render_buffer_->Bind();
-    RenderBuffer::DefineStorage
+    // Twice the real axis' distance from the bottom edge, in pixels.
+    const double axis = std::round(-2 * bottom_left.y / pixel_size);
+    if (axis <= 0 || axis >= 2 * height) { return; }
+
+    // Rows below the axis whose counterparts above it are in view.
+    const GLint axis_pixels = static_cast<GLint>(axis);
+    const GLint begin = std::max(axis_pixels - static_cast<GLint>(size_.y), 0);
+    const GLint end = std::min(axis_pixels / 2, static_cast<GLint>(size_.y));
+    if (end <= begin) { return; }
+
+    // Shift by under half a pixel so the axis falls on a pixel edge or
+    // center, making mirrored pixels exact conjugates of computed ones.
+    bottom_left.y = -0.5 * axis * pixel_size;
+
+    mirrored_rows_begin_ = begin;
+    mirrored_rows_end_ = end;
+    mirror_axis_ = axis_pixels;
+}
+void ComputationStage::UpdateSize()
+{
+    if (!size_needs_update_) { return; }
+
+    AcquireTextures();
+
+    // Color attachments follow on the next swap.
+    frame_buffer_->Bind();
+    frame_buffer_->AttachTexture
     (
-        GL_DEPTH_COMPONENT, 
-        resolution_, resolution_
+        *depth_texture_, 
+        GL_DEPTH_ATTACHMENT
     );
 
     Reset();
 
-    resolution_needs_update_ = false;
+    size_needs_update_ = false;
 }
 void ComputationStage::SwapBuffers()
 {
@@ -228,38 +334,235 @@ void ComputationStage::SwapBuffers()
         *out_lifetime_texture_, 
         GL_COLOR_ATTACHMENT1
     );
+
+    if (!records_cost_) { return; }
+
+    std::swap(in_cost_texture_, out_cost_texture_);
+    frame_buffer_->AttachTexture
+    (
+        *out_cost_texture_, 
+        GL_COLOR_ATTACHMENT2
+    );
 }
 void ComputationStage::ComputeStep()
 {
-    GLenum draw_buffers[2] = 
+    GLenum draw_buffers[3] = 
     {
         GL_COLOR_ATTACHMENT0, 
-        GL_COLOR_ATTACHMENT1
+        GL_COLOR_ATTACHMENT1,
+        GL_COLOR_ATTACHMENT2
     };
-    glDrawBuffers(2, draw_buffers);
+    glDrawBuffers(records_cost_ ? 3 : 2, draw_buffers);
 
     in_value_texture_->BindToUnit(VALUE_TEXTURE_UNIT_INDEX);
     in_lifetime_texture_->BindToUnit(LIFETIME_TEXTURE_UNIT_INDEX);
+    if (records_cost_) 
+    { 
+        in_cost_texture_->BindToUnit(COST_TEXTURE_UNIT_INDEX); 
+    }
+
+    glViewport(0, 0, size_.x, size_.y);
 
-    glViewport(0, 0, resolution_, resolution_);
+    DrawComputedRows();
+}
+void ComputationStage::DrawComputedRows()
+{
+    if (mirrored_rows_end_ <= mirrored_rows_begin_)
+    {
+        DrawScreenQuad();
+        return;
+    }
 
+    // Skip mirrored rows, they are filled in by Mirror().
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, size_.x, mirrored_rows_begin_);
+    DrawScreenQuad();
+    glScissor
+    (
+        0, mirrored_rows_end_, 
+        size_.x, size_.y - mirrored_rows_end_
+    );
     DrawScreenQuad();
+    glDisable(GL_SCISSOR_TEST);
 }
+void ComputationStage::CountActivePixels()
+{
+    if (is_active_pixel_query_pending_)
+    {
+        if (!active_pixel_query_->is_result_available()) { return; }
+
+        active_fraction_ = 
+            static_cast<double>(active_pixel_query_->result()) /
+            counted_pixel_count_;
+        is_active_pixel_query_pending_ = false;
+    }
+
+    const Stopwatch::TimePoint now = Stopwatch::Clock::now();
+    const double elapsed_seconds = 
+        std::chrono::duration<double>(now - active_pixel_count_time_)
+        .count();
+    if (elapsed_seconds < ACTIVE_PIXEL_COUNT_INTERVAL_SECONDS) { return; }
+
+    Shader::Definitions definitions = GetDefinitions();
+    definitions["COUNT_ACTIVE"] = "";
+    if (!SelectProgram(definitions))
+    {
+        counts_active_pixels_ = false;
+        return;
+    }
+    program_->Use();
+    program_->GetVectorUniform<GLint, 1>("value_texture")
+        .set(VALUE_TEXTURE_UNIT_INDEX);
+    program_->GetVectorUniform<GLint, 1>("lifetime_texture")
+        .set(LIFETIME_TEXTURE_UNIT_INDEX);
+
+    if (active_pixel_query_ == nullptr)
+    {
+        active_pixel_query_ = std::make_unique<Query>
+        (
+            Query::Target::SamplesPassed
+        );
+    }
 
-unsigned int ComputationStage::resolution() const
+    // Reads the step's input textures, which are still bound, so the 
+    // count is of the pixels the step iterated.
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    active_pixel_query_->Begin();
+    DrawComputedRows();
+    active_pixel_query_->End();
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    is_active_pixel_query_pending_ = true;
+    active_pixel_count_time_ = now;
+    counted_pixel_count_ = 
+        static_cast<double>(size_.x) * 
+        (size_.y - (mirrored_rows_end_ - mirrored_rows_begin_));
+
+    // Back to the kernel, which the count's variant was built from.
+    SelectProgram(GetDefinitions());
+}
+void ComputationStage::Mirror()
+{
+    if (mirrored_rows_end_ <= mirrored_rows_begin_) { return; }
+
+    symmetry_stage_.set_source_textures
+    (
+        *out_value_texture_, 
+        *out_lifetime_texture_
+    );
+    symmetry_stage_.set_target_textures
+    (
+        *in_value_texture_, 
+        *in_lifetime_texture_
+    );
+    symmetry_stage_.set_mirrored_rows
+    (
+        mirrored_rows_begin_, 
+        mirrored_rows_end_, 
+        mirror_axis_
+    );
+    symmetry_stage_.Execute();
+
+    // The next step computes from the mirrored copy. Costs stay, as 
+    // mirrored rows cost nothing.
+    std::swap(in_value_texture_, out_value_texture_);
+    std::swap(in_lifetime_texture_, out_lifetime_texture_);
+}
+
+void ComputationStage::PrepareCpuStep()
+{
+    UpdateSize();
+
+    cpu_computation_.set_size(size_);
+    cpu_computation_.set_escape_radius(escape_radius_);
+    cpu_computation_.set_is_proven_only(is_proven_only_);
+    if (viewport_position_needs_update_ || viewport_size_needs_update_)
+    {
+        const Vector2d extent = viewport_.size * Proportions(size_);
+        cpu_computation_.set_viewport
+        (
+            viewport_.position - 0.5 * extent,
+            viewport_.size / Max(size_)
+        );
+        computed_viewport_ = viewport_;
+        viewport_position_needs_update_ = false;
+        viewport_size_needs_update_ = false;
+    }
+    cpu_iteration_count_ = iterations_per_step_;
+}
+void ComputationStage::ExecuteCpuStep()
+{
+    cpu_computation_.Execute(cpu_iteration_count_);
+}
+void ComputationStage::FinishCpuStep()
+{
+    const Vector2u& size = cpu_computation_.size();
+    proven_fraction_ = 
+        static_cast<double>(cpu_computation_.proven_count()) / 
+        (static_cast<double>(size.x) * size.y);
+
+    // Only images that get colored need their results on the GPU.
+    cpu_results_need_upload_ = true;
+}
+void ComputationStage::UploadCpuResults()
+{
+    if (!cpu_results_need_upload_) { return; }
+
+    out_value_texture_->UploadData
+    (
+        0, 
+        GL_RG, GL_FLOAT, 
+        cpu_computation_.values()
+    );
+    out_lifetime_texture_->UploadData
+    (
+        0, 
+        GL_RG_INTEGER, GL_INT, 
+        cpu_computation_.lifetimes()
+    );
+    distance_texture_->UploadData
+    (
+        0, 
+        GL_RED, GL_FLOAT, 
+        cpu_computation_.distances()
+    );
+    if (records_cost_)
+    {
+        out_cost_texture_->UploadData
+        (
+            0, 
+            GL_RED_INTEGER, GL_UNSIGNED_INT, 
+            cpu_computation_.costs()
+        );
+    }
+    cpu_results_need_upload_ = false;
+}
+
+const Vector2u& ComputationStage::size() const
 { 
-    return resolution_;
+    return size_;
 }
-void ComputationStage::set_resolution_power(const unsigned int value)
+void ComputationStage::set_size(const Vector2u& value)
 {
-    resolution_ = static_cast<unsigned int>(std::pow(2, value));
-    resolution_needs_update_ = true;
+    const Vector2u size(std::max(value.x, 1U), std::max(value.y, 1U));
+    if (size.x == size_.x && size.y == size_.y) { return; }
+
+    size_ = size;
+    size_needs_update_ = true;
+
+    // The viewport's extent follows the output's proportions.
+    viewport_position_needs_update_ = true;
+    viewport_size_needs_update_ = true;
 }
 
 const Box2d& ComputationStage::viewport() const
 { 
     return viewport_; 
 }
+const Box2d& ComputationStage::computed_viewport() const
+{
+    return computed_viewport_;
+}
 void ComputationStage::set_viewport_position(const Vector2d& value)
 {
     viewport_.position = value;
@@ -277,8 +580,116 @@ unsigned int ComputationStage::iterations_per_step() const
 }
 void ComputationStage::set_iterations_per_step(const unsigned int value)
 {
-    iterations_per_step_ = std::max(value, 1U);
-    iterations_per_step_needs_update_ = true;
+    const unsigned int iterations_per_step = std::max(value, 1U);
+    if (iterations_per_step == iterations_per_step_) { return; }
+
+    iterations_per_step_ = iterations_per_step;
+    variant_needs_update_ = true;
+}
+
+ComputationStage::Precision ComputationStage::precision() const
+{
+    return precision_;
+}
+void ComputationStage::set_precision(const Precision value)
+{
+    if (value == precision_) { return; }
+
+    precision_ = value;
+    variant_needs_update_ = true;
+}
+
+double ComputationStage::escape_radius() const
+{
+    return escape_radius_;
+}
+void ComputationStage::set_escape_radius(const double value)
+{
+    const double escape_radius = std::max(value, 2.0);
+    if (escape_radius == escape_radius_) { return; }
+
+    escape_radius_ = escape_radius;
+    variant_needs_update_ = true;
+}
+
+bool ComputationStage::detects_interior() const
+{
+    return detects_interior_;
+}
+void ComputationStage::set_detects_interior(const bool value)
+{
+    if (value == detects_interior_) { return; }
+
+    detects_interior_ = value;
+    variant_needs_update_ = true;
+}
+
+bool ComputationStage::is_symmetric() const
+{
+    return is_symmetric_;
+}
+void ComputationStage::set_is_symmetric(const bool value)
+{
+    if (value == is_symmetric_) { return; }
+
+    is_symmetric_ = value;
+    viewport_position_needs_update_ = true;
+}
+
+ComputationStage::Mode ComputationStage::mode() const
+{
+    return mode_;
+}
+void ComputationStage::set_mode(const Mode value)
+{
+    if (value == mode_) { return; }
+
+    mode_ = value;
+
+    // Each mode tracks viewport changes on its own.
+    mirrored_rows_begin_ = mirrored_rows_end_ = 0;
+    viewport_position_needs_update_ = true;
+    viewport_size_needs_update_ = true;
+}
+
+bool ComputationStage::is_proven_only() const
+{
+    return is_proven_only_;
+}
+void ComputationStage::set_is_proven_only(const bool value)
+{
+    is_proven_only_ = value;
+}
+double ComputationStage::proven_fraction() const
+{
+    return proven_fraction_;
+}
+
+bool ComputationStage::counts_active_pixels() const
+{
+    return counts_active_pixels_;
+}
+void ComputationStage::set_counts_active_pixels(const bool value)
+{
+    counts_active_pixels_ = value;
+}
+double ComputationStage::active_fraction() const
+{
+    return mode_ == Mode::Gpu ? active_fraction_ : -1;
+}
+
+bool ComputationStage::records_cost() const
+{
+    return records_cost_;
+}
+void ComputationStage::set_records_cost(const bool value)
+{
+    if (value == records_cost_) { return; }
+
+    records_cost_ = value;
+    variant_needs_update_ = true;
+    // Acquires or releases the cost textures, then resets.
+    size_needs_update_ = true;
 }
 
 Texture& ComputationStage::value_texture()
@@ -289,3 +700,11 @@ Texture& ComputationStage::lifetime_texture()
 {
     return *out_lifetime_texture_;
 }
+Texture& ComputationStage::distance_texture()
+{
+    return *distance_texture_;
+}
+Texture* ComputationStage::cost_texture()
+{
+    return records_cost_ ? out_cost_texture_.get() : nullptr;
+}
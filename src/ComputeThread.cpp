@@ -0,0 +1,191 @@
+#include <mandelbrot/ComputeThread.h>
+
+#include <oogl/StateCache.hpp>
+
+#include <mandelbrot/Tracer.h>
+
+
+using namespace mandelbrot;
+
+
+const GLuint64 ComputeThread::FENCE_TIMEOUT_NANOSECONDS = 1000000;
+
+ComputeThread::ComputeThread(Renderer& renderer)
+    : renderer_(&renderer) {}
+ComputeThread::~ComputeThread()
+{
+    Stop();
+}
+
+bool ComputeThread::Start(GLFWwindow* shared_window)
+{
+    if (is_running_) { return true; }
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    context_ = glfwCreateWindow(1, 1, "", nullptr, shared_window);
+    glfwDefaultWindowHints();
+
+    if (context_ == nullptr)
+    {
+        status_message_ = "Could not create computation context";
+        return false;
+    }
+
+    // Container objects (frame buffers, vertex arrays) are not shared
+    // between contexts, so the computation stages are initialized in the
+    // context they will be used from. The binding cache is per thread, 
+    // so it is invalidated whenever the thread switches contexts.
+    glfwMakeContextCurrent(context_);
+    oogl::StateCache::current().Invalidate();
+    const bool success = renderer_->InitializeComputation();
+    glfwMakeContextCurrent(shared_window);
+    oogl::StateCache::current().Invalidate();
+
+    if (!success)
+    {
+        status_message_ = renderer_->status_message();
+        glfwDestroyWindow(context_);
+        context_ = nullptr;
+        return false;
+    }
+
+    is_running_ = true;
+    thread_ = std::thread(&ComputeThread::Run, this);
+
+    return true;
+}
+void ComputeThread::Stop()
+{
+    {
+        Lock lock(mutex_);
+        is_running_ = false;
+    }
+    condition_.notify_one();
+
+    if (thread_.joinable()) { thread_.join(); }
+
+    image_fence_.reset();
+    cache_fence_.reset();
+    if (context_ != nullptr)
+    {
+        glfwDestroyWindow(context_);
+        context_ = nullptr;
+    }
+}
+
+ComputeThread::Lock ComputeThread::Acquire()
+{
+    return Lock(mutex_);
+}
+void ComputeThread::Notify()
+{
+    condition_.notify_one();
+}
+
+bool ComputeThread::PollImage()
+{
+    if (!is_image_pending_) { return false; }
+
+    if (!image_fence_->is_signaled()) { return false; }
+    image_fence_.reset();
+
+    renderer_->UpdateCache();
+    is_image_pending_ = false;
+
+    // Contexts are not ordered with respect to each other, so the worker
+    // waits for the copy before writing to the copied textures again. The
+    // fence must be flushed for another context to wait on it.
+    cache_fence_ = std::make_unique<oogl::Fence>();
+    glFlush();
+
+    condition_.notify_one();
+
+    return true;
+}
+
+void ComputeThread::Run()
+{
+    glfwMakeContextCurrent(context_);
+    Tracer::SetThreadName("Computation");
+
+    Lock lock(mutex_);
+    while (is_running_)
+    {
+        condition_.wait(lock, [this]
+        {
+            return !is_running_ || has_work();
+        });
+        if (!is_running_) { break; }
+
+        if (cache_fence_ != nullptr)
+        {
+            cache_fence_->WaitOnServer();
+            cache_fence_.reset();
+        }
+
+        // CPU mode steps evaluate on the host, touching only their own
+        // buffers, so the display thread may use the renderer meanwhile.
+        // Steps it resets in the process are discarded.
+        bool is_step_counted;
+        {
+            const Tracer::Zone zone("RenderStep", true);
+
+            if (renderer_->BeginStep())
+            {
+                lock.unlock();
+                renderer_->ExecuteCpuStep();
+                lock.lock();
+            }
+            is_step_counted = renderer_->EndStep();
+        }
+        if (!is_step_counted) { continue; }
+
+        const bool is_image_done = renderer_->is_done();
+        if (is_image_done)
+        {
+            renderer_->Color();
+            image_fence_ = std::make_unique<oogl::Fence>();
+            is_image_pending_ = true;
+        }
+        oogl::Fence step_fence;
+
+        // Wait for the step outside the lock, so the display thread may
+        // modify the renderer in the meanwhile, and so that we never queue
+        // up more than one step ahead of the GPU.
+        lock.unlock();
+        while (!step_fence.Wait(FENCE_TIMEOUT_NANOSECONDS)) {}
+
+        // Wake the display thread in case it is idling on events.
+        if (is_image_done) { glfwPostEmptyEvent(); }
+
+        lock.lock();
+    }
+
+    Tracer::ReleaseThread();
+    glfwMakeContextCurrent(nullptr);
+}
+bool ComputeThread::has_work() const
+{
+    return is_enabled_ &&
+           !is_image_pending_ &&
+           !renderer_->is_done();
+}
+
+bool ComputeThread::is_running() const
+{
+    return is_running_;
+}
+bool ComputeThread::is_image_pending() const
+{
+    return is_image_pending_;
+}
+
+void ComputeThread::set_is_enabled(const bool value)
+{
+    is_enabled_ = value;
+}
+
+const char* ComputeThread::status_message() const
+{
+    return status_message_.c_str();
+}
@@ -0,0 +1,119 @@
+#include <mandelbrot/CostMap.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+
+
+using namespace mandelbrot;
+
+
+CostMap::CostMap(const Vector2u& size)
+{
+    Resize(size);
+}
+
+void CostMap::Resize(const Vector2u& size)
+{
+    size_ = size;
+    costs_.assign(static_cast<std::size_t>(size.x) * size.y, 0);
+}
+
+CostMap::Summary CostMap::GetSummary() const
+{
+    Summary summary;
+    if (costs_.empty()) { return summary; }
+
+    summary.total = std::accumulate
+    (
+        costs_.begin(), costs_.end(),
+        0ULL
+    );
+    summary.maximum = *std::max_element(costs_.begin(), costs_.end());
+    summary.mean =
+        static_cast<double>(summary.total) /
+        static_cast<double>(costs_.size());
+
+    summary.top_1_percent_share = GetTopShare(0.01);
+    summary.top_10_percent_share = GetTopShare(0.1);
+
+    const auto free_count = std::count
+    (
+        costs_.begin(), costs_.end(),
+        0U
+    );
+    summary.free_fraction =
+        static_cast<double>(free_count) /
+        static_cast<double>(costs_.size());
+
+    return summary;
+}
+double CostMap::GetTopShare(const double fraction) const
+{
+    const unsigned long long total = std::accumulate
+    (
+        costs_.begin(), costs_.end(),
+        0ULL
+    );
+    if (total == 0) { return 0; }
+
+    const std::size_t count = std::min
+    (
+        static_cast<std::size_t>
+        (
+            std::ceil(fraction * static_cast<double>(costs_.size()))
+        ),
+        costs_.size()
+    );
+
+    // Only the costliest pixels need to be found, not sorted.
+    std::vector<unsigned int> costs(costs_);
+    std::nth_element
+    (
+        costs.begin(), costs.begin() + count, costs.end(),
+        std::greater<unsigned int>()
+    );
+    const unsigned long long top = std::accumulate
+    (
+        costs.begin(), costs.begin() + count,
+        0ULL
+    );
+
+    return static_cast<double>(top) / static_cast<double>(total);
+}
+
+std::vector<unsigned char> CostMap::Encode() const
+{
+    const unsigned int byte_count = 4;
+
+    std::vector<unsigned char> bytes(costs_.size() * byte_count);
+    std::size_t i = 0;
+    for (unsigned int y = size_.y; y-- > 0;)
+    {
+        for (unsigned int x = 0; x < size_.x; ++x)
+        {
+            const unsigned int cost =
+                costs_[static_cast<std::size_t>(y) * size_.x + x];
+            for (unsigned int k = 0; k < byte_count; ++k)
+            {
+                bytes[i++] = static_cast<unsigned char>(cost >> (8 * k));
+            }
+        }
+    }
+    return bytes;
+}
+
+const Vector2u& CostMap::size() const
+{
+    return size_;
+}
+
+const unsigned int* CostMap::data() const
+{
+    return costs_.data();
+}
+unsigned int* CostMap::data()
+{
+    return costs_.data();
+}
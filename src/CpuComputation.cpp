@@ -0,0 +1,602 @@
+#include <mandelbrot/CpuComputation.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <mandelbrot/Interval.h>
+
+
+using namespace mandelbrot;
+
+
+const double CpuComputation::ESTIMATE_ESCAPE_RADIUS = 1e8;
+const unsigned int CpuComputation::MAX_ESTIMATE_ITERATION_COUNT = 64;
+const unsigned int CpuComputation::COARSEST_STRIDE = 16;
+const unsigned int CpuComputation::TILE_SIZE = 16;
+const double CpuComputation::CYCLE_EPSILON = 1e-10;
+const unsigned int CpuComputation::NEWTON_ITERATION_COUNT = 4;
+// A multiple of the tile size and coarsest stride, so that tiles and
+// coarse grids do not straddle bands.
+const unsigned int CpuComputation::BAND_HEIGHT = 32;
+
+namespace
+{
+    /**
+     * Gets the lifetime at which the reference point compared against at
+     * given lifetime was taken: the largest power of two below it, or 
+     * zero for the starting point.
+     */
+    int GetReferenceLifetime(const int lifetime)
+    {
+        int result = 0;
+        for (int power = 1; power < lifetime; power *= 2) { result = power; }
+        return result;
+    }
+}
+
+void CpuComputation::Reset()
+{
+    needs_reset_ = true;
+}
+void CpuComputation::Execute(const unsigned int iteration_count)
+{
+    const bool is_reset = needs_reset_;
+    if (needs_reset_)
+    {
+        const std::size_t pixel_count =
+            static_cast<std::size_t>(size_.x) * size_.y;
+
+        z_.assign(pixel_count, Complex(0, 0));
+        dz_.assign(pixel_count, Complex(0, 0));
+        reference_z_.assign(pixel_count, Complex(0, 0));
+        multipliers_.assign(pixel_count, Complex(1, 0));
+        states_.assign(pixel_count, State::Pending);
+        values_.assign(2 * pixel_count, 0);
+        lifetimes_.assign(2 * pixel_count, 0);
+        distances_.assign(pixel_count, 0);
+        costs_.assign(pixel_count, 0);
+
+        needs_reset_ = false;
+
+        CreateTiles();
+        CreateBands();
+    }
+
+    if (thread_pool_ == nullptr)
+    {
+        thread_pool_ = std::make_unique<ThreadPool>();
+    }
+    thread_pool_->Run
+    (
+        bands_.size(),
+        [this, iteration_count, is_reset](const std::size_t i)
+        {
+            ExecuteBand(bands_[i], iteration_count, is_reset);
+        }
+    );
+
+    filled_count_ = 0;
+    proven_count_ = 0;
+    for (const Band& band : bands_)
+    {
+        filled_count_ += band.filled_count;
+        proven_count_ += band.proven_count;
+    }
+}
+void CpuComputation::ExecuteBand
+(
+    Band& band,
+    const unsigned int iteration_count,
+    const bool is_reset
+)
+{
+    const std::size_t first_tile = 
+        static_cast<std::size_t>(band.begin_row / TILE_SIZE) * 
+        tile_column_count_;
+    const std::size_t end_tile = 
+        static_cast<std::size_t>((band.end_row + TILE_SIZE - 1) / TILE_SIZE) *
+        tile_column_count_;
+
+    for (std::size_t i = first_tile; i < end_tile; ++i)
+    {
+        // Tiles proven on creation are filled on the first step, the 
+        // others as soon as they are proven.
+        TileClassifier& tile = tiles_[i];
+        if (tile.result() == TileClassifier::Result::Unknown)
+        {
+            tile.Iterate(iteration_count);
+        }
+        else if (!is_reset) { continue; }
+
+        if (tile.result() == TileClassifier::Result::Escaped ||
+            tile.result() == TileClassifier::Result::Interior)
+        {
+            FillTile(band, i);
+        }
+    }
+
+    // Visit every pixel once, coarse grids first. Pixels on a coarser grid
+    // were already visited by an earlier pass.
+    for (unsigned int stride = COARSEST_STRIDE; stride > 0; stride /= 2)
+    {
+        const bool is_coarsest = stride == COARSEST_STRIDE;
+
+        for (unsigned int y = band.begin_row; y < band.end_row; y += stride)
+        {
+            for (unsigned int x = 0; x < size_.x; x += stride)
+            {
+                if (!is_coarsest &&
+                    x % (2 * stride) == 0 &&
+                    y % (2 * stride) == 0)
+                {
+                    continue;
+                }
+
+                const std::size_t index =
+                    static_cast<std::size_t>(y) * size_.x + x;
+                if (states_[index] != State::Pending) { continue; }
+
+                Iterate(band, index, position(x, y), iteration_count);
+            }
+        }
+    }
+}
+void CpuComputation::Iterate
+(
+    Band& band,
+    const std::size_t index,
+    const Complex& c,
+    const unsigned int count
+)
+{
+    Complex z = z_[index];
+    Complex dz = dz_[index];
+    Complex reference = reference_z_[index];
+    Complex multiplier = multipliers_[index];
+    int lifetime = lifetimes_[2 * index];
+    int period = 0;
+
+    // The reference point moves forward at power-of-two lifetimes, so 
+    // cycles of any period are eventually found. The cycle is attracting 
+    // if the derivative with respect to z over one period is less than one.
+    const double escape_norm = escape_radius_ * escape_radius_;
+    for (unsigned int i = 0; i < count && std::norm(z) < escape_norm; ++i)
+    {
+        multiplier *= 2.0 * z;
+        dz = 2.0 * z * dz + 1.0;
+        z = z * z + c;
+        ++ lifetime;
+
+        if (!is_proven_only_ &&
+            std::norm(z - reference) < CYCLE_EPSILON * CYCLE_EPSILON &&
+            std::norm(multiplier) < 1)
+        {
+            period = lifetime - GetReferenceLifetime(lifetime);
+            break;
+        }
+        if ((lifetime & (lifetime - 1)) == 0)
+        {
+            reference = z;
+            multiplier = 1;
+        }
+    }
+
+    values_[2 * index] = static_cast<float>(z.real());
+    values_[2 * index + 1] = static_cast<float>(z.imag());
+    costs_[index] += 
+        static_cast<unsigned int>(lifetime - lifetimes_[2 * index]);
+    lifetimes_[2 * index] = lifetime;
+
+    if (period > 0)
+    {
+        states_[index] = State::Interior;
+        lifetimes_[2 * index + 1] = 1;
+
+        FillInterior(band, index, c, z, period);
+        return;
+    }
+    if (std::norm(z) < escape_norm)
+    {
+        z_[index] = z;
+        dz_[index] = dz;
+        reference_z_[index] = reference;
+        multipliers_[index] = multiplier;
+        return;
+    }
+    states_[index] = State::Escaped;
+
+    FillExterior(band, index, c, z, dz, lifetime);
+}
+void CpuComputation::FillExterior
+(
+    Band& band,
+    const std::size_t center_index,
+    const Complex& c,
+    Complex z,
+    Complex dz,
+    const int lifetime
+)
+{
+    // Same smoothing as the coloring stage applies to the stored value.
+    const double smooth_lifetime =
+        lifetime + 1 - 
+        std::log2(std::log(std::abs(z)) / std::log(escape_radius_));
+
+    // The estimate is only accurate far from the set, so keep going a few
+    // iterations. Magnitude roughly squares with each.
+    const double estimate_norm =
+        ESTIMATE_ESCAPE_RADIUS * ESTIMATE_ESCAPE_RADIUS;
+    unsigned int estimate_iteration_count = 0;
+    while (estimate_iteration_count < MAX_ESTIMATE_ITERATION_COUNT &&
+           std::norm(z) < estimate_norm)
+    {
+        dz = 2.0 * z * dz + 1.0;
+        z = z * z + c;
+        ++ estimate_iteration_count;
+    }
+    costs_[center_index] += estimate_iteration_count;
+
+    const double abs_z = std::abs(z);
+    const double abs_dz = std::abs(dz);
+    if (!std::isfinite(abs_dz) || abs_dz == 0) { return; }
+
+    const double distance = 2 * abs_z * std::log(abs_z) / abs_dz;
+    distances_[center_index] = static_cast<float>(distance);
+
+    if (is_proven_only_) { return; }
+
+    // Potential G falls off as log|z| / 2^n. To first order around the
+    // center, G(c + d) / G(c) = 1 + Re(d * dz / z) / log|z|.
+    const Complex gradient = dz / (z * std::log(abs_z));
+
+    FillDisk
+    (
+        band, center_index, 0.25 * distance, State::Filled,
+        [&](const std::size_t index, const Complex& offset)
+        {
+            const double potential_ratio = std::max
+            (
+                1 + (offset * gradient).real(),
+                1e-3
+            );
+            SetSmoothLifetime
+            (
+                index,
+                smooth_lifetime - std::log2(potential_ratio)
+            );
+            distances_[index] = static_cast<float>
+            (
+                distance - std::abs(offset)
+            );
+        }
+    );
+}
+void CpuComputation::FillInterior
+(
+    Band& band,
+    const std::size_t center_index,
+    const Complex& c,
+    const Complex& z,
+    const int period
+)
+{
+    // Refine the cycle point with Newton's method on f^p(w) - w.
+    Complex w = z;
+    for (unsigned int i = 0; i < NEWTON_ITERATION_COUNT; ++i)
+    {
+        Complex f = w;
+        Complex df_dz = 1;
+        for (int j = 0; j < period; ++j)
+        {
+            df_dz = 2.0 * f * df_dz;
+            f = f * f + c;
+        }
+        w -= (f - w) / (df_dz - 1.0);
+    }
+
+    // First and second derivatives of f^p at the cycle point.
+    Complex f = w;
+    Complex df_dz = 1;
+    Complex df_dc = 0;
+    Complex d2f_dz2 = 0;
+    Complex d2f_dzdc = 0;
+    for (int j = 0; j < period; ++j)
+    {
+        d2f_dzdc = 2.0 * (df_dz * df_dc + f * d2f_dzdc);
+        d2f_dz2 = 2.0 * (df_dz * df_dz + f * d2f_dz2);
+        df_dc = 2.0 * f * df_dc + 1.0;
+        df_dz = 2.0 * f * df_dz;
+        f = f * f + c;
+    }
+    costs_[center_index] += 
+        (NEWTON_ITERATION_COUNT + 1) * static_cast<unsigned int>(period);
+    if (std::norm(df_dz) >= 1) { return; }
+
+    const double distance =
+        (1 - std::norm(df_dz)) /
+        std::abs(d2f_dzdc + d2f_dz2 * df_dc / (1.0 - df_dz));
+    if (!std::isfinite(distance)) { return; }
+
+    // Negative inside the set.
+    distances_[center_index] = static_cast<float>(-distance);
+
+    FillDisk
+    (
+        band, center_index, 0.25 * distance, State::Interior,
+        [&](const std::size_t index, const Complex& offset)
+        {
+            values_[2 * index] = values_[2 * center_index];
+            values_[2 * index + 1] = values_[2 * center_index + 1];
+            lifetimes_[2 * index] = lifetimes_[2 * center_index];
+            lifetimes_[2 * index + 1] = 1;
+            distances_[index] = static_cast<float>
+            (
+                std::abs(offset) - distance
+            );
+        }
+    );
+}
+void CpuComputation::FillDisk
+(
+    Band& band,
+    const std::size_t center_index,
+    const double radius,
+    const State state,
+    const std::function<void(std::size_t, const Complex&)>& fill
+)
+{
+    const double pixel_radius = radius / pixel_size_;
+    if (pixel_radius < 1) { return; }
+
+    const int center_x = static_cast<int>(center_index % size_.x);
+    const int center_y = static_cast<int>(center_index / size_.x);
+    const int extent = static_cast<int>(pixel_radius);
+
+    const int x0 = std::max(center_x - extent, 0);
+    const int x1 = std::min(center_x + extent, static_cast<int>(size_.x) - 1);
+    const int y0 = std::max
+    (
+        center_y - extent, 
+        static_cast<int>(band.begin_row)
+    );
+    const int y1 = std::min
+    (
+        center_y + extent, 
+        static_cast<int>(band.end_row) - 1
+    );
+
+    for (int y = y0; y <= y1; ++y)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            const int dx = x - center_x;
+            const int dy = y - center_y;
+            if (dx * dx + dy * dy > pixel_radius * pixel_radius) { continue; }
+
+            const std::size_t index =
+                static_cast<std::size_t>(y) * size_.x + x;
+            if (states_[index] != State::Pending) { continue; }
+
+            states_[index] = state;
+            fill(index, Complex(dx * pixel_size_, dy * pixel_size_));
+            ++ band.filled_count;
+        }
+    }
+}
+void CpuComputation::CreateTiles()
+{
+    tiles_.clear();
+    tile_column_count_ = (size_.x + TILE_SIZE - 1) / TILE_SIZE;
+
+    const unsigned int row_count = (size_.y + TILE_SIZE - 1) / TILE_SIZE;
+    for (unsigned int row = 0; row < row_count; ++row)
+    {
+        for (unsigned int column = 0; column < tile_column_count_; ++column)
+        {
+            // Spans the centers of the tile's pixels.
+            const Vector2u first(column * TILE_SIZE, row * TILE_SIZE);
+            const Vector2u last
+            (
+                std::min(first.x + TILE_SIZE, size_.x) - 1,
+                std::min(first.y + TILE_SIZE, size_.y) - 1
+            );
+            const Complex lower = position(first.x, first.y);
+            const Complex upper = position(last.x, last.y);
+
+            tiles_.emplace_back
+            (
+                Interval(lower.real(), upper.real()),
+                Interval(lower.imag(), upper.imag()),
+                escape_radius_
+            );
+        }
+    }
+}
+void CpuComputation::CreateBands()
+{
+    bands_.clear();
+    for (unsigned int row = 0; row < size_.y; row += BAND_HEIGHT)
+    {
+        bands_.push_back
+        (
+            Band { row, std::min(row + BAND_HEIGHT, size_.y), 0, 0 }
+        );
+    }
+}
+void CpuComputation::FillTile(Band& band, const std::size_t tile_index)
+{
+    const TileClassifier& tile = tiles_[tile_index];
+    const bool is_interior =
+        tile.result() == TileClassifier::Result::Interior;
+
+    const Vector2u first
+    (
+        static_cast<unsigned int>(tile_index % tile_column_count_) * TILE_SIZE,
+        static_cast<unsigned int>(tile_index / tile_column_count_) * TILE_SIZE
+    );
+    const Vector2u end
+    (
+        std::min(first.x + TILE_SIZE, size_.x),
+        std::min(first.y + TILE_SIZE, size_.y)
+    );
+
+    // Lifetimes are proven. Escaped values, which only affect smoothing,
+    // are extrapolated to first order from the tile's center.
+    const Complex center = 0.5 * 
+    (
+        position(first.x, first.y) + 
+        position(end.x - 1, end.y - 1)
+    );
+    Complex center_z = 0;
+    Complex center_dz = 0;
+    if (!is_interior)
+    {
+        for (int i = 0; i < tile.lifetime(); ++i)
+        {
+            center_dz = 2.0 * center_z * center_dz + 1.0;
+            center_z = center_z * center_z + center;
+        }
+    }
+
+    for (unsigned int y = first.y; y < end.y; ++y)
+    {
+        for (unsigned int x = first.x; x < end.x; ++x)
+        {
+            const std::size_t index =
+                static_cast<std::size_t>(y) * size_.x + x;
+            if (states_[index] != State::Pending) { continue; }
+
+            if (is_interior)
+            {
+                states_[index] = State::Interior;
+                values_[2 * index] = values_[2 * index + 1] = 0;
+                lifetimes_[2 * index] = 0;
+                lifetimes_[2 * index + 1] = 1;
+            }
+            else
+            {
+                Complex z = 
+                    center_z + center_dz * (position(x, y) - center);
+                if (std::abs(z) < escape_radius_)
+                {
+                    z *= escape_radius_ / std::max(std::abs(z), 1e-300);
+                }
+
+                states_[index] = State::Filled;
+                values_[2 * index] = static_cast<float>(z.real());
+                values_[2 * index + 1] = static_cast<float>(z.imag());
+                lifetimes_[2 * index] = tile.lifetime();
+                lifetimes_[2 * index + 1] = 0;
+            }
+            ++ band.filled_count;
+            ++ band.proven_count;
+        }
+    }
+}
+void CpuComputation::SetSmoothLifetime
+(
+    const std::size_t index,
+    const double smooth_lifetime
+)
+{
+    // Inverts the coloring stage's smoothing: an escaped value of
+    // magnitude N^(2^(1 - f)) adds a fraction f to the integer lifetime,
+    // N being the escape radius.
+    const double value = std::max(smooth_lifetime, 0.0);
+    const double lifetime = std::floor(value);
+    const double fraction = value - lifetime;
+
+    values_[2 * index] = static_cast<float>
+    (
+        std::pow(escape_radius_, std::pow(2.0, 1 - fraction))
+    );
+    values_[2 * index + 1] = 0;
+    lifetimes_[2 * index] = static_cast<int>(lifetime);
+}
+
+CpuComputation::Complex CpuComputation::position
+(
+    const unsigned int x,
+    const unsigned int y
+) const
+{
+    return Complex
+    (
+        bottom_left_.x + (x + 0.5) * pixel_size_,
+        bottom_left_.y + (y + 0.5) * pixel_size_
+    );
+}
+
+const Vector2u& CpuComputation::size() const
+{
+    return size_;
+}
+void CpuComputation::set_size(const Vector2u& value)
+{
+    const Vector2u size(std::max(value.x, 1U), std::max(value.y, 1U));
+    if (size.x == size_.x && size.y == size_.y) { return; }
+
+    size_ = size;
+    needs_reset_ = true;
+}
+
+double CpuComputation::escape_radius() const
+{
+    return escape_radius_;
+}
+void CpuComputation::set_escape_radius(const double value)
+{
+    if (value == escape_radius_) { return; }
+
+    escape_radius_ = value;
+    needs_reset_ = true;
+}
+
+void CpuComputation::set_viewport
+(
+    const Vector2d& bottom_left,
+    const double pixel_size
+)
+{
+    bottom_left_ = bottom_left;
+    pixel_size_ = pixel_size;
+    needs_reset_ = true;
+}
+
+const float* CpuComputation::values() const
+{
+    return values_.data();
+}
+const int* CpuComputation::lifetimes() const
+{
+    return lifetimes_.data();
+}
+const float* CpuComputation::distances() const
+{
+    return distances_.data();
+}
+const unsigned int* CpuComputation::costs() const
+{
+    return costs_.data();
+}
+
+std::size_t CpuComputation::filled_count() const
+{
+    return filled_count_;
+}
+std::size_t CpuComputation::proven_count() const
+{
+    return proven_count_;
+}
+
+bool CpuComputation::is_proven_only() const
+{
+    return is_proven_only_;
+}
+void CpuComputation::set_is_proven_only(const bool value)
+{
+    if (value == is_proven_only_) { return; }
+
+    is_proven_only_ = value;
+    needs_reset_ = true;
+}
@@ -0,0 +1,261 @@
+#include <mandelbrot/Deflater.h>
+
+#include <algorithm>
+
+
+using namespace mandelbrot;
+
+
+namespace
+{
+    const unsigned int LENGTH_BASES[29] =
+    {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    const unsigned int LENGTH_EXTRA_BITS[29] =
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    const unsigned int DISTANCE_BASES[30] =
+    {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+        8193, 12289, 16385, 24577
+    };
+    const unsigned int DISTANCE_EXTRA_BITS[30] =
+    {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+
+    unsigned int FindCode
+    (
+        const unsigned int* bases,
+        const unsigned int count,
+        const std::size_t value
+    )
+    {
+        unsigned int code = count - 1;
+        while (bases[code] > value) { -- code; }
+        return code;
+    }
+}
+
+const std::size_t Deflater::WINDOW_SIZE = 32768;
+const std::size_t Deflater::HASH_SIZE = 1 << 15;
+const std::size_t Deflater::MIN_MATCH_LENGTH = 3;
+const std::size_t Deflater::MAX_MATCH_LENGTH = 258;
+const unsigned int Deflater::MAX_CHAIN_LENGTH = 32;
+
+Deflater::Deflater()
+    : head_(HASH_SIZE, 0),
+      previous_(WINDOW_SIZE, 0) {}
+
+void Deflater::Compress(const unsigned char* data, const std::size_t size)
+{
+    if (size == 0) { return; }
+
+    window_.insert(window_.end(), data, data + size);
+    Process(window_begin_ + window_.size());
+
+    // Keep only as much history as matches may reach back to.
+    if (window_.size() > 2 * WINDOW_SIZE)
+    {
+        const std::size_t discarded_count = window_.size() - WINDOW_SIZE;
+        window_.erase(window_.begin(), window_.begin() + discarded_count);
+        window_begin_ += discarded_count;
+    }
+}
+void Deflater::Flush()
+{
+    EndBlock();
+
+    // Empty stored block: header, alignment, LEN = 0, NLEN = ~0.
+    WriteBits(0, 3);
+    AlignToByte();
+    WriteBits(0x0000, 16);
+    WriteBits(0xFFFF, 16);
+}
+void Deflater::Finish()
+{
+    EndBlock();
+    BeginBlock(true);
+    EndBlock();
+    AlignToByte();
+}
+
+std::vector<unsigned char>& Deflater::output()
+{
+    return output_;
+}
+
+void Deflater::Process(const std::size_t end)
+{
+    if (!is_block_open_) { BeginBlock(false); }
+
+    while (position_ < end)
+    {
+        const std::size_t max_length = 
+            std::min(MAX_MATCH_LENGTH, end - position_);
+
+        std::size_t distance = 0;
+        const std::size_t length = 
+            max_length >= MIN_MATCH_LENGTH ?
+            FindMatch(position_, max_length, distance) : 0;
+
+        if (length >= MIN_MATCH_LENGTH)
+        {
+            WriteMatch(length, distance);
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                if (position_ + MIN_MATCH_LENGTH <= end) 
+                { 
+                    Insert(position_); 
+                }
+                ++ position_;
+            }
+        }
+        else
+        {
+            WriteLiteral(window_[position_ - window_begin_]);
+            if (position_ + MIN_MATCH_LENGTH <= end) { Insert(position_); }
+            ++ position_;
+        }
+    }
+}
+void Deflater::Insert(const std::size_t position)
+{
+    const std::size_t hash = Hash(position);
+    previous_[position % WINDOW_SIZE] = head_[hash];
+    head_[hash] = position + 1;
+}
+std::size_t Deflater::FindMatch
+(
+    const std::size_t position,
+    const std::size_t max_length,
+    std::size_t& distance
+) const
+{
+    const unsigned char* current = &window_[position - window_begin_];
+
+    std::size_t best_length = 0;
+    std::size_t candidate = head_[Hash(position)];
+
+    for (unsigned int i = 0; 
+         i < MAX_CHAIN_LENGTH && candidate != 0; 
+         ++i)
+    {
+        const std::size_t candidate_position = candidate - 1;
+        if (candidate_position < window_begin_ ||
+            position - candidate_position > WINDOW_SIZE)
+        {
+            break;
+        }
+
+        const unsigned char* match = 
+            &window_[candidate_position - window_begin_];
+        if (match[best_length] == current[best_length])
+        {
+            std::size_t length = 0;
+            while (length < max_length && match[length] == current[length])
+            {
+                ++ length;
+            }
+            if (length > best_length)
+            {
+                best_length = length;
+                distance = position - candidate_position;
+                if (length == max_length) { break; }
+            }
+        }
+        candidate = previous_[candidate_position % WINDOW_SIZE];
+    }
+    return best_length;
+}
+std::size_t Deflater::Hash(const std::size_t position) const
+{
+    const unsigned char* bytes = &window_[position - window_begin_];
+    const std::size_t key = 
+        (bytes[0] << 16) | (bytes[1] << 8) | bytes[2];
+    return (key * 2654435761U >> 15) & (HASH_SIZE - 1);
+}
+
+void Deflater::BeginBlock(const bool is_final)
+{
+    // BFINAL, then BTYPE = 01 (fixed Huffman codes).
+    WriteBits(is_final ? 1 : 0, 1);
+    WriteBits(1, 2);
+    is_block_open_ = true;
+}
+void Deflater::EndBlock()
+{
+    if (!is_block_open_) { return; }
+
+    WriteSymbol(256);
+    is_block_open_ = false;
+}
+void Deflater::WriteLiteral(const unsigned char value)
+{
+    WriteSymbol(value);
+}
+void Deflater::WriteMatch
+(
+    const std::size_t length,
+    const std::size_t distance
+)
+{
+    const unsigned int length_code = FindCode(LENGTH_BASES, 29, length);
+    WriteSymbol(257 + length_code);
+    WriteBits
+    (
+        static_cast<std::uint32_t>(length - LENGTH_BASES[length_code]),
+        LENGTH_EXTRA_BITS[length_code]
+    );
+
+    const unsigned int distance_code = 
+        FindCode(DISTANCE_BASES, 30, distance);
+    WriteCode(distance_code, 5);
+    WriteBits
+    (
+        static_cast<std::uint32_t>
+        (
+            distance - DISTANCE_BASES[distance_code]
+        ),
+        DISTANCE_EXTRA_BITS[distance_code]
+    );
+}
+void Deflater::WriteSymbol(const unsigned int symbol)
+{
+    // Fixed literal/length code (RFC 1951, section 3.2.6).
+    if (symbol < 144) { WriteCode(0x30 + symbol, 8); }
+    else if (symbol < 256) { WriteCode(0x190 + symbol - 144, 9); }
+    else if (symbol < 280) { WriteCode(symbol - 256, 7); }
+    else { WriteCode(0xC0 + symbol - 280, 8); }
+}
+void Deflater::WriteCode(const unsigned int code, const unsigned int length)
+{
+    // Huffman codes are packed starting with their most significant bit.
+    std::uint32_t reversed = 0;
+    for (unsigned int i = 0; i < length; ++i)
+    {
+        reversed |= ((code >> i) & 1) << (length - 1 - i);
+    }
+    WriteBits(reversed, length);
+}
+void Deflater::WriteBits(const std::uint32_t value, const unsigned int count)
+{
+    bit_buffer_ |= static_cast<std::uint64_t>(value) << bit_count_;
+    bit_count_ += count;
+    while (bit_count_ >= 8)
+    {
+        output_.push_back(static_cast<unsigned char>(bit_buffer_ & 0xFF));
+        bit_buffer_ >>= 8;
+        bit_count_ -= 8;
+    }
+}
+void Deflater::AlignToByte()
+{
+    if (bit_count_ > 0) { WriteBits(0, 8 - bit_count_); }
+}
@@ -1,5 +1,9 @@
 #include <mandelbrot/DisplayStage.h>
 
+#include <utility>
+
+#include <oogl/FrameBuffer.hpp>
+
 
 using namespace mandelbrot;
 using namespace oogl;
@@ -27,20 +31,24 @@ bool DisplayStage::Initialize()
 }
 bool DisplayStage::InitializeTextures()
 {
-    image_texture_ = std::make_unique<Texture>
+    // Room for the previous size's image and cost, to toggle back without
+    // allocating.
+    texture_pool_.set_capacity(2);
+
+    image_texture_ = texture_pool_.Acquire
     (
         Texture::Binding::Texture2D,
-        GL_RGB,
+        GL_RGB8,
         1, 1
     );
+    SetImageParameters();
 
-    image_texture_->Bind();
-    image_texture_->UploadData(0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-
+    return image_texture_->is_valid();
+}
+void DisplayStage::SetImageParameters()
+{
     image_texture_->set_filters(Texture::Filter::Nearest);
     image_texture_->set_wrappers(Texture::Wrapper::ClampToBorder);
-
-    return image_texture_->is_valid();
 }
 bool DisplayStage::InitializeUniforms()
 {
@@ -54,7 +62,7 @@ bool DisplayStage::InitializeUniforms()
     uniform_relative_position_offset_ =
         program_->GetVectorUniform<GLdouble, 2>("relative_position_offset");
     uniform_relative_size_factor_ =
-        program_->GetVectorUniform<GLdouble, 1>("relative_size_factor");
+        program_->GetVectorUniform<GLdouble, 2>("relative_size_factor");
 
     return uniform_image_.is_valid() &&
            uniform_relative_position_offset_.is_valid() &&
@@ -69,24 +77,9 @@ void DisplayStage::Execute()
     
     image_texture_->BindToUnit(IMAGE_TEXTURE_UNIT_INDEX);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    FrameBuffer::BindDefault();
     
-    const GLint min = Min(display_size_);
-    const GLint max = Max(display_size_);
-    const GLint offset = (min - max) / 2;
-    GLint x, y;
-    if (display_size_.x > display_size_.y)
-    {
-        x = 0;
-        y = offset;
-    }
-    else
-    {
-        x = offset;
-        y = 0;
-    }
-    
-    glViewport(x, y, max, max);
+    glViewport(0, 0, display_size_.x, display_size_.y);
 
     DrawScreenQuad();
 }
@@ -104,7 +97,11 @@ void DisplayStage::UpdateUniforms()
     }
     if (relative_size_factor_needs_update_)
     {
-        uniform_relative_size_factor_.set(relative_size_factor_);
+        uniform_relative_size_factor_.set
+        (
+            relative_size_factor_.x,
+            relative_size_factor_.y
+        );
         relative_size_factor_needs_update_ = false;
     }
 }
@@ -116,12 +113,53 @@ void DisplayStage::UpdateCache
     const double size
 )
 {
-    image_texture_->Bind();
+    if (texture_pool_.Resize
+        (
+            image_texture_, 
+            texture.width(), texture.height()
+        ))
+    {
+        SetImageParameters();
+    }
     image_texture_->CopyData(texture);
     
     viewport_.position = position;
     viewport_.size = size;
 }
+void DisplayStage::UpdateCostCache(const Texture& texture)
+{
+    if (cost_texture_ == nullptr)
+    {
+        cost_texture_ = texture_pool_.Acquire
+        (
+            Texture::Binding::Texture2D,
+            GL_R32UI,
+            texture.width(), texture.height()
+        );
+    }
+    else
+    {
+        texture_pool_.Resize
+        (
+            cost_texture_,
+            texture.width(), texture.height()
+        );
+    }
+    cost_texture_->CopyData(texture);
+    is_cost_valid_ = true;
+}
+void DisplayStage::InvalidateCostCache()
+{
+    is_cost_valid_ = false;
+}
+void DisplayStage::ReleaseCostCache()
+{
+    InvalidateCostCache();
+    if (cost_texture_ != nullptr)
+    {
+        texture_pool_.Release(std::move(cost_texture_));
+    }
+}
 
 const Vector2u& DisplayStage::display_size() const
 {
@@ -142,13 +180,21 @@ void DisplayStage::set_relative_position_offset(const Vector2d& value)
     relative_position_offset_ = value;
     relative_position_offset_needs_update_ = true;
 }
-void DisplayStage::set_relative_size_offset(const double value)
+void DisplayStage::set_relative_size_offset(const Vector2d& value)
 {
     relative_size_factor_ = value;
     relative_size_factor_needs_update_ = true;
 }
 
+const Texture& DisplayStage::image() const
+{
+    return *image_texture_;
+}
 Texture& DisplayStage::image()
 {
     return *image_texture_;
 }
+const Texture* DisplayStage::cost() const
+{
+    return is_cost_valid_ ? cost_texture_.get() : nullptr;
+}
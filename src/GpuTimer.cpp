@@ -0,0 +1,115 @@
+#include <mandelbrot/GpuTimer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+
+using namespace mandelbrot;
+using namespace oogl;
+
+
+const unsigned int GpuTimer::QUERY_COUNT = 4;
+const unsigned int GpuTimer::DEFAULT_SAMPLE_CAPACITY = 120;
+
+GpuTimer::Scope::Scope(GpuTimer& timer)
+    : timer_(timer)
+{
+    timer_.Begin();
+}
+GpuTimer::Scope::~Scope()
+{
+    timer_.End();
+}
+
+void GpuTimer::Begin()
+{
+    Poll();
+
+    // Skip rather than wait for the oldest result.
+    if (pending_count_ == QUERY_COUNT) { return; }
+
+    if (queries_.empty()) { queries_.resize(QUERY_COUNT); }
+
+    const unsigned int index = (first_ + pending_count_) % QUERY_COUNT;
+    if (queries_[index] == nullptr)
+    {
+        queries_[index] = std::make_unique<Query>
+        (
+            Query::Target::TimeElapsed
+        );
+    }
+    queries_[index]->Begin();
+    is_measuring_ = true;
+}
+void GpuTimer::End()
+{
+    if (!is_measuring_) { return; }
+
+    const unsigned int index = (first_ + pending_count_) % QUERY_COUNT;
+    queries_[index]->End();
+    ++ pending_count_;
+    is_measuring_ = false;
+}
+void GpuTimer::Poll()
+{
+    while (pending_count_ > 0 && queries_[first_]->is_result_available())
+    {
+        ReadOldest();
+    }
+}
+void GpuTimer::ReadOldest()
+{
+    const double NANOSECONDS_PER_MILLISECOND = 1e6;
+    samples_.push_back
+    (
+        queries_[first_]->result() / NANOSECONDS_PER_MILLISECOND
+    );
+    if (samples_.size() > sample_capacity_) { samples_.pop_front(); }
+
+    first_ = (first_ + 1) % QUERY_COUNT;
+    -- pending_count_;
+}
+
+void GpuTimer::Clear()
+{
+    samples_.clear();
+}
+void GpuTimer::Finish()
+{
+    // Query results block until available.
+    while (pending_count_ > 0) { ReadOldest(); }
+}
+
+GpuTimer::Statistics GpuTimer::statistics() const
+{
+    Statistics statistics;
+    if (samples_.empty()) { return statistics; }
+
+    std::vector<double> sorted(samples_.begin(), samples_.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    const std::size_t n = sorted.size();
+    const std::size_t percentile_99_rank = static_cast<std::size_t>
+    (
+        std::ceil(0.99 * n)
+    );
+
+    statistics.sample_count = static_cast<unsigned int>(n);
+    statistics.minimum = sorted.front();
+    statistics.average = 
+        std::accumulate(sorted.begin(), sorted.end(), 0.0) / n;
+    statistics.percentile_99 = sorted[percentile_99_rank - 1];
+
+    return statistics;
+}
+
+unsigned int GpuTimer::sample_capacity() const
+{
+    return sample_capacity_;
+}
+void GpuTimer::set_sample_capacity(const unsigned int value)
+{
+    sample_capacity_ = std::max(value, 1U);
+    while (samples_.size() > sample_capacity_) { samples_.pop_front(); }
+}
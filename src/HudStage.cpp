@@ -0,0 +1,289 @@
+#include <mandelbrot/HudStage.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <oogl/FrameBuffer.hpp>
+
+
+using namespace mandelbrot;
+using namespace oogl;
+
+
+namespace
+{
+    struct Glyph
+    {
+        char character;
+        // Top row first, leftmost pixel in the highest of five bits.
+        unsigned char rows[7];
+    };
+
+    // The blank glyph comes first, standing in for missing characters.
+    const Glyph FONT[] =
+    {
+        { ' ', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+        { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+        { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+        { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+        { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+        { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+        { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+        { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+        { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+        { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+        { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+        { 'A', { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 } },
+        { 'B', { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E } },
+        { 'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+        { 'D', { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } },
+        { 'E', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } },
+        { 'F', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 } },
+        { 'G', { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F } },
+        { 'H', { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+        { 'I', { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+        { 'J', { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C } },
+        { 'K', { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+        { 'L', { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F } },
+        { 'M', { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } },
+        { 'N', { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+        { 'O', { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+        { 'P', { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+        { 'Q', { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D } },
+        { 'R', { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+        { 'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+        { 'T', { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+        { 'U', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+        { 'V', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+        { 'W', { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A } },
+        { 'X', { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 } },
+        { 'Y', { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 } },
+        { 'Z', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F } },
+        { '.', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C } },
+        { ',', { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 } },
+        { ':', { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 } },
+        { '/', { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 } },
+        { '%', { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 } },
+        { '-', { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 } },
+        { '+', { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 } },
+        { '=', { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 } },
+        { '(', { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 } },
+        { ')', { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 } }
+    };
+    const unsigned int GLYPH_COUNT = sizeof(FONT) / sizeof(FONT[0]);
+
+    unsigned char GetGlyphIndex(char character)
+    {
+        if (character >= 'a' && character <= 'z')
+        {
+            character = static_cast<char>(character - 'a' + 'A');
+        }
+        for (unsigned int i = 0; i < GLYPH_COUNT; ++i)
+        {
+            if (FONT[i].character == character)
+            {
+                return static_cast<unsigned char>(i);
+            }
+        }
+        return 0;
+    }
+}
+
+const char* HudStage::VERTEX_SHADER_SOURCE_PATH =
+    "../src/shaders/simpleTextureVertexShader.glsl";
+const char* HudStage::FRAGMENT_SHADER_SOURCE_PATH =
+    "../src/shaders/hudFragmentShader.glsl";
+
+const GLint HudStage::TEXT_TEXTURE_UNIT_INDEX = 0;
+const GLint HudStage::FONT_TEXTURE_UNIT_INDEX = 1;
+
+const unsigned int HudStage::PIXEL_SCALE = 2;
+
+const Vector2u HudStage::GLYPH_SIZE = Vector2u(5, 7);
+const Vector2u HudStage::CELL_SIZE = Vector2u(6, 9);
+const unsigned int HudStage::PADDING = 3;
+
+HudStage::HudStage()
+    : ProcessingStage
+     (
+         VERTEX_SHADER_SOURCE_PATH,
+         FRAGMENT_SHADER_SOURCE_PATH
+     ) {}
+
+bool HudStage::Initialize()
+{
+    return ProcessingStage::Initialize() &&
+           InitializeTextures() &&
+           InitializeUniforms();
+}
+bool HudStage::InitializeTextures()
+{
+    // Room for the previous text size, as lines come and go.
+    texture_pool_.set_capacity(1);
+
+    const GLsizei font_width = GLYPH_COUNT * GLYPH_SIZE.x;
+    const GLsizei font_height = GLYPH_SIZE.y;
+
+    std::vector<unsigned char> pixels(font_width * font_height, 0);
+    for (unsigned int i = 0; i < GLYPH_COUNT; ++i)
+    {
+        for (unsigned int y = 0; y < GLYPH_SIZE.y; ++y)
+        {
+            for (unsigned int x = 0; x < GLYPH_SIZE.x; ++x)
+            {
+                const unsigned char mask = static_cast<unsigned char>
+                (
+                    1 << (GLYPH_SIZE.x - 1 - x)
+                );
+                if (FONT[i].rows[y] & mask)
+                {
+                    pixels[y * font_width + i * GLYPH_SIZE.x + x] = 255;
+                }
+            }
+        }
+    }
+
+    font_texture_ = texture_pool_.Acquire
+    (
+        Texture::Binding::Texture2D,
+        GL_R8,
+        font_width, font_height
+    );
+    font_texture_->set_filters(Texture::Filter::Nearest);
+
+    // Rows of glyphs and text are tightly packed.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    font_texture_->UploadData(0, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+
+    text_texture_ = texture_pool_.Acquire
+    (
+        Texture::Binding::Texture2D,
+        GL_R8UI,
+        text_size_.x, text_size_.y
+    );
+    text_texture_->set_filters(Texture::Filter::Nearest);
+
+    return font_texture_->is_valid() &&
+           text_texture_->is_valid();
+}
+bool HudStage::InitializeUniforms()
+{
+    program_->Use();
+
+    uniform_text_ =
+        program_->GetVectorUniform<GLint, 1>("text_texture");
+    uniform_text_
+        .set(TEXT_TEXTURE_UNIT_INDEX);
+
+    uniform_font_ =
+        program_->GetVectorUniform<GLint, 1>("font_texture");
+    uniform_font_
+        .set(FONT_TEXTURE_UNIT_INDEX);
+
+    return uniform_text_.is_valid() &&
+           uniform_font_.is_valid();
+}
+
+void HudStage::Execute()
+{
+    program_->Use();
+
+    UpdateText();
+
+    text_texture_->BindToUnit(TEXT_TEXTURE_UNIT_INDEX);
+    font_texture_->BindToUnit(FONT_TEXTURE_UNIT_INDEX);
+
+    FrameBuffer::BindDefault();
+
+    // Only the overlay's corner is drawn, from the display's top-left.
+    const GLsizei width =
+        (text_size_.x * CELL_SIZE.x + 2 * PADDING) * PIXEL_SCALE;
+    const GLsizei height =
+        (text_size_.y * CELL_SIZE.y + 2 * PADDING) * PIXEL_SCALE;
+    glViewport
+    (
+        0, static_cast<GLint>(display_size_.y) - height,
+        width, height
+    );
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    DrawScreenQuad();
+
+    glDisable(GL_BLEND);
+}
+
+void HudStage::UpdateText()
+{
+    if (!text_needs_update_) { return; }
+
+    std::vector<std::string> lines(1);
+    for (const char character : text_)
+    {
+        if (character == '\n') { lines.emplace_back(); }
+        else { lines.back() += character; }
+    }
+
+    Vector2u size(1, static_cast<unsigned int>(lines.size()));
+    for (const std::string& line : lines)
+    {
+        size.x = std::max(size.x, static_cast<unsigned int>(line.size()));
+    }
+
+    // Top line first, padded with blanks.
+    std::vector<unsigned char> glyphs(size.x * size.y, 0);
+    for (unsigned int y = 0; y < size.y; ++y)
+    {
+        for (unsigned int x = 0; x < lines[y].size(); ++x)
+        {
+            glyphs[y * size.x + x] = GetGlyphIndex(lines[y][x]);
+        }
+    }
+
+    if (texture_pool_.Resize(text_texture_, size.x, size.y))
+    {
+        text_texture_->set_filters(Texture::Filter::Nearest);
+    }
+    text_size_ = size;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    text_texture_->UploadData
+    (
+        0,
+        GL_RED_INTEGER, GL_UNSIGNED_BYTE,
+        glyphs.data()
+    );
+
+    text_needs_update_ = false;
+}
+
+bool HudStage::is_visible() const
+{
+    return is_visible_;
+}
+void HudStage::set_is_visible(const bool value)
+{
+    is_visible_ = value;
+}
+
+const std::string& HudStage::text() const
+{
+    return text_;
+}
+void HudStage::set_text(const std::string& value)
+{
+    if (value == text_) { return; }
+
+    text_ = value;
+    text_needs_update_ = true;
+}
+
+const Vector2u& HudStage::display_size() const
+{
+    return display_size_;
+}
+void HudStage::set_display_size(const Vector2u& value)
+{
+    display_size_ = value;
+}
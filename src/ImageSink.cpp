@@ -0,0 +1,184 @@
+#include <mandelbrot/ImageSink.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <mandelbrot/PngSink.h>
+#include <mandelbrot/PpmSink.h>
+
+
+using namespace mandelbrot;
+
+
+std::unique_ptr<ImageSink> ImageSink::FromPath(const std::string& path)
+{
+    static const std::string PPM_EXTENSION = ".ppm";
+
+    const bool is_ppm =
+        path.size() >= PPM_EXTENSION.size() &&
+        path.compare
+        (
+            path.size() - PPM_EXTENSION.size(), PPM_EXTENSION.size(),
+            PPM_EXTENSION
+        ) == 0;
+
+    if (is_ppm) { return std::make_unique<PpmSink>(); }
+    else        { return std::make_unique<PngSink>(); }
+}
+
+ImageSink::~ImageSink() {}
+
+bool ImageSink::Open
+(
+    const std::string& path,
+    const unsigned int width,
+    const unsigned int height,
+    const unsigned int channel_count
+)
+{
+    if (is_open() || width == 0 || height == 0) { return false; }
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) { return false; }
+
+    width_ = width;
+    height_ = height;
+    channel_count_ = channel_count;
+    row_count_ = 0;
+
+    band_.clear();
+    band_height_ = 0;
+    band_width_ = 0;
+
+    if (!WriteHeader())
+    {
+        file_.close();
+        return false;
+    }
+    return true;
+}
+bool ImageSink::WriteRows
+(
+    const unsigned char* pixels,
+    const unsigned int row_count,
+    const bool is_bottom_up
+)
+{
+    const std::size_t row_size =
+        static_cast<std::size_t>(width_) * channel_count_;
+
+    if (!is_open() || band_width_ > 0) { return false; }
+    if (row_count > height_ - row_count_) { return false; }
+
+    for (unsigned int y = 0; y < row_count; ++y)
+    {
+        const unsigned int source_y = is_bottom_up ? row_count - 1 - y : y;
+        if (!WriteRow(&pixels[source_y * row_size])) { return false; }
+        ++ row_count_;
+    }
+    return file_.good();
+}
+bool ImageSink::WriteTile
+(
+    const unsigned char* pixels,
+    const unsigned int width,
+    const unsigned int height,
+    const unsigned int row_length,
+    const bool is_bottom_up
+)
+{
+    if (!is_open()) { return false; }
+
+    if (band_width_ == 0)
+    {
+        if (height == 0 || height > height_ - row_count_) { return false; }
+
+        band_height_ = height;
+        band_.resize
+        (
+            static_cast<std::size_t>(width_) * band_height_ * channel_count_
+        );
+    }
+    if (height != band_height_ || width > width_ - band_width_)
+    {
+        return false;
+    }
+
+    const std::size_t band_row_size =
+        static_cast<std::size_t>(width_) * channel_count_;
+    const std::size_t tile_row_size =
+        static_cast<std::size_t>(width) * channel_count_;
+    const std::size_t source_row_size =
+        static_cast<std::size_t>(row_length) * channel_count_;
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        const unsigned int source_y = is_bottom_up ? height - 1 - y : y;
+        std::memcpy
+        (
+            &band_[y * band_row_size + band_width_ * channel_count_],
+            &pixels[source_y * source_row_size],
+            tile_row_size
+        );
+    }
+    band_width_ += width;
+
+    if (band_width_ == width_) { return WriteBand(); }
+
+    return true;
+}
+bool ImageSink::Close()
+{
+    if (!is_open()) { return false; }
+
+    const bool is_complete =
+        row_count_ == height_ &&
+        band_width_ == 0 &&
+        WriteTrailer();
+
+    file_.close();
+    std::vector<unsigned char>().swap(band_);
+
+    return is_complete && !file_.fail();
+}
+
+bool ImageSink::WriteBand()
+{
+    const std::size_t row_size =
+        static_cast<std::size_t>(width_) * channel_count_;
+
+    for (unsigned int y = 0; y < band_height_; ++y)
+    {
+        if (!WriteRow(&band_[y * row_size])) { return false; }
+        ++ row_count_;
+    }
+    band_width_ = 0;
+
+    return file_.good();
+}
+
+bool ImageSink::is_open() const
+{
+    return file_.is_open();
+}
+unsigned int ImageSink::width() const
+{
+    return width_;
+}
+unsigned int ImageSink::height() const
+{
+    return height_;
+}
+unsigned int ImageSink::channel_count() const
+{
+    return channel_count_;
+}
+unsigned int ImageSink::row_count() const
+{
+    return row_count_;
+}
+
+std::ofstream& ImageSink::file()
+{
+    return file_;
+}
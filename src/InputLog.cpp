@@ -0,0 +1,176 @@
+#include <mandelbrot/InputLog.h>
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+
+using namespace mandelbrot;
+
+
+const char* InputLog::HEADER = "mandelbrot-input";
+const unsigned int InputLog::VERSION = 1;
+
+bool InputLog::Read(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string header;
+    unsigned int version = 0;
+    file >> header >> version;
+    if (file.fail() || header != HEADER || version != VERSION)
+    {
+        return false;
+    }
+
+    Clear();
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream entry(line);
+        std::string type;
+        if (!(entry >> type)) { continue; }
+
+        if (type == "camera")
+        {
+            Vector2d position;
+            double zoom_factor;
+            entry >> position.x >> position.y >> zoom_factor;
+            set_camera(position, zoom_factor);
+        }
+        else if (type == "k")
+        {
+            KeyEvent event;
+            entry >> event.key >> event.action >> event.modifiers;
+            pending_key_events_.push_back(event);
+        }
+        else if (type == "f")
+        {
+            long long microseconds;
+            if (!(entry >> microseconds)) { return false; }
+
+            Frame frame;
+            frame.key_events.swap(pending_key_events_);
+            frame.duration = std::chrono::duration_cast<Stopwatch::Duration>
+            (
+                std::chrono::microseconds(microseconds)
+            );
+            if (!(entry >> frame.count))
+            {
+                frame.count = 1;
+                entry.clear();
+            }
+            frames_.push_back(frame);
+        }
+        else { return false; }
+
+        if (entry.fail()) { return false; }
+    }
+    return true;
+}
+bool InputLog::Write(const std::string& path) const
+{
+    std::ofstream file(path);
+    file << HEADER << " " << VERSION << std::endl;
+    if (has_camera_)
+    {
+        file << std::setprecision(std::numeric_limits<double>::max_digits10)
+             << "camera "
+             << camera_position_.x << " "
+             << camera_position_.y << " "
+             << camera_zoom_factor_
+             << std::endl;
+    }
+    for (const Frame& frame : frames_)
+    {
+        for (const KeyEvent& event : frame.key_events)
+        {
+            file << "k "
+                 << event.key << " "
+                 << event.action << " "
+                 << event.modifiers
+                 << std::endl;
+        }
+        file << "f "
+             << std::chrono::duration_cast<std::chrono::microseconds>
+                (
+                    frame.duration
+                ).count();
+        if (frame.count != 1) { file << " " << frame.count; }
+        file << std::endl;
+    }
+    return !file.fail();
+}
+
+void InputLog::Clear()
+{
+    frames_.clear();
+    pending_key_events_.clear();
+    has_camera_ = false;
+}
+
+void InputLog::RecordKey
+(
+    const int key,
+    const int action,
+    const int modifiers
+)
+{
+    pending_key_events_.push_back({ key, action, modifiers });
+}
+void InputLog::RecordFrame(const Stopwatch::Duration& duration)
+{
+    // Stored at the file's resolution, so a replay of the recording and
+    // of its file match.
+    const Stopwatch::Duration rounded =
+        std::chrono::duration_cast<Stopwatch::Duration>
+        (
+            std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        );
+
+    // Consecutive frames of equal length are merged, unless keys were
+    // pressed in between.
+    if (pending_key_events_.empty() &&
+        !frames_.empty() &&
+        frames_.back().duration == rounded)
+    {
+        ++ frames_.back().count;
+        return;
+    }
+
+    Frame frame;
+    frame.key_events.swap(pending_key_events_);
+    frame.duration = rounded;
+    frames_.push_back(frame);
+}
+
+const std::vector<InputLog::Frame>& InputLog::frames() const
+{
+    return frames_;
+}
+unsigned int InputLog::frame_count() const
+{
+    unsigned int count = 0;
+    for (const Frame& frame : frames_) { count += frame.count; }
+    return count;
+}
+
+bool InputLog::has_camera() const
+{
+    return has_camera_;
+}
+const Vector2d& InputLog::camera_position() const
+{
+    return camera_position_;
+}
+double InputLog::camera_zoom_factor() const
+{
+    return camera_zoom_factor_;
+}
+void InputLog::set_camera(const Vector2d& position, const double zoom_factor)
+{
+    has_camera_ = true;
+    camera_position_ = position;
+    camera_zoom_factor_ = zoom_factor;
+}
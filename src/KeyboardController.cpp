@@ -22,6 +22,9 @@ const int KeyboardController::KEY_TOGGLE_PAUSE = GLFW_KEY_TAB;
 const int KeyboardController::KEY_STEP = GLFW_KEY_SPACE;
 const int KeyboardController::KEY_SAVE_SNAPSHOT = GLFW_KEY_S;
 const int KeyboardController::KEY_DEBUG = GLFW_KEY_SEMICOLON;
+const int KeyboardController::KEY_WRITE_TRACE = GLFW_KEY_APOSTROPHE;
+const int KeyboardController::KEY_TOGGLE_HUD = GLFW_KEY_H;
+const int KeyboardController::KEY_TOGGLE_COST_HEATMAP = GLFW_KEY_C;
 
 void KeyboardController::ControlAxis::PressUp()
 {
@@ -144,6 +147,18 @@ void KeyboardController::Process
         {
             application_->PrintDebugInformation();
         }
+        else if (key == KEY_WRITE_TRACE)
+        {
+            application_->WriteTrace();
+        }
+        else if (key == KEY_TOGGLE_HUD)
+        {
+            application_->ToggleHud();
+        }
+        else if (key == KEY_TOGGLE_COST_HEATMAP)
+        {
+            application_->ToggleCostHeatmap();
+        }
     }
 }
 void KeyboardController::ProcessAxis
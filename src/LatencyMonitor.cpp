@@ -0,0 +1,126 @@
+#include <mandelbrot/LatencyMonitor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+using namespace mandelbrot;
+
+
+const unsigned int LatencyMonitor::DEFAULT_SAMPLE_CAPACITY = 256;
+
+void LatencyMonitor::RecordInput()
+{
+    const TimePoint now = Stopwatch::Clock::now();
+
+    if (!has_pending_input_)
+    {
+        pending_input_time_ = now;
+        has_pending_input_ = true;
+    }
+    latest_input_time_ = now;
+}
+void LatencyMonitor::RecordCameraUpdate(const bool is_camera_changed)
+{
+    if (!has_pending_input_) { return; }
+    has_pending_input_ = false;
+
+    if (!is_camera_changed) { return; }
+
+    if (!is_awaiting_preview_)
+    {
+        preview_input_time_ = pending_input_time_;
+        is_awaiting_preview_ = true;
+    }
+    is_awaiting_final_ = true;
+}
+void LatencyMonitor::RecordPresent(const bool is_image_complete)
+{
+    const TimePoint now = Stopwatch::Clock::now();
+
+    if (is_awaiting_preview_)
+    {
+        AddSample(preview_samples_, preview_input_time_, now);
+        is_awaiting_preview_ = false;
+    }
+    if (is_awaiting_final_ && is_image_complete)
+    {
+        AddSample(final_samples_, latest_input_time_, now);
+        is_awaiting_final_ = false;
+    }
+}
+void LatencyMonitor::AddSample
+(
+    std::deque<double>& samples,
+    const TimePoint& begin,
+    const TimePoint& end
+)
+{
+    const double milliseconds =
+        std::chrono::duration<double, std::milli>(end - begin).count();
+
+    samples.push_back(milliseconds);
+    if (samples.size() > sample_capacity_) { samples.pop_front(); }
+}
+
+void LatencyMonitor::Clear()
+{
+    preview_samples_.clear();
+    final_samples_.clear();
+}
+
+LatencyMonitor::Statistics LatencyMonitor::preview_statistics() const
+{
+    return GetStatistics(preview_samples_);
+}
+LatencyMonitor::Statistics LatencyMonitor::final_statistics() const
+{
+    return GetStatistics(final_samples_);
+}
+LatencyMonitor::Statistics LatencyMonitor::GetStatistics
+(
+    const std::deque<double>& samples
+)
+{
+    Statistics statistics;
+    if (samples.empty()) { return statistics; }
+
+    std::vector<double> sorted(samples.begin(), samples.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    const std::size_t n = sorted.size();
+    const auto percentile = [&sorted, n](const double fraction)
+    {
+        const std::size_t rank = static_cast<std::size_t>
+        (
+            std::ceil(fraction * static_cast<double>(n))
+        );
+        return sorted[std::max<std::size_t>(rank, 1) - 1];
+    };
+
+    statistics.sample_count = static_cast<unsigned int>(n);
+    statistics.median = percentile(0.5);
+    statistics.percentile_90 = percentile(0.9);
+    statistics.percentile_99 = percentile(0.99);
+    statistics.maximum = sorted.back();
+
+    return statistics;
+}
+
+unsigned int LatencyMonitor::sample_capacity() const
+{
+    return sample_capacity_;
+}
+void LatencyMonitor::set_sample_capacity(const unsigned int value)
+{
+    sample_capacity_ = std::max(value, 1U);
+    while (preview_samples_.size() > sample_capacity_)
+    {
+        preview_samples_.pop_front();
+    }
+    while (final_samples_.size() > sample_capacity_)
+    {
+        final_samples_.pop_front();
+    }
+}
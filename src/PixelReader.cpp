@@ -0,0 +1,94 @@
+#include <mandelbrot/PixelReader.h>
+
+
+using namespace mandelbrot;
+using namespace oogl;
+
+
+const unsigned int PixelReader::CHANNEL_COUNT = 3;
+const unsigned int PixelReader::DEFAULT_CAPACITY = 3;
+
+PixelReader::PixelReader()
+    : PixelReader(DEFAULT_CAPACITY) {}
+PixelReader::PixelReader(const unsigned int capacity)
+    : slots_(std::max(capacity, 1U)) {}
+
+bool PixelReader::Read(Texture& texture, const Callback& callback)
+{
+    if (count_ == slots_.size()) { return false; }
+
+    Slot& slot = slots_[(first_ + count_) % slots_.size()];
+
+    slot.width = texture.width();
+    slot.height = texture.height();
+    slot.callback = callback;
+
+    const GLsizeiptr size = CHANNEL_COUNT * slot.width * slot.height;
+
+    if (slot.buffer == nullptr)
+    {
+        slot.buffer = std::make_unique<VertexBuffer>
+        (
+            VertexBuffer::Binding::PixelPack,
+            VertexBuffer::Usage::StreamRead
+        );
+    }
+    slot.buffer->Bind();
+    if (slot.buffer_size != size)
+    {
+        slot.buffer->UploadData(size, nullptr);
+        slot.buffer_size = size;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    texture.DownloadData(0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    VertexBuffer::Unbind(VertexBuffer::Binding::PixelPack);
+
+    slot.fence = std::make_unique<Fence>();
+    glFlush();
+
+    ++ count_;
+
+    return true;
+}
+bool PixelReader::Poll()
+{
+    bool has_completed = false;
+    while (count_ > 0 && slots_[first_].fence->is_signaled())
+    {
+        Complete(slots_[first_]);
+        has_completed = true;
+    }
+    return has_completed;
+}
+void PixelReader::Finish()
+{
+    while (count_ > 0)
+    {
+        Slot& slot = slots_[first_];
+        while (!slot.fence->Wait(1000000)) {}
+        Complete(slot);
+    }
+}
+void PixelReader::Complete(Slot& slot)
+{
+    slot.fence.reset();
+
+    const auto pixels = static_cast<const unsigned char*>
+    (
+        slot.buffer->MapRange(0, slot.buffer_size, GL_MAP_READ_BIT)
+    );
+    slot.callback(pixels, slot.width, slot.height);
+    if (pixels != nullptr) { slot.buffer->Unmap(); }
+    VertexBuffer::Unbind(VertexBuffer::Binding::PixelPack);
+
+    slot.callback = nullptr;
+
+    first_ = (first_ + 1) % slots_.size();
+    -- count_;
+}
+
+bool PixelReader::is_busy() const
+{
+    return count_ > 0;
+}
@@ -0,0 +1,362 @@
+#include <mandelbrot/PngEncoder.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#include <mandelbrot/Checksum.h>
+#include <mandelbrot/Deflater.h>
+
+
+using namespace mandelbrot;
+
+
+namespace
+{
+    const unsigned char SIGNATURE[8] = 
+    {
+        137, 80, 78, 71, 13, 10, 26, 10
+    };
+
+    void AppendUint32
+    (
+        const std::uint32_t value, 
+        std::vector<unsigned char>& output
+    )
+    {
+        output.push_back(static_cast<unsigned char>(value >> 24));
+        output.push_back(static_cast<unsigned char>(value >> 16));
+        output.push_back(static_cast<unsigned char>(value >> 8));
+        output.push_back(static_cast<unsigned char>(value));
+    }
+
+    unsigned char Paeth
+    (
+        const int left,
+        const int above,
+        const int above_left
+    )
+    {
+        const int estimate = left + above - above_left;
+        const int distance_left = std::abs(estimate - left);
+        const int distance_above = std::abs(estimate - above);
+        const int distance_above_left = std::abs(estimate - above_left);
+
+        if (distance_left <= distance_above && 
+            distance_left <= distance_above_left)
+        {
+            return static_cast<unsigned char>(left);
+        }
+        if (distance_above <= distance_above_left)
+        {
+            return static_cast<unsigned char>(above);
+        }
+        return static_cast<unsigned char>(above_left);
+    }
+    int Predict
+    (
+        const unsigned int filter,
+        const int left,
+        const int above,
+        const int above_left
+    )
+    {
+        switch (filter)
+        {
+            case 1: return left;
+            case 2: return above;
+            case 3: return (left + above) / 2;
+            case 4: return Paeth(left, above, above_left);
+            default: return 0;
+        }
+    }
+
+    /**
+     * A horizontal band of the image, compressed into its own IDAT chunk.
+     */
+    struct Stripe
+    {
+        unsigned int begin_row = 0;
+        unsigned int end_row = 0;
+
+        std::vector<unsigned char> chunk;
+        std::uint32_t adler = 1;
+        std::size_t size = 0;
+    };
+    void EncodeStripe
+    (
+        const unsigned char* pixels,
+        const unsigned int height,
+        const std::size_t row_size,
+        const unsigned int channel_count,
+        const bool is_bottom_up,
+        const bool is_first,
+        const bool is_last,
+        Stripe& stripe
+    )
+    {
+        Deflater deflater;
+        Adler32 adler;
+        std::vector<unsigned char> filtered_row(row_size + 1);
+
+        // zlib stream header (deflate, 32K window, no dictionary) goes 
+        // in front of the first stripe.
+        std::vector<unsigned char> stream;
+        if (is_first) { stream = { 0x78, 0x01 }; }
+
+        // Filters look at the previous row of the image, which is 
+        // available regardless of which stripe it belongs to.
+        const unsigned char* previous_row = nullptr;
+        for (unsigned int y = stripe.begin_row; y < stripe.end_row; ++y)
+        {
+            const unsigned int source_y = is_bottom_up ? height - 1 - y : y;
+            const unsigned char* row = &pixels[source_y * row_size];
+
+            if (y > 0)
+            {
+                const unsigned int previous_y = 
+                    is_bottom_up ? source_y + 1 : source_y - 1;
+                previous_row = &pixels[previous_y * row_size];
+            }
+
+            PngEncoder::FilterRow
+            (
+                row, previous_row, 
+                row_size, channel_count, 
+                filtered_row.data()
+            );
+            deflater.Compress(filtered_row.data(), filtered_row.size());
+            adler.Update(filtered_row.data(), filtered_row.size());
+
+            std::vector<unsigned char>& compressed = deflater.output();
+            stream.insert(stream.end(), compressed.begin(), compressed.end());
+            compressed.clear();
+        }
+        if (is_last) { deflater.Finish(); }
+        else         { deflater.Flush(); }
+
+        stream.insert
+        (
+            stream.end(), 
+            deflater.output().begin(), deflater.output().end()
+        );
+        PngEncoder::WriteChunk
+        (
+            "IDAT", stream.data(), stream.size(), stripe.chunk
+        );
+
+        stripe.adler = adler.value();
+        stripe.size = (stripe.end_row - stripe.begin_row) * (row_size + 1);
+    }
+}
+
+const std::size_t PngEncoder::MIN_STRIPE_SIZE = 1 << 20;
+
+PngEncoder::PngEncoder()
+    : PngEncoder(std::thread::hardware_concurrency()) {}
+PngEncoder::PngEncoder(const unsigned int thread_count)
+    : thread_count_(std::max(thread_count, 1U)) {}
+
+void PngEncoder::Encode
+(
+    const unsigned char* pixels,
+    const unsigned int width,
+    const unsigned int height,
+    const unsigned int channel_count,
+    const bool is_bottom_up,
+    std::vector<unsigned char>& output
+) const
+{
+    output.clear();
+    WriteHeader(width, height, channel_count, output);
+
+    const std::size_t row_size = 
+        static_cast<std::size_t>(width) * channel_count;
+
+    // Stripes are kept large enough for the deflater's window to pay off
+    // and for thread startup to be negligible.
+    const std::size_t image_size = row_size * height;
+    const std::size_t stripe_count = std::max<std::size_t>
+    (
+        std::min<std::size_t>
+        (
+            { thread_count_, image_size / MIN_STRIPE_SIZE, height }
+        ),
+        1
+    );
+
+    std::vector<Stripe> stripes(stripe_count);
+    for (std::size_t i = 0; i < stripe_count; ++i)
+    {
+        stripes[i].begin_row = 
+            static_cast<unsigned int>(height * i / stripe_count);
+        stripes[i].end_row = 
+            static_cast<unsigned int>(height * (i + 1) / stripe_count);
+    }
+
+    const auto encode = [&](const std::size_t i)
+    {
+        EncodeStripe
+        (
+            pixels, height, row_size, channel_count, is_bottom_up,
+            i == 0, i + 1 == stripe_count,
+            stripes[i]
+        );
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < stripe_count; ++i)
+    {
+        threads.emplace_back(encode, i);
+    }
+    encode(0);
+    for (std::thread& thread : threads) { thread.join(); }
+
+    std::uint32_t adler = stripes[0].adler;
+    for (std::size_t i = 1; i < stripe_count; ++i)
+    {
+        adler = Adler32::Combine(adler, stripes[i].adler, stripes[i].size);
+    }
+    for (Stripe& stripe : stripes)
+    {
+        output.insert(output.end(), stripe.chunk.begin(), stripe.chunk.end());
+        std::vector<unsigned char>().swap(stripe.chunk);
+    }
+
+    // zlib stream trailer: Adler-32 of the uncompressed data.
+    std::vector<unsigned char> trailer;
+    AppendUint32(adler, trailer);
+    WriteChunk("IDAT", trailer.data(), trailer.size(), output);
+    WriteChunk("IEND", nullptr, 0, output);
+}
+bool PngEncoder::Write
+(
+    const char* path,
+    const unsigned char* pixels,
+    const unsigned int width,
+    const unsigned int height,
+    const unsigned int channel_count,
+    const bool is_bottom_up
+) const
+{
+    std::vector<unsigned char> contents;
+    Encode(pixels, width, height, channel_count, is_bottom_up, contents);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) { return false; }
+
+    file.write
+    (
+        reinterpret_cast<const char*>(contents.data()), 
+        contents.size()
+    );
+    return file.good();
+}
+
+void PngEncoder::WriteHeader
+(
+    const unsigned int width,
+    const unsigned int height,
+    const unsigned int channel_count,
+    std::vector<unsigned char>& output
+)
+{
+    output.insert(output.end(), SIGNATURE, SIGNATURE + 8);
+
+    unsigned char color_type;
+    switch (channel_count)
+    {
+        case 1: color_type = 0; break;
+        case 4: color_type = 6; break;
+        default: color_type = 2; break;
+    }
+
+    std::vector<unsigned char> header;
+    AppendUint32(width, header);
+    AppendUint32(height, header);
+    header.push_back(8);            // bit depth
+    header.push_back(color_type);
+    header.push_back(0);            // compression: deflate
+    header.push_back(0);            // filter method: adaptive
+    header.push_back(0);            // interlace: none
+
+    WriteChunk("IHDR", header.data(), header.size(), output);
+}
+void PngEncoder::WriteChunk
+(
+    const char* type,
+    const unsigned char* data,
+    const std::size_t size,
+    std::vector<unsigned char>& output
+)
+{
+    AppendUint32(static_cast<std::uint32_t>(size), output);
+
+    const std::size_t type_offset = output.size();
+    output.insert(output.end(), type, type + 4);
+    if (size > 0) { output.insert(output.end(), data, data + size); }
+
+    Crc32 crc;
+    crc.Update(&output[type_offset], 4 + size);
+    AppendUint32(crc.value(), output);
+}
+void PngEncoder::FilterRow
+(
+    const unsigned char* row,
+    const unsigned char* previous_row,
+    const std::size_t row_size,
+    const unsigned int pixel_size,
+    unsigned char* output
+)
+{
+    static const unsigned int FILTER_COUNT = 5;
+
+    std::uint64_t best_cost = UINT64_MAX;
+    unsigned int best_filter = 0;
+
+    for (unsigned int filter = 0; filter < FILTER_COUNT; ++filter)
+    {
+        if (previous_row == nullptr && filter >= 2) { break; }
+
+        std::uint64_t cost = 0;
+        for (std::size_t i = 0; i < row_size; ++i)
+        {
+            const int left = i >= pixel_size ? row[i - pixel_size] : 0;
+            const int above = previous_row ? previous_row[i] : 0;
+            const int above_left = 
+                previous_row && i >= pixel_size ? 
+                previous_row[i - pixel_size] : 0;
+
+            const int predicted = 
+                Predict(filter, left, above, above_left);
+            const auto residual = 
+                static_cast<signed char>(row[i] - predicted);
+            cost += std::abs(static_cast<int>(residual));
+        }
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            best_filter = filter;
+        }
+    }
+
+    output[0] = static_cast<unsigned char>(best_filter);
+    for (std::size_t i = 0; i < row_size; ++i)
+    {
+        const int left = i >= pixel_size ? row[i - pixel_size] : 0;
+        const int above = previous_row ? previous_row[i] : 0;
+        const int above_left = 
+            previous_row && i >= pixel_size ? 
+            previous_row[i - pixel_size] : 0;
+
+        const int predicted = 
+            Predict(best_filter, left, above, above_left);
+        output[i + 1] = static_cast<unsigned char>(row[i] - predicted);
+    }
+}
+
+unsigned int PngEncoder::thread_count() const
+{
+    return thread_count_;
+}
@@ -0,0 +1,88 @@
+#include <mandelbrot/PngSink.h>
+
+#include <mandelbrot/PngEncoder.h>
+
+
+using namespace mandelbrot;
+
+
+const std::size_t PngSink::CHUNK_SIZE = 1 << 18;
+
+bool PngSink::WriteHeader()
+{
+    deflater_ = Deflater();
+    adler_ = Adler32();
+
+    const std::size_t row_size =
+        static_cast<std::size_t>(width()) * channel_count();
+
+    previous_row_.clear();
+    filtered_row_.resize(row_size + 1);
+
+    // zlib stream header: deflate, 32K window, no dictionary.
+    stream_ = { 0x78, 0x01 };
+
+    chunk_.clear();
+    PngEncoder::WriteHeader(width(), height(), channel_count(), chunk_);
+    file().write
+    (
+        reinterpret_cast<const char*>(chunk_.data()),
+        chunk_.size()
+    );
+    return file().good();
+}
+bool PngSink::WriteRow(const unsigned char* row)
+{
+    const std::size_t row_size = filtered_row_.size() - 1;
+
+    PngEncoder::FilterRow
+    (
+        row, previous_row_.empty() ? nullptr : previous_row_.data(),
+        row_size, channel_count(),
+        filtered_row_.data()
+    );
+    deflater_.Compress(filtered_row_.data(), filtered_row_.size());
+    adler_.Update(filtered_row_.data(), filtered_row_.size());
+
+    previous_row_.assign(row, row + row_size);
+
+    std::vector<unsigned char>& compressed = deflater_.output();
+    stream_.insert(stream_.end(), compressed.begin(), compressed.end());
+    compressed.clear();
+
+    if (stream_.size() >= CHUNK_SIZE) { return WriteData(false); }
+
+    return true;
+}
+bool PngSink::WriteTrailer()
+{
+    deflater_.Finish();
+    std::vector<unsigned char>& compressed = deflater_.output();
+    stream_.insert(stream_.end(), compressed.begin(), compressed.end());
+    compressed.clear();
+
+    // zlib stream trailer: Adler-32 of the uncompressed data.
+    const std::uint32_t adler = adler_.value();
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        stream_.push_back(static_cast<unsigned char>(adler >> shift));
+    }
+
+    return WriteData(true);
+}
+
+bool PngSink::WriteData(const bool is_final)
+{
+    chunk_.clear();
+    PngEncoder::WriteChunk("IDAT", stream_.data(), stream_.size(), chunk_);
+    stream_.clear();
+
+    if (is_final) { PngEncoder::WriteChunk("IEND", nullptr, 0, chunk_); }
+
+    file().write
+    (
+        reinterpret_cast<const char*>(chunk_.data()),
+        chunk_.size()
+    );
+    return file().good();
+}
@@ -0,0 +1,188 @@
+#include <mandelbrot/PosterRenderer.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <mandelbrot/Stopwatch.h>
+
+#include <oogl/Fence.hpp>
+
+
+using namespace mandelbrot;
+
+
+const unsigned int PosterRenderer::MAX_TILE_SIZE = 1 <<
+    static_cast<unsigned int>(Renderer::Resolution::Size_4096);
+const GLuint64 PosterRenderer::FENCE_TIMEOUT_NANOSECONDS = 1000000;
+
+unsigned int PosterRenderer::GetMaxTileSize()
+{
+    GLint max_texture_size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+    GLint max_render_buffer_size = 0;
+    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &max_render_buffer_size);
+    GLint max_viewport_size[2] { 0, 0 };
+    glGetIntegerv(GL_MAX_VIEWPORT_DIMS, max_viewport_size);
+
+    const unsigned int limit = static_cast<unsigned int>
+    (
+        std::min
+        ({
+            max_texture_size,
+            max_render_buffer_size,
+            max_viewport_size[0],
+            max_viewport_size[1]
+        })
+    );
+
+    return std::max(std::min(limit, MAX_TILE_SIZE), 1U);
+}
+
+PosterRenderer::PosterRenderer(Renderer& renderer)
+    : renderer_(&renderer) {}
+
+bool PosterRenderer::Render
+(
+    const unsigned int first_tile_index,
+    const TileCallback& tile_callback,
+    const ProgressCallback& progress_callback
+)
+{
+    if (first_tile_index >= tile_count()) { return false; }
+
+    unsigned int rendered_count = 0;
+    for (unsigned int i = first_tile_index; i < tile_count(); ++i)
+    {
+        const Tile current_tile = tile(i);
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        RenderTile(current_tile);
+        if (!tile_callback(current_tile)) { return false; }
+
+        stopwatch.Stop();
+        ++ rendered_count;
+
+        if (progress_callback)
+        {
+            progress_callback
+            (
+                current_tile,
+                rendered_count,
+                tile_count() - 1 - i,
+                stopwatch.nanoseconds().count() * 1e-9
+            );
+        }
+    }
+    return true;
+}
+void PosterRenderer::RenderTile(const Tile& tile)
+{
+    renderer_->set_image_size(tile.size);
+    renderer_->set_viewport_position(tile.viewport.position);
+    renderer_->set_viewport_size(tile.viewport.size);
+    renderer_->Reset();
+
+    while (!renderer_->is_done())
+    {
+        renderer_->RenderStep();
+
+        // Keep at most one step queued, so a large tile does not build up
+        // a long command queue the driver may choke on.
+        oogl::Fence step_fence;
+        while (!step_fence.Wait(FENCE_TIMEOUT_NANOSECONDS)) {}
+    }
+    renderer_->Flush();
+}
+
+PosterRenderer::Tile PosterRenderer::tile(const unsigned int index) const
+{
+    const double pixel_size = viewport_size_ / Max(size_);
+
+    Vector2d top_left
+    (
+        viewport_position_.x - 0.5 * size_.x * pixel_size,
+        viewport_position_.y + 0.5 * size_.y * pixel_size
+    );
+    // A symmetric renderer shifts tiles straddling the real axis so that
+    // it falls on a pixel edge or center. Aligning the whole grid that way
+    // leaves no tile to shift.
+    if (renderer_->is_symmetric())
+    {
+        top_left.y = 
+            0.5 * pixel_size * std::round(2 * top_left.y / pixel_size);
+    }
+
+    Tile result;
+    result.index = index;
+    result.column = index % column_count();
+    result.row = index / column_count();
+
+    result.position = Vector2u
+    (
+        result.column * tile_size_,
+        result.row * tile_size_
+    );
+    result.size = Vector2u
+    (
+        std::min(tile_size_, size_.x - result.position.x),
+        std::min(tile_size_, size_.y - result.position.y)
+    );
+
+    result.viewport.size = Max(result.size) * pixel_size;
+    result.viewport.position = Vector2d
+    (
+        top_left.x + (result.position.x + 0.5 * result.size.x) * pixel_size,
+        top_left.y - (result.position.y + 0.5 * result.size.y) * pixel_size
+    );
+
+    return result;
+}
+unsigned int PosterRenderer::tile_count() const
+{
+    return column_count() * row_count();
+}
+unsigned int PosterRenderer::column_count() const
+{
+    return (size_.x + tile_size_ - 1) / tile_size_;
+}
+unsigned int PosterRenderer::row_count() const
+{
+    return (size_.y + tile_size_ - 1) / tile_size_;
+}
+
+const Vector2u& PosterRenderer::size() const
+{
+    return size_;
+}
+void PosterRenderer::set_size(const Vector2u& value)
+{
+    size_ = Vector2u(std::max(value.x, 1U), std::max(value.y, 1U));
+}
+
+unsigned int PosterRenderer::tile_size() const
+{
+    return tile_size_;
+}
+void PosterRenderer::set_tile_size(const unsigned int value)
+{
+    tile_size_ = std::max(std::min(value, MAX_TILE_SIZE), 1U);
+}
+
+const Vector2d& PosterRenderer::viewport_position() const
+{
+    return viewport_position_;
+}
+void PosterRenderer::set_viewport_position(const Vector2d& value)
+{
+    viewport_position_ = value;
+}
+double PosterRenderer::viewport_size() const
+{
+    return viewport_size_;
+}
+void PosterRenderer::set_viewport_size(const double value)
+{
+    viewport_size_ = value;
+}
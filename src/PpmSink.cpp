@@ -0,0 +1,46 @@
+#include <mandelbrot/PpmSink.h>
+
+#include <algorithm>
+
+
+using namespace mandelbrot;
+
+
+bool PpmSink::WriteHeader()
+{
+    const unsigned int output_channel_count = std::min(channel_count(), 3U);
+
+    file() << (output_channel_count == 1 ? "P5" : "P6") << "\n"
+           << width() << " " << height() << "\n"
+           << 255 << "\n";
+
+    row_.resize(static_cast<std::size_t>(width()) * output_channel_count);
+
+    return file().good();
+}
+bool PpmSink::WriteRow(const unsigned char* row)
+{
+    const unsigned int output_channel_count = std::min(channel_count(), 3U);
+
+    const unsigned char* data = row;
+    if (output_channel_count != channel_count())
+    {
+        for (unsigned int x = 0; x < width(); ++x)
+        {
+            std::copy
+            (
+                &row[x * channel_count()],
+                &row[x * channel_count() + output_channel_count],
+                &row_[x * output_channel_count]
+            );
+        }
+        data = row_.data();
+    }
+
+    file().write(reinterpret_cast<const char*>(data), row_.size());
+    return file().good();
+}
+bool PpmSink::WriteTrailer()
+{
+    return true;
+}
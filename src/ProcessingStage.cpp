@@ -1,5 +1,7 @@
 #include <mandelbrot/ProcessingStage.h>
 
+#include <mandelbrot/ShaderLibrary.h>
+
 
 using namespace mandelbrot;
 using namespace oogl;
@@ -17,6 +19,12 @@ const GLfloat ProcessingStage::SCREEN_QUAD_TRIANGLES[2 * 3 * 3]
     -1,  1, 0
 };
 
+ProgramCache& ProcessingStage::program_cache()
+{
+    static ProgramCache cache;
+    return cache;
+}
+
 ProcessingStage::ProcessingStage
 (
     const char* vertex_shader_source_path,
@@ -28,16 +36,115 @@ ProcessingStage::ProcessingStage
 bool ProcessingStage::Initialize()
 {
     CreateAttributes();
-    return InitializeShaders() && InitializeProgram();
+    return SelectProgram(GetDefinitions());
 }
-bool ProcessingStage::InitializeShaders()
+Shader::Definitions ProcessingStage::GetDefinitions() const
+{
+    return Shader::Definitions();
+}
+std::string ProcessingStage::GetVariantName
+(
+    const Shader::Definitions& definitions
+)
+{
+    std::string name;
+    for (const auto& definition : definitions)
+    {
+        if (!name.empty()) { name += " "; }
+        name += definition.first;
+        if (!definition.second.empty()) { name += "=" + definition.second; }
+    }
+    return name;
+}
+bool ProcessingStage::SelectProgram(const Shader::Definitions& definitions)
+{
+    const std::string name = GetVariantName(definitions);
+
+    auto cached = programs_.find(name);
+    if (cached == programs_.end())
+    {
+        std::unique_ptr<Program> program = LoadProgram(definitions);
+        if (program == nullptr) { return false; }
+
+        cached = programs_.emplace(name, std::move(program)).first;
+    }
+
+    program_ = cached->second.get();
+    variant_name_ = name;
+
+    return true;
+}
+std::unique_ptr<Program> ProcessingStage::LoadProgram
+(
+    const Shader::Definitions& definitions
+)
+{
+    std::string vertex_shader_source, fragment_shader_source;
+    if (!ReadSource
+         (
+             vertex_shader_source_path_, 
+             definitions, 
+             vertex_shader_source
+         ) ||
+        !ReadSource
+         (
+             fragment_shader_source_path_, 
+             definitions, 
+             fragment_shader_source
+         ))
+    {
+        return nullptr;
+    }
+
+    ProgramCache& cache = program_cache();
+    const std::string key = ProgramCache::GetKey
+    ({
+        vertex_shader_source, 
+        fragment_shader_source
+    });
+
+    std::unique_ptr<Program> program = cache.Load(key);
+    if (program != nullptr) { return program; }
+
+    if (!InitializeShaders(vertex_shader_source, fragment_shader_source)) 
+    { 
+        return nullptr; 
+    }
+    program = InitializeProgram();
+    if (program != nullptr) { cache.Store(key, *program); }
+
+    return program;
+}
+bool ProcessingStage::ReadSource
+(
+    const std::string& path,
+    const Shader::Definitions& definitions,
+    std::string& source
+)
+{
+    if (!ShaderLibrary::ReadSource(path, source))
+    {
+        status_message_ = "Error reading shader source: " + path;
+        return false;
+    }
+    if (!definitions.empty())
+    {
+        source = Shader::InjectDefinitions(source, definitions);
+    }
+    return true;
+}
+bool ProcessingStage::InitializeShaders
+(
+    const std::string& vertex_shader_source,
+    const std::string& fragment_shader_source
+)
 {
     vertex_shader_ = std::unique_ptr<Shader>
     (
-        Shader::BuildFromPath
+        Shader::BuildFromString
         (
             Shader::Type::Vertex,
-            vertex_shader_source_path_.c_str()
+            vertex_shader_source.c_str()
         )
     );
     if (!vertex_shader_->is_compiled())
@@ -49,10 +156,10 @@ bool ProcessingStage::InitializeShaders()
 
     fragment_shader_ = std::unique_ptr<Shader>
     (
-        Shader::BuildFromPath
+        Shader::BuildFromString
         (
             Shader::Type::Fragment,
-            fragment_shader_source_path_.c_str()
+            fragment_shader_source.c_str()
         )
     );
     if (!fragment_shader_->is_compiled())
@@ -64,28 +171,30 @@ bool ProcessingStage::InitializeShaders()
 
     return true;
 }
-bool ProcessingStage::InitializeProgram()
+std::unique_ptr<Program> ProcessingStage::InitializeProgram()
 {
-    program_ = std::unique_ptr<Program>
+    auto program = std::unique_ptr<Program>
     (
         Program::Build
-        ({
-            vertex_shader_.get(), 
-            fragment_shader_.get()
-        })
+        (
+            {
+                vertex_shader_.get(), 
+                fragment_shader_.get()
+            },
+            !program_cache().directory().empty()
+        )
     );
     
-    if (!program_->is_linked())
-    {
-        status_message_ = "Error initializing program:\n";
-        status_message_ += program_->info_log();
-        return false;
-    }
-
     vertex_shader_.reset();
     fragment_shader_.reset();
 
-    return true;
+    if (!program->is_linked())
+    {
+        status_message_ = "Error initializing program:\n";
+        status_message_ += program->info_log();
+        return nullptr;
+    }
+    return program;
 }
 
 void ProcessingStage::CreateAttributes()
@@ -102,12 +211,22 @@ void ProcessingStage::CreatePositionAttribute()
         VertexBuffer::Binding::Array,
         VertexBuffer::Usage::StaticDraw
     );
-    position_buffer_->Bind();
     position_buffer_->UploadData
     (
         sizeof(SCREEN_QUAD_TRIANGLES),
         SCREEN_QUAD_TRIANGLES
     );
+
+    // The attribute's format and source are recorded by the vertex array.
+    position_buffer_->Bind();
+    VertexArray::EnableAttribute(ATTRIBUTE_POSITION_INDEX);
+    glVertexAttribPointer
+    (
+        ATTRIBUTE_POSITION_INDEX,
+        3, GL_FLOAT, GL_FALSE,
+        0, 0
+    );
+    Instrumentation::RecordCall("glVertexAttribPointer");
 }
 
 void ProcessingStage::Execute()
@@ -117,23 +236,30 @@ void ProcessingStage::Execute()
 }
 void ProcessingStage::DrawScreenQuad()
 {
-    vertex_array_->Bind();
-    VertexArray::EnableAttribute(ATTRIBUTE_POSITION_INDEX);
-    glVertexAttribPointer
-    (
-        ATTRIBUTE_POSITION_INDEX,
-        3, GL_FLOAT, GL_FALSE,
-        0, 0
-    );
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    VertexArray::DisableAttribute(ATTRIBUTE_POSITION_INDEX);
+    vertex_array_->Draw(GL_TRIANGLES, 0, 6);
 }
 
 bool ProcessingStage::is_ready() const
 {
-    return program_->is_linked();
+    return program_ != nullptr && program_->is_linked();
 }
 const char* ProcessingStage::status_message() const
 { 
     return status_message_.c_str(); 
 }
+const char* ProcessingStage::variant_name() const
+{
+    return variant_name_.c_str();
+}
+const TexturePool& ProcessingStage::texture_pool() const
+{
+    return texture_pool_;
+}
+GpuTimer& ProcessingStage::timer()
+{
+    return timer_;
+}
+const GpuTimer& ProcessingStage::timer() const
+{
+    return timer_;
+}
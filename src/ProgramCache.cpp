@@ -0,0 +1,166 @@
+#include <mandelbrot/ProgramCache.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+#include <direct.h>
+
+#include <mandelbrot/Checksum.h>
+
+
+using namespace mandelbrot;
+using namespace oogl;
+
+
+const char* ProgramCache::DEFAULT_DIRECTORY = "shader_cache";
+const char ProgramCache::MAGIC[4] = { 'M', 'B', 'P', 'B' };
+
+std::string ProgramCache::GetKey(const std::vector<std::string>& sources)
+{
+    std::string contents;
+    for (const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+    {
+        const GLubyte* value = glGetString(name);
+        if (value != nullptr) 
+        { 
+            contents += reinterpret_cast<const char*>(value); 
+        }
+        contents += '\0';
+    }
+    for (const std::string& source : sources)
+    {
+        contents += source;
+        contents += '\0';
+    }
+
+    const auto data = reinterpret_cast<const unsigned char*>(contents.data());
+    Crc32 crc;
+    crc.Update(data, contents.size());
+    Adler32 adler;
+    adler.Update(data, contents.size());
+
+    std::ostringstream key;
+    key << std::hex << std::setfill('0') 
+        << std::setw(8) << crc.value() 
+        << std::setw(8) << adler.value();
+    return key.str();
+}
+
+std::unique_ptr<Program> ProgramCache::Load(const std::string& key)
+{
+    if (directory_.empty()) 
+    { 
+        ++ miss_count_;
+        return nullptr; 
+    }
+
+    std::ifstream file(GetPath(key), std::ios::binary);
+    if (!file.is_open())
+    {
+        ++ miss_count_;
+        return nullptr;
+    }
+
+    char magic[sizeof(MAGIC)];
+    GLenum format;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&format), sizeof(format));
+    if (!file.good() || !std::equal(magic, magic + sizeof(MAGIC), MAGIC))
+    {
+        ++ miss_count_;
+        return nullptr;
+    }
+
+    const std::vector<char> binary
+    (
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>()
+    );
+    if (binary.empty())
+    {
+        ++ miss_count_;
+        return nullptr;
+    }
+
+    auto program = std::unique_ptr<Program>
+    (
+        Program::BuildFromBinary
+        (
+            format, 
+            binary.data(), 
+            static_cast<GLsizei>(binary.size())
+        )
+    );
+    if (!program->is_linked())
+    {
+        ++ miss_count_;
+        return nullptr;
+    }
+
+    ++ hit_count_;
+    return program;
+}
+void ProgramCache::Store(const std::string& key, const Program& program)
+{
+    if (directory_.empty()) { return; }
+
+    GLenum format;
+    std::vector<unsigned char> binary;
+    if (!program.GetBinary(format, binary)) { return; }
+
+    // Fails harmlessly if the directory exists.
+    _mkdir(directory_.c_str());
+
+    // Written aside and renamed, so a concurrent launch never loads a 
+    // partial binary.
+    const std::string path = GetPath(key);
+    const std::string temporary_path = path + ".tmp";
+    {
+        std::ofstream file(temporary_path, std::ios::binary);
+        file.write(MAGIC, sizeof(MAGIC));
+        file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+        file.write
+        (
+            reinterpret_cast<const char*>(binary.data()), 
+            binary.size()
+        );
+        if (!file.good())
+        {
+            file.close();
+            std::remove(temporary_path.c_str());
+            return;
+        }
+    }
+    std::remove(path.c_str());
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary_path.c_str());
+    }
+}
+
+std::string ProgramCache::GetPath(const std::string& key) const
+{
+    return directory_ + "/" + key + ".bin";
+}
+
+std::string ProgramCache::directory() const
+{
+    return directory_;
+}
+void ProgramCache::set_directory(const std::string& value)
+{
+    directory_ = value;
+}
+
+unsigned int ProgramCache::hit_count() const
+{
+    return hit_count_;
+}
+unsigned int ProgramCache::miss_count() const
+{
+    return miss_count_;
+}
@@ -1,11 +1,20 @@
 #include <mandelbrot\Renderer.h>
 
+#include <cmath>
+
+#include <mandelbrot/Tracer.h>
+
 
 using namespace mandelbrot;
 using namespace oogl;
 
 
 bool Renderer::Initialize()
+{
+    return InitializeComputation() && 
+           InitializeDisplay();
+}
+bool Renderer::InitializeComputation()
 {
     if (!computation_stage_.Initialize())
     {
@@ -19,12 +28,6 @@ bool Renderer::Initialize()
                           coloring_stage_.status_message();
         return false;
     }
-    if (!display_stage_.Initialize())
-    {
-        status_message_ = std::string("Caching stage:\n") +
-                          display_stage_.status_message();
-        return false;
-    }
 
     const unsigned int max_iteration_count = 
         max_step_count_ * iterations_per_step();
@@ -33,19 +36,92 @@ bool Renderer::Initialize()
 
     return true;
 }
+bool Renderer::InitializeDisplay()
+{
+    if (!display_stage_.Initialize())
+    {
+        status_message_ = std::string("Caching stage:\n") +
+                          display_stage_.status_message();
+        return false;
+    }
+    if (!hud_stage_.Initialize())
+    {
+        status_message_ = std::string("HUD stage:\n") +
+                          hud_stage_.status_message();
+        return false;
+    }
+    return true;
+}
 
 void Renderer::Reset()
 {
-    computation_stage_.Reset();
+    computation_needs_reset_ = true;
     step_count_ = 0;
+
+    // Cost cached before the reset is not to be paired with the images
+    // that follow it.
+    display_stage_.InvalidateCostCache();
 }
 void Renderer::RenderStep()
 {
-    computation_stage_.Execute();
+    const Tracer::Zone zone("RenderStep", true);
+
+    if (BeginStep()) { ExecuteCpuStep(); }
+    EndStep();
+}
+bool Renderer::BeginStep()
+{
+    if (computation_needs_reset_)
+    {
+        computation_stage_.Reset();
+        computation_needs_reset_ = false;
+    }
+    if (computation_stage_.mode() == ComputationStage::Mode::Cpu)
+    {
+        computation_stage_.PrepareCpuStep();
+        return true;
+    }
+    {
+        const GpuTimer::Scope timing(computation_stage_.timer());
+        computation_stage_.Execute();
+    }
+    return false;
+}
+void Renderer::ExecuteCpuStep()
+{
+    const Tracer::Zone zone("ExecuteCpuStep");
+
+    computation_stage_.ExecuteCpuStep();
+}
+bool Renderer::EndStep()
+{
+    if (computation_needs_reset_) { return false; }
+
+    if (computation_stage_.mode() == ComputationStage::Mode::Cpu)
+    {
+        computation_stage_.FinishCpuStep();
+    }
     ++ step_count_;
+    iteration_count_ += 
+        static_cast<unsigned long long>(image_size().x) * image_size().y *
+        iterations_per_step();
+
+    return true;
 }
 void Renderer::Flush()
 {
+    const Tracer::Zone zone("Flush", true);
+
+    Color();
+    UpdateCache();
+}
+void Renderer::Color()
+{
+    const Tracer::Zone zone("Color", true);
+
+    computation_stage_.UploadCpuResults();
+    computation_stage_.Mirror();
+
     coloring_stage_.set_value_texture
     (
         computation_stage_.value_texture()
@@ -54,37 +130,69 @@ void Renderer::Flush()
     (
         computation_stage_.lifetime_texture()
     );
-    coloring_stage_.Execute();
+    coloring_stage_.set_cost_texture(computation_stage_.cost_texture());
+    {
+        const GpuTimer::Scope timing(coloring_stage_.timer());
+        coloring_stage_.Execute();
+    }
+
+    colored_viewport_ = computation_stage_.computed_viewport();
+}
+void Renderer::UpdateCache()
+{
+    const Tracer::Zone zone("UpdateCache", true);
 
     display_stage_.UpdateCache
     (
         coloring_stage_.colored_texture(),
-        viewport().position,
-        viewport().size
+        colored_viewport_.position,
+        colored_viewport_.size
     );
+
+    const Texture* cost = computation_stage_.cost_texture();
+    if (cost != nullptr) { display_stage_.UpdateCostCache(*cost); }
 }
 void Renderer::Render()
 {
+    const Tracer::Zone zone("Render", true);
+
+    const Vector2d image_extent = 
+        display_stage_.viewport().size * 
+        Proportions(display_image_size());
+    const Vector2d display_extent = 
+        viewport().size * 
+        Proportions(display_size());
+
     display_stage_.set_relative_position_offset
     (
         (
             viewport().position - 
             display_stage_.viewport().position
         ) / 
-        display_stage_.viewport().size
+        image_extent
     );
     display_stage_.set_relative_size_offset
     (
-        viewport().size /
-        display_stage_.viewport().size
+        display_extent / 
+        image_extent
     );
-    display_stage_.Execute();
+    {
+        const GpuTimer::Scope timing(display_stage_.timer());
+        display_stage_.Execute();
+    }
+    if (hud_stage_.is_visible())
+    {
+        const GpuTimer::Scope timing(hud_stage_.timer());
+        hud_stage_.Execute();
+    }
 }
 
 void Renderer::GetImagePixels(unsigned char* buffer)
 {
     Texture& image = display_stage_.image();
-    image.Bind();
+
+    // Rows of arbitrary width are tightly packed.
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
     image.DownloadData
     (
         0,
@@ -92,12 +200,63 @@ void Renderer::GetImagePixels(unsigned char* buffer)
         buffer
     );
 }
+bool Renderer::GetCostMap(CostMap& map)
+{
+    const Texture* cost = display_stage_.cost();
+    if (!shows_cost() || cost == nullptr) { return false; }
+
+    map.Resize(Vector2u(cost->width(), cost->height()));
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    cost->DownloadData
+    (
+        0,
+        GL_RED_INTEGER, GL_UNSIGNED_INT,
+        map.data()
+    );
+    return true;
+}
+bool Renderer::ReadImagePixels
+(
+    PixelReader& reader,
+    const PixelReader::Callback& callback
+)
+{
+    return reader.Read(display_stage_.image(), callback);
+}
+
+bool Renderer::WriteImageTile
+(
+    ImageSink& sink,
+    const unsigned int width,
+    const unsigned int height
+)
+{
+    Texture& image = display_stage_.image();
+    const Vector2u size(image.width(), image.height());
+    if (width > size.x || height > size.y) { return false; }
+
+    std::vector<unsigned char> pixels
+    (
+        static_cast<std::size_t>(size.x) * size.y * 
+        PixelReader::CHANNEL_COUNT
+    );
+    GetImagePixels(pixels.data());
+
+    // Rows are bottom-up, so the top rows are found at the end.
+    const std::size_t top_offset = 
+        static_cast<std::size_t>(size.y - height) * size.x * 
+        PixelReader::CHANNEL_COUNT;
+
+    return sink.WriteTile(&pixels[top_offset], width, height, size.x, true);
+}
 
 bool Renderer::is_ready() const
 {
     return computation_stage_.is_ready() &&
            coloring_stage_.is_ready() &&
-           display_stage_.is_ready();
+           display_stage_.is_ready() &&
+           hud_stage_.is_ready();
 }
 const char* Renderer::status_message() const
 { 
@@ -108,6 +267,14 @@ bool Renderer::is_done() const
 {
     return step_count_ >= max_step_count_;
 }
+unsigned int Renderer::step_count() const
+{
+    return step_count_;
+}
+unsigned long long Renderer::iteration_count() const
+{
+    return iteration_count_;
+}
 
 const Vector2u& Renderer::display_size() const
 {
@@ -116,23 +283,18 @@ const Vector2u& Renderer::display_size() const
 void Renderer::set_display_size(const Vector2u& value)
 {
     display_stage_.set_display_size(value);
+    hud_stage_.set_display_size(value);
+    UpdateImageSize();
 }
 
 unsigned int Renderer::resolution() const
 {
-    return computation_stage_.resolution();
+    return resolution_;
 }
 void Renderer::set_resolution(unsigned int value)
 {
-    unsigned int resolution = 2;
-    unsigned int resolution_power = 1;
-    while (2 * resolution <= value)
-    {
-        ++ resolution_power;
-        resolution *= 2;
-    }
-    computation_stage_.set_resolution_power(resolution_power);
-    coloring_stage_.set_texture_size(resolution);
+    resolution_ = std::max(value, 1U);
+    UpdateImageSize();
 }
 void Renderer::set_resolution(const Resolution power)
 {
@@ -143,6 +305,36 @@ void Renderer::set_resolution(const Resolution power)
     set_resolution(value);
 }
 
+const Vector2u& Renderer::image_size() const
+{
+    return computation_stage_.size();
+}
+void Renderer::set_image_size(const Vector2u& value)
+{
+    computation_stage_.set_size(value);
+    coloring_stage_.set_texture_size(computation_stage_.size());
+    Reset();
+}
+void Renderer::UpdateImageSize()
+{
+    const Vector2u& display = display_size();
+    if (display.x == 0 || display.y == 0) 
+    {
+        set_image_size(Vector2u(resolution_, resolution_));
+        return;
+    }
+
+    const Vector2d proportions = Proportions(display);
+    set_image_size
+    (
+        Vector2u
+        (
+            static_cast<unsigned int>(std::round(resolution_ * proportions.x)),
+            static_cast<unsigned int>(std::round(resolution_ * proportions.y))
+        )
+    );
+}
+
 const ColorArray& Renderer::color_map() const
 {
     return coloring_stage_.color_map();
@@ -161,6 +353,69 @@ void Renderer::set_iterations_per_step(const unsigned int value)
     computation_stage_.set_iterations_per_step(value);
 }
 
+ComputationStage::Precision Renderer::precision() const
+{
+    return computation_stage_.precision();
+}
+void Renderer::set_precision(const ComputationStage::Precision value)
+{
+    computation_stage_.set_precision(value);
+    Reset();
+}
+double Renderer::escape_radius() const
+{
+    return computation_stage_.escape_radius();
+}
+void Renderer::set_escape_radius(const double value)
+{
+    computation_stage_.set_escape_radius(value);
+    coloring_stage_.set_escape_radius(computation_stage_.escape_radius());
+    Reset();
+}
+bool Renderer::detects_interior() const
+{
+    return computation_stage_.detects_interior();
+}
+void Renderer::set_detects_interior(const bool value)
+{
+    computation_stage_.set_detects_interior(value);
+    Reset();
+}
+const char* Renderer::computation_variant_name() const
+{
+    return computation_stage_.variant_name();
+}
+TexturePool::Statistics Renderer::texture_pool_statistics() const
+{
+    TexturePool::Statistics statistics;
+    statistics += computation_stage_.texture_pool().statistics();
+    statistics += coloring_stage_.texture_pool().statistics();
+    statistics += display_stage_.texture_pool().statistics();
+    statistics += hud_stage_.texture_pool().statistics();
+    return statistics;
+}
+std::vector<Renderer::StageTime> Renderer::stage_times() const
+{
+    return
+    {
+        { "Computation", computation_stage_.timer().statistics() },
+        { "Coloring", coloring_stage_.timer().statistics() },
+        { "Display", display_stage_.timer().statistics() }
+    };
+}
+void Renderer::ClearStageTimes()
+{
+    computation_stage_.timer().Clear();
+    coloring_stage_.timer().Clear();
+    display_stage_.timer().Clear();
+}
+void Renderer::FinishStageTimes()
+{
+    computation_stage_.timer().Finish();
+    coloring_stage_.timer().Finish();
+    display_stage_.timer().Finish();
+}
+
 unsigned int Renderer::max_step_count() const
 {
     return max_step_count_;
@@ -175,6 +430,61 @@ void Renderer::set_max_step_count(const unsigned int value)
     coloring_stage_.set_max_lifetime(max_iteration_count);
 }
 
+bool Renderer::is_symmetric() const
+{
+    return computation_stage_.is_symmetric();
+}
+void Renderer::set_is_symmetric(const bool value)
+{
+    computation_stage_.set_is_symmetric(value);
+    Reset();
+}
+
+ComputationStage::Mode Renderer::computation_mode() const
+{
+    return computation_stage_.mode();
+}
+void Renderer::set_computation_mode(const ComputationStage::Mode value)
+{
+    computation_stage_.set_mode(value);
+    Reset();
+}
+bool Renderer::is_proven_only() const
+{
+    return computation_stage_.is_proven_only();
+}
+void Renderer::set_is_proven_only(const bool value)
+{
+    computation_stage_.set_is_proven_only(value);
+    Reset();
+}
+double Renderer::proven_fraction() const
+{
+    return computation_stage_.proven_fraction();
+}
+bool Renderer::counts_active_pixels() const
+{
+    return computation_stage_.counts_active_pixels();
+}
+void Renderer::set_counts_active_pixels(const bool value)
+{
+    computation_stage_.set_counts_active_pixels(value);
+}
+double Renderer::active_fraction() const
+{
+    return computation_stage_.active_fraction();
+}
+bool Renderer::shows_cost() const
+{
+    return computation_stage_.records_cost();
+}
+void Renderer::set_shows_cost(const bool value)
+{
+    computation_stage_.set_records_cost(value);
+    if (!value) { display_stage_.ReleaseCostCache(); }
+    Reset();
+}
+
 const Box2d& Renderer::viewport() const
 {
     return computation_stage_.viewport();
@@ -191,3 +501,17 @@ const Box2d& Renderer::display_viewport() const
 {
     return display_stage_.viewport();
 }
+Vector2u Renderer::display_image_size() const
+{
+    const Texture& image = display_stage_.image();
+    return Vector2u(image.width(), image.height());
+}
+
+const HudStage& Renderer::hud() const
+{
+    return hud_stage_;
+}
+HudStage& Renderer::hud()
+{
+    return hud_stage_;
+}
@@ -0,0 +1,37 @@
+#include <mandelbrot/ShaderLibrary.h>
+
+#include <oogl/io.hpp>
+
+
+using namespace mandelbrot;
+
+
+// Generated by msvc/EmbedShaders.ps1 before each build.
+const ShaderLibrary::Entry ShaderLibrary::EMBEDDED_SOURCES[] =
+{
+    #include <EmbeddedShaders.inc>
+};
+
+bool ShaderLibrary::ReadSource(const std::string& path, std::string& source)
+{
+    const Entry* entry = Find(path);
+    if (entry != nullptr)
+    {
+        source = entry->source;
+        return true;
+    }
+    return oogl::io::ReadFile(path.c_str(), source);
+}
+
+const ShaderLibrary::Entry* ShaderLibrary::Find(const std::string& path)
+{
+    const std::size_t separator = path.find_last_of("/\\");
+    const std::string name = 
+        separator == std::string::npos ? path : path.substr(separator + 1);
+
+    for (const Entry& entry : EMBEDDED_SOURCES)
+    {
+        if (name == entry.name) { return &entry; }
+    }
+    return nullptr;
+}
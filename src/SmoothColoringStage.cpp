@@ -14,6 +14,7 @@ const char* SmoothColoringStage::FRAGMENT_SHADER_SOURCE_PATH =
 const GLint SmoothColoringStage::VALUE_TEXTURE_UNIT_INDEX = 0;
 const GLint SmoothColoringStage::LIFETIME_TEXTURE_UNIT_INDEX = 1;
 const GLint SmoothColoringStage::LIFETIME_COLOR_MAP_TEXTURE_UNIT_INDEX = 2;
+const GLint SmoothColoringStage::COST_TEXTURE_UNIT_INDEX = 3;
 
 const unsigned char SmoothColoringStage::DEFAULT_COLOR_MAP_DATA[3 * 8] = 
 {
@@ -49,7 +50,6 @@ bool SmoothColoringStage::InitializeTextures()
         Texture::Binding::Texture1D,
         GL_RGB, color_map_.size(), 1
     );
-    in_lifetime_color_map_texture_->Bind();
     in_lifetime_color_map_texture_->Resize(color_map_.size(), 1);
     in_lifetime_color_map_texture_->UploadData
     (
@@ -59,19 +59,24 @@ bool SmoothColoringStage::InitializeTextures()
     );
     in_lifetime_color_map_texture_->set_filters(Texture::Filter::Nearest);
 
-    out_colored_texture_ = std::make_unique<Texture>
+    // Room for the previous size's textures, to toggle back without 
+    // allocating.
+    texture_pool_.set_capacity(2);
+
+    out_colored_texture_ = texture_pool_.Acquire
     (
         Texture::Binding::Texture2D,
-        GL_RGB, 1, 1
+        GL_RGB8, 
+        texture_size_.x, texture_size_.y
     );
-    out_colored_texture_->Bind();
-    out_colored_texture_->UploadData
+    out_colored_texture_->set_filters(Texture::Filter::Nearest);
+
+    depth_texture_ = texture_pool_.Acquire
     (
-        0,
-        GL_RGB, GL_UNSIGNED_BYTE,
-        nullptr
+        Texture::Binding::Texture2D,
+        GL_DEPTH_COMPONENT24, 
+        texture_size_.x, texture_size_.y
     );
-    out_colored_texture_->set_filters(Texture::Filter::Nearest);
 
     return true;
 }
@@ -80,18 +85,9 @@ bool SmoothColoringStage::InitializeBuffers()
     frame_buffer_ = std::make_unique<FrameBuffer>();
     frame_buffer_->Bind();
 
-    depth_render_buffer_ = std::make_unique<RenderBuffer>();
-    depth_render_buffer_->Bind();
-    RenderBuffer::DefineStorage
-    (
-        GL_DEPTH_COMPONENT, 
-        out_colored_texture_->width(), 
-        out_colored_texture_->height()
-    );
-
-    frame_buffer_->AttachRenderBuffer
+    frame_buffer_->AttachTexture
     (
-        *depth_render_buffer_, 
+        *depth_texture_, 
         GL_DEPTH_ATTACHMENT
     );
     frame_buffer_->AttachTexture
@@ -131,14 +127,26 @@ bool SmoothColoringStage::InitializeUniforms()
         program_->GetVectorUniform<GLint, 1>("max_lifetime");
     uniform_max_lifetime_.set(max_lifetime_);
 
+    uniform_escape_radius_ = 
+        program_->GetVectorUniform<GLfloat, 1>("escape_radius");
+
+    // Only in the heatmap variant, which leaves the others unused.
+    uniform_cost_texture_ = 
+        program_->GetVectorUniform<GLint, 1>("cost_texture");
+    uniform_cost_texture_
+        .set(COST_TEXTURE_UNIT_INDEX);
+
     return uniform_value_texture_.is_valid() &&
            uniform_lifetime_texture_.is_valid() &&
            uniform_lifetime_color_map_texture_.is_valid() &&
-           uniform_max_lifetime_.is_valid();
+           uniform_max_lifetime_.is_valid() &&
+           uniform_escape_radius_.is_valid();
 }
 
 void SmoothColoringStage::Execute()
 {
+    UpdateProgram();
+
     program_->Use();
     frame_buffer_->Bind();
     
@@ -155,25 +163,68 @@ void SmoothColoringStage::Execute()
         ->BindToUnit(LIFETIME_TEXTURE_UNIT_INDEX);
     in_lifetime_color_map_texture_
         ->BindToUnit(LIFETIME_COLOR_MAP_TEXTURE_UNIT_INDEX);
+    if (in_cost_texture_ != nullptr)
+    {
+        in_cost_texture_->BindToUnit(COST_TEXTURE_UNIT_INDEX);
+    }
 
-    glViewport(0, 0, texture_size_, texture_size_);
+    glViewport(0, 0, texture_size_.x, texture_size_.y);
 
     DrawScreenQuad();
 }
 
+Shader::Definitions SmoothColoringStage::GetDefinitions() const
+{
+    Shader::Definitions definitions;
+    if (in_cost_texture_ != nullptr)
+    {
+        definitions["COST_HEATMAP"] = "";
+    }
+    return definitions;
+}
+void SmoothColoringStage::UpdateProgram()
+{
+    if (!variant_needs_update_) { return; }
+
+    const Program* previous_program = program_;
+    if (SelectProgram(GetDefinitions()) && program_ != previous_program)
+    {
+        // Uniform locations and values belong to the program.
+        InitializeUniforms();
+        escape_radius_needs_update_ = true;
+    }
+    variant_needs_update_ = false;
+}
+
 void SmoothColoringStage::UpdateTextureSize()
 {
     if (!texture_size_needs_update_) { return; }
 
-    out_colored_texture_->Bind();
-    out_colored_texture_->Resize(texture_size_, texture_size_);
-
-    depth_render_buffer_->Bind();
-    RenderBuffer::DefineStorage
-    (
-        GL_DEPTH_COMPONENT, 
-        texture_size_, texture_size_
-    );
+    if (texture_pool_.Resize
+        (
+            out_colored_texture_, 
+            texture_size_.x, texture_size_.y
+        ))
+    {
+        out_colored_texture_->set_filters(Texture::Filter::Nearest);
+        frame_buffer_->AttachTexture
+        (
+            *out_colored_texture_, 
+            GL_COLOR_ATTACHMENT0
+        );
+    }
+    if (texture_pool_.Resize
+        (
+            depth_texture_, 
+            texture_size_.x, texture_size_.y
+        ))
+    {
+        frame_buffer_->AttachTexture
+        (
+            *depth_texture_, 
+            GL_DEPTH_ATTACHMENT
+        );
+    }
 
     texture_size_needs_update_ = false;
 }
@@ -181,7 +232,6 @@ void SmoothColoringStage::UpdateColorMap()
 {
     if (!color_map_needs_update_) { return; }
 
-    in_lifetime_color_map_texture_->Bind();
     in_lifetime_color_map_texture_->Resize(color_map_.size(), 1);
     in_lifetime_color_map_texture_->UploadData
     (
@@ -199,10 +249,17 @@ void SmoothColoringStage::UpdateUniforms()
         uniform_max_lifetime_.set(max_lifetime_);
         max_lifetime_needs_update_ = false;
     }
+    if (escape_radius_needs_update_)
+    {
+        uniform_escape_radius_.set(static_cast<GLfloat>(escape_radius_));
+        escape_radius_needs_update_ = false;
+    }
 }
 
-void SmoothColoringStage::set_texture_size(const GLint value)
+void SmoothColoringStage::set_texture_size(const Vector2u& value)
 {
+    if (value.x == texture_size_.x && value.y == texture_size_.y) { return; }
+
     texture_size_ = value;
     texture_size_needs_update_ = true;
 }
@@ -215,6 +272,14 @@ void SmoothColoringStage::set_lifetime_texture(Texture& value)
 {
     in_lifetime_texture_ = &value;
 }
+void SmoothColoringStage::set_cost_texture(Texture* value)
+{
+    if ((value == nullptr) != (in_cost_texture_ == nullptr))
+    {
+        variant_needs_update_ = true;
+    }
+    in_cost_texture_ = value;
+}
 
 const ColorArray& SmoothColoringStage::color_map() const
 {
@@ -235,6 +300,12 @@ void SmoothColoringStage::set_max_lifetime(const GLint value)
     max_lifetime_needs_update_ = true;
 }
 
+void SmoothColoringStage::set_escape_radius(const double value)
+{
+    escape_radius_ = value;
+    escape_radius_needs_update_ = true;
+}
+
 const Texture& SmoothColoringStage::colored_texture() const
 {
     return *out_colored_texture_;
@@ -0,0 +1,199 @@
+#include <mandelbrot/SnapshotWriter.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <soil/soil.h>
+
+#include <mandelbrot/PngEncoder.h>
+
+
+using namespace mandelbrot;
+
+
+const unsigned int SnapshotWriter::DEFAULT_THREAD_COUNT = 2;
+const unsigned int SnapshotWriter::DEFAULT_BUFFER_COUNT = 4;
+const unsigned int SnapshotWriter::CHANNEL_COUNT = 3;
+
+SnapshotWriter::Format SnapshotWriter::GetFormat(const std::string& path)
+{
+    const std::string extension = GetExtension(Format::Png);
+    const bool is_png = 
+        path.size() >= extension.size() &&
+        path.compare
+        (
+            path.size() - extension.size(), extension.size(), 
+            extension
+        ) == 0;
+
+    return is_png ? Format::Png : Format::Bmp;
+}
+const char* SnapshotWriter::GetExtension(const Format format)
+{
+    return format == Format::Png ? ".png" : ".bmp";
+}
+
+SnapshotWriter::SnapshotWriter()
+    : SnapshotWriter(DEFAULT_THREAD_COUNT, DEFAULT_BUFFER_COUNT) {}
+SnapshotWriter::SnapshotWriter
+(
+    const unsigned int thread_count,
+    const unsigned int buffer_count
+)
+    : free_buffers_(std::max(buffer_count, 1U))
+{
+    for (unsigned int i = 0; i < std::max(thread_count, 1U); ++i)
+    {
+        threads_.emplace_back(&SnapshotWriter::Run, this);
+    }
+}
+SnapshotWriter::~SnapshotWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        is_running_ = false;
+    }
+    job_condition_.notify_all();
+
+    for (std::thread& thread : threads_) { thread.join(); }
+}
+
+bool SnapshotWriter::WriteImage
+(
+    const std::string& path,
+    const unsigned char* pixels,
+    const unsigned int width,
+    const unsigned int height
+)
+{
+    std::vector<unsigned char> buffer;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (free_buffers_.empty()) { return false; }
+
+        buffer = std::move(free_buffers_.back());
+        free_buffers_.pop_back();
+    }
+
+    // Copy outside the lock; the buffer keeps its capacity across uses, 
+    // so this does not allocate in steady state.
+    const std::size_t size = 
+        static_cast<std::size_t>(CHANNEL_COUNT) * width * height;
+    buffer.resize(size);
+    std::memcpy(buffer.data(), pixels, size);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        jobs_.push_back(Job { path, true, std::move(buffer), width, height });
+    }
+    job_condition_.notify_one();
+
+    return true;
+}
+void SnapshotWriter::WriteText
+(
+    const std::string& path,
+    const std::string& text
+)
+{
+    WriteData(path, std::vector<unsigned char>(text.begin(), text.end()));
+}
+void SnapshotWriter::WriteData
+(
+    const std::string& path,
+    std::vector<unsigned char> data
+)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        jobs_.push_back(Job { path, false, std::move(data), 0, 0 });
+    }
+    job_condition_.notify_one();
+}
+
+bool SnapshotWriter::PollReport(Report& report)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (reports_.empty()) { return false; }
+
+    report = reports_.front();
+    reports_.pop_front();
+
+    return true;
+}
+void SnapshotWriter::Finish()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_condition_.wait(lock, [this]
+    {
+        return jobs_.empty() && active_job_count_ == 0;
+    });
+}
+
+void SnapshotWriter::set_notifier(const std::function<void()>& value)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    notifier_ = value;
+}
+
+void SnapshotWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        job_condition_.wait(lock, [this]
+        {
+            return !is_running_ || !jobs_.empty();
+        });
+        if (jobs_.empty()) { break; }
+
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        ++ active_job_count_;
+
+        lock.unlock();
+        const bool is_successful = Execute(job);
+        lock.lock();
+
+        if (job.is_image) { free_buffers_.push_back(std::move(job.data)); }
+        reports_.push_back(Report { job.path, is_successful });
+        -- active_job_count_;
+
+        if (notifier_) { notifier_(); }
+        idle_condition_.notify_all();
+    }
+}
+bool SnapshotWriter::Execute(const Job& job) const
+{
+    if (!job.is_image)
+    {
+        std::ofstream file(job.path, std::ios::binary);
+        if (!file.is_open()) { return false; }
+
+        file.write
+        (
+            reinterpret_cast<const char*>(job.data.data()), 
+            job.data.size()
+        );
+        return file.good();
+    }
+
+    if (GetFormat(job.path) == Format::Png)
+    {
+        return PngEncoder().Write
+        (
+            job.path.c_str(), 
+            job.data.data(),
+            job.width, job.height, 
+            CHANNEL_COUNT,
+            true
+        );
+    }
+    return SOIL_save_image
+    (
+        job.path.c_str(), SOIL_SAVE_TYPE_BMP,
+        job.width, job.height, CHANNEL_COUNT,
+        job.data.data()
+    ) != 0;
+}
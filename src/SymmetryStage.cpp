@@ -0,0 +1,123 @@
+#include <mandelbrot/SymmetryStage.h>
+
+
+using namespace mandelbrot;
+using namespace oogl;
+
+
+const char* SymmetryStage::VERTEX_SHADER_SOURCE_PATH =
+    "../src/shaders/symmetryVertexShader.glsl";
+const char* SymmetryStage::FRAGMENT_SHADER_SOURCE_PATH =
+    "../src/shaders/symmetryFragmentShader.glsl";
+
+const GLint SymmetryStage::VALUE_TEXTURE_UNIT_INDEX = 0;
+const GLint SymmetryStage::LIFETIME_TEXTURE_UNIT_INDEX = 1;
+
+SymmetryStage::SymmetryStage()
+    : ProcessingStage
+      (
+          VERTEX_SHADER_SOURCE_PATH,
+          FRAGMENT_SHADER_SOURCE_PATH
+      ) {}
+
+bool SymmetryStage::Initialize()
+{
+    return ProcessingStage::Initialize() &&
+           InitializeBuffers() &&
+           InitializeUniforms();
+}
+bool SymmetryStage::InitializeBuffers()
+{
+    frame_buffer_ = std::make_unique<FrameBuffer>();
+    return true;
+}
+bool SymmetryStage::InitializeUniforms()
+{
+    program_->Use();
+
+    uniform_value_texture_ =
+        program_->GetVectorUniform<GLint, 1>("value_texture");
+    uniform_value_texture_.set(VALUE_TEXTURE_UNIT_INDEX);
+
+    uniform_lifetime_texture_ =
+        program_->GetVectorUniform<GLint, 1>("lifetime_texture");
+    uniform_lifetime_texture_.set(LIFETIME_TEXTURE_UNIT_INDEX);
+
+    uniform_mirrored_rows_ =
+        program_->GetVectorUniform<GLint, 2>("mirrored_rows");
+    uniform_mirror_axis_ =
+        program_->GetVectorUniform<GLint, 1>("mirror_axis");
+
+    return uniform_value_texture_.is_valid() &&
+           uniform_lifetime_texture_.is_valid() &&
+           uniform_mirrored_rows_.is_valid() &&
+           uniform_mirror_axis_.is_valid();
+}
+
+void SymmetryStage::Execute()
+{
+    program_->Use();
+    frame_buffer_->Bind();
+
+    // Targets alternate with the computation's ping-pong buffers.
+    frame_buffer_->AttachTexture
+    (
+        *out_value_texture_,
+        GL_COLOR_ATTACHMENT0
+    );
+    frame_buffer_->AttachTexture
+    (
+        *out_lifetime_texture_,
+        GL_COLOR_ATTACHMENT1
+    );
+
+    GLenum draw_buffers[2] =
+    {
+        GL_COLOR_ATTACHMENT0,
+        GL_COLOR_ATTACHMENT1
+    };
+    glDrawBuffers(2, draw_buffers);
+
+    in_value_texture_->BindToUnit(VALUE_TEXTURE_UNIT_INDEX);
+    in_lifetime_texture_->BindToUnit(LIFETIME_TEXTURE_UNIT_INDEX);
+
+    glViewport
+    (
+        0, 0,
+        out_value_texture_->width(),
+        out_value_texture_->height()
+    );
+
+    DrawScreenQuad();
+}
+
+void SymmetryStage::set_source_textures
+(
+    Texture& value,
+    Texture& lifetime
+)
+{
+    in_value_texture_ = &value;
+    in_lifetime_texture_ = &lifetime;
+}
+void SymmetryStage::set_target_textures
+(
+    Texture& value,
+    Texture& lifetime
+)
+{
+    out_value_texture_ = &value;
+    out_lifetime_texture_ = &lifetime;
+}
+
+void SymmetryStage::set_mirrored_rows
+(
+    const GLint begin,
+    const GLint end,
+    const GLint axis
+)
+{
+    program_->Use();
+    uniform_mirrored_rows_.set(begin, end);
+    uniform_mirror_axis_.set(axis);
+}
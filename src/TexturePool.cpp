@@ -0,0 +1,158 @@
+#include <mandelbrot/TexturePool.h>
+
+
+using namespace mandelbrot;
+using namespace oogl;
+
+
+const std::size_t TexturePool::DEFAULT_CAPACITY = 4;
+
+TexturePool::Statistics& TexturePool::Statistics::operator+=
+(
+    const Statistics& other
+)
+{
+    allocated_bytes += other.allocated_bytes;
+    idle_bytes += other.idle_bytes;
+    allocation_count += other.allocation_count;
+    return *this;
+}
+
+TexturePool::~TexturePool()
+{
+    Clear();
+}
+
+std::unique_ptr<Texture> TexturePool::Acquire
+(
+    const Texture::Binding target,
+    const GLint internal_format,
+    const GLsizei width,
+    const GLsizei height
+)
+{
+    // Most recently released first, leaving older ones to be trimmed.
+    for (auto i = idle_textures_.rbegin(); i != idle_textures_.rend(); ++i)
+    {
+        Texture& texture = **i;
+        if (texture.binding_target() == static_cast<GLenum>(target) &&
+            texture.internal_format() == internal_format &&
+            texture.width() == width &&
+            texture.height() == height)
+        {
+            std::unique_ptr<Texture> result = std::move(*i);
+            idle_textures_.erase(std::next(i).base());
+            statistics_.idle_bytes -= GetSize(*result);
+            return result;
+        }
+    }
+
+    auto texture = std::make_unique<Texture>
+    (
+        target, 
+        internal_format, 
+        width, height
+    );
+    texture->DefineStorage();
+
+    statistics_.allocated_bytes += GetSize(*texture);
+    ++ statistics_.allocation_count;
+
+    return texture;
+}
+bool TexturePool::Resize
+(
+    std::unique_ptr<Texture>& texture,
+    const GLsizei width,
+    const GLsizei height
+)
+{
+    if (texture->width() == width && texture->height() == height) 
+    { 
+        return false; 
+    }
+
+    // Acquired before the previous texture is released, so an idle 
+    // texture of the previous size is never evicted to make room for it.
+    std::unique_ptr<Texture> previous = std::move(texture);
+    texture = Acquire
+    (
+        static_cast<Texture::Binding>(previous->binding_target()),
+        previous->internal_format(),
+        width, height
+    );
+    Release(std::move(previous));
+
+    return true;
+}
+void TexturePool::Release(std::unique_ptr<Texture> texture)
+{
+    if (texture == nullptr) { return; }
+
+    statistics_.idle_bytes += GetSize(*texture);
+    idle_textures_.push_back(std::move(texture));
+    Trim();
+}
+void TexturePool::Clear()
+{
+    const std::size_t capacity = capacity_;
+    capacity_ = 0;
+    Trim();
+    capacity_ = capacity;
+}
+void TexturePool::Trim()
+{
+    while (idle_textures_.size() > capacity_)
+    {
+        const std::size_t size = GetSize(*idle_textures_.front());
+        statistics_.idle_bytes -= size;
+        statistics_.allocated_bytes -= size;
+        idle_textures_.pop_front();
+    }
+}
+
+std::size_t TexturePool::GetSize(const Texture& texture)
+{
+    return GetPixelSize(texture.binding_target(), texture.internal_format()) *
+           texture.width() * texture.height();
+}
+std::size_t TexturePool::GetPixelSize
+(
+    const GLenum target,
+    const GLint internal_format
+)
+{
+    static const GLenum COMPONENT_SIZES[] =
+    {
+        GL_INTERNALFORMAT_RED_SIZE,
+        GL_INTERNALFORMAT_GREEN_SIZE,
+        GL_INTERNALFORMAT_BLUE_SIZE,
+        GL_INTERNALFORMAT_ALPHA_SIZE,
+        GL_INTERNALFORMAT_DEPTH_SIZE,
+        GL_INTERNALFORMAT_STENCIL_SIZE
+    };
+
+    GLint bit_count = 0;
+    for (const GLenum component : COMPONENT_SIZES)
+    {
+        GLint size = 0;
+        glGetInternalformativ(target, internal_format, component, 1, &size);
+        bit_count += size;
+    }
+    return static_cast<std::size_t>(bit_count + 7) / 8;
+}
+
+std::size_t TexturePool::capacity() const
+{
+    return capacity_;
+}
+void TexturePool::set_capacity(const std::size_t value)
+{
+    capacity_ = value;
+    Trim();
+}
+
+const TexturePool::Statistics& TexturePool::statistics() const
+{
+    return statistics_;
+}
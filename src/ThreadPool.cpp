@@ -0,0 +1,92 @@
+#include <mandelbrot/ThreadPool.h>
+
+#include <algorithm>
+
+
+using namespace mandelbrot;
+
+
+unsigned int ThreadPool::GetDefaultThreadCount()
+{
+    // Zero when unknown.
+    const unsigned int hardware_count = std::thread::hardware_concurrency();
+    return std::max(hardware_count, 1U) - 1;
+}
+
+ThreadPool::ThreadPool()
+    : ThreadPool(GetDefaultThreadCount()) {}
+ThreadPool::ThreadPool(const unsigned int thread_count)
+{
+    for (unsigned int i = 0; i < thread_count; ++i)
+    {
+        threads_.emplace_back(&ThreadPool::Work, this);
+    }
+}
+ThreadPool::~ThreadPool()
+{
+    {
+        Lock lock(mutex_);
+        is_running_ = false;
+    }
+    task_condition_.notify_all();
+
+    for (std::thread& thread : threads_) { thread.join(); }
+}
+
+void ThreadPool::Run(const std::size_t count, const Task& task)
+{
+    if (count == 0) { return; }
+
+    Lock lock(mutex_);
+    task_ = &task;
+    task_count_ = count;
+    next_task_index_ = 0;
+    done_task_count_ = 0;
+    task_condition_.notify_all();
+
+    RunTasks(lock);
+    done_condition_.wait(lock, [this]
+    {
+        return done_task_count_ == task_count_;
+    });
+
+    task_ = nullptr;
+    task_count_ = 0;
+    next_task_index_ = 0;
+}
+void ThreadPool::Work()
+{
+    Lock lock(mutex_);
+    while (true)
+    {
+        task_condition_.wait(lock, [this]
+        {
+            return !is_running_ || next_task_index_ < task_count_;
+        });
+        if (!is_running_) { break; }
+
+        RunTasks(lock);
+    }
+}
+void ThreadPool::RunTasks(Lock& lock)
+{
+    while (next_task_index_ < task_count_)
+    {
+        const std::size_t index = next_task_index_++;
+        const Task& task = *task_;
+
+        lock.unlock();
+        task(index);
+        lock.lock();
+
+        if (++ done_task_count_ == task_count_)
+        {
+            done_condition_.notify_all();
+        }
+    }
+}
+
+unsigned int ThreadPool::thread_count() const
+{
+    return static_cast<unsigned int>(threads_.size());
+}
@@ -0,0 +1,66 @@
+#include <mandelbrot/TileClassifier.h>
+
+
+using namespace mandelbrot;
+
+
+TileClassifier::TileClassifier
+(
+    const Interval& real,
+    const Interval& imaginary,
+    const double escape_radius
+)
+    : c_real_(real), c_imaginary_(imaginary),
+      escape_norm_(escape_radius * escape_radius)
+{
+    if (IsInsideKnownComponent(real, imaginary))
+    {
+        result_ = Result::Interior;
+    }
+}
+
+void TileClassifier::Iterate(const unsigned int count)
+{
+    for (unsigned int i = 0; i < count && result_ == Result::Unknown; ++i)
+    {
+        const Interval real =
+            Square(z_real_) - Square(z_imaginary_) + c_real_;
+        const Interval imaginary =
+            Interval(2) * z_real_ * z_imaginary_ + c_imaginary_;
+
+        z_real_ = real;
+        z_imaginary_ = imaginary;
+        ++ lifetime_;
+
+        const Interval norm = Square(z_real_) + Square(z_imaginary_);
+        if (norm.lower >= escape_norm_) { result_ = Result::Escaped; }
+        else if (norm.upper >= escape_norm_) { result_ = Result::Mixed; }
+    }
+}
+bool TileClassifier::IsInsideKnownComponent
+(
+    const Interval& real,
+    const Interval& imaginary
+)
+{
+    const Interval y2 = Square(imaginary);
+
+    // Main cardioid: q * (q + x - 1/4) < y^2 / 4, q = (x - 1/4)^2 + y^2.
+    const Interval x = real - Interval(0.25);
+    const Interval q = Square(x) + y2;
+    const Interval cardioid = q * (q + x) - Interval(0.25) * y2;
+    if (cardioid.upper < 0) { return true; }
+
+    // Period-2 bulb: (x + 1)^2 + y^2 < 1/16.
+    const Interval bulb = Square(real + Interval(1)) + y2;
+    return bulb.upper < 0.0625;
+}
+
+TileClassifier::Result TileClassifier::result() const
+{
+    return result_;
+}
+int TileClassifier::lifetime() const
+{
+    return lifetime_;
+}
@@ -0,0 +1,290 @@
+#include <mandelbrot/Tracer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <vector>
+
+
+using namespace mandelbrot;
+using namespace oogl;
+
+
+struct Tracer::GpuThread
+{
+    struct Zone
+    {
+        const char* name;
+        std::unique_ptr<Query> begin, end;
+    };
+
+    // Ended zones awaiting their timestamps, oldest first.
+    std::deque<Zone> pending_zones;
+    std::vector<std::unique_ptr<Query>> idle_queries;
+
+    // CPU time minus GPU time, in nanoseconds.
+    std::int64_t offset = 0;
+    std::int64_t calibration_time =
+        (std::numeric_limits<std::int64_t>::min)();
+
+    std::unique_ptr<Query> AcquireQuery()
+    {
+        if (idle_queries.empty())
+        {
+            return std::make_unique<Query>(Query::Target::Timestamp);
+        }
+        std::unique_ptr<Query> query = std::move(idle_queries.back());
+        idle_queries.pop_back();
+        return query;
+    }
+};
+
+const std::size_t Tracer::CAPACITY = 1 << 16;
+const char* Tracer::DEFAULT_PATH = "mandelbrot_trace.json";
+const std::size_t Tracer::MAX_THREAD_COUNT = 16;
+const std::uint32_t Tracer::GPU_TRACK_OFFSET = 1000;
+const std::int64_t Tracer::CALIBRATION_INTERVAL_NANOSECONDS = 1000000000;
+
+std::atomic<bool> Tracer::is_enabled_(false);
+std::atomic<std::uint64_t> Tracer::next_index_(0);
+std::unique_ptr<Tracer::Slot[]> Tracer::slots_;
+std::atomic<std::uint32_t> Tracer::thread_count_(0);
+std::unique_ptr<std::atomic<const char*>[]> Tracer::thread_names_;
+
+Tracer::Zone::Zone(const char* name, const bool is_gpu_timed)
+    : name_(name)
+{
+    if (!is_enabled_.load(std::memory_order_relaxed)) { return; }
+
+    if (is_gpu_timed)
+    {
+        GpuThread& thread = GetGpuThread();
+        PollGpuThread(thread);
+
+        const std::int64_t now = Now();
+        if (now - thread.calibration_time >=
+            CALIBRATION_INTERVAL_NANOSECONDS)
+        {
+            const std::int64_t gpu_time = Query::GetTimestamp();
+            const std::int64_t cpu_time = Now();
+            thread.offset = (now + cpu_time) / 2 - gpu_time;
+            thread.calibration_time = cpu_time;
+        }
+
+        gpu_begin_ = thread.AcquireQuery();
+        gpu_begin_->RecordTimestamp();
+    }
+    begin_ = Now();
+}
+Tracer::Zone::~Zone()
+{
+    if (begin_ < 0) { return; }
+
+    Record(name_, GetThreadTrack(), begin_, Now() - begin_);
+
+    if (gpu_begin_ != nullptr)
+    {
+        GpuThread& thread = GetGpuThread();
+        std::unique_ptr<Query> end = thread.AcquireQuery();
+        end->RecordTimestamp();
+        thread.pending_zones.push_back
+        ({
+            name_,
+            std::move(gpu_begin_),
+            std::move(end)
+        });
+    }
+}
+
+bool Tracer::is_enabled()
+{
+    return is_enabled_.load(std::memory_order_relaxed);
+}
+void Tracer::set_is_enabled(const bool value)
+{
+    if (value && slots_ == nullptr)
+    {
+        slots_ = std::make_unique<Slot[]>(CAPACITY);
+        thread_names_ =
+            std::make_unique<std::atomic<const char*>[]>(MAX_THREAD_COUNT);
+        for (std::size_t i = 0; i < MAX_THREAD_COUNT; ++i)
+        {
+            thread_names_[i] = nullptr;
+        }
+    }
+    is_enabled_ = value;
+}
+
+void Tracer::SetThreadName(const char* name)
+{
+    if (!is_enabled()) { return; }
+
+    const std::uint32_t track = GetThreadTrack();
+    if (track <= MAX_THREAD_COUNT) { thread_names_[track - 1] = name; }
+}
+void Tracer::ReleaseThread()
+{
+    GpuThread*& thread = current_gpu_thread();
+    delete thread;
+    thread = nullptr;
+}
+
+bool Tracer::Write(const std::string& path)
+{
+    if (slots_ == nullptr) { return false; }
+
+    struct Event
+    {
+        std::uint64_t index;
+        const char* name;
+        std::int64_t begin, duration;
+        std::uint32_t track;
+    };
+    std::vector<Event> events;
+    events.reserve(CAPACITY);
+
+    // Slots being overwritten while read are skipped.
+    for (std::size_t i = 0; i < CAPACITY; ++i)
+    {
+        const Slot& slot = slots_[i];
+        const std::uint64_t sequence =
+            slot.sequence.load(std::memory_order_acquire);
+        if (sequence == 0) { continue; }
+
+        Event event;
+        event.index = sequence - 1;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.begin = slot.begin.load(std::memory_order_relaxed);
+        event.duration = slot.duration.load(std::memory_order_relaxed);
+        event.track = slot.track.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            continue;
+        }
+        events.push_back(event);
+    }
+    std::sort
+    (
+        events.begin(), events.end(),
+        [](const Event& a, const Event& b) { return a.index < b.index; }
+    );
+
+    std::ofstream file(path);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl
+         << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+         << "\"args\":{\"name\":\"mandelbrot\"}}";
+
+    const std::uint32_t thread_count =
+        std::min<std::uint32_t>(thread_count_, MAX_THREAD_COUNT);
+    for (std::uint32_t i = 0; i < thread_count; ++i)
+    {
+        const char* name = thread_names_[i];
+        const std::string thread_name =
+            name != nullptr ? name : "Thread " + std::to_string(i + 1);
+
+        file << "," << std::endl
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+             << "\"tid\":" << i + 1 << ","
+             << "\"args\":{\"name\":\"" << thread_name << "\"}},"
+             << std::endl
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+             << "\"tid\":" << GPU_TRACK_OFFSET + i + 1 << ","
+             << "\"args\":{\"name\":\"GPU (" << thread_name << ")\"}}";
+    }
+
+    // Timestamps are in microseconds.
+    file << std::fixed << std::setprecision(3);
+    for (const Event& event : events)
+    {
+        file << "," << std::endl
+             << "{\"name\":\"" << event.name << "\","
+             << "\"cat\":\""
+             << (event.track > GPU_TRACK_OFFSET ? "gpu" : "cpu") << "\","
+             << "\"ph\":\"X\",\"pid\":1,"
+             << "\"tid\":" << event.track << ","
+             << "\"ts\":" << event.begin / 1000.0 << ","
+             << "\"dur\":" << event.duration / 1000.0 << "}";
+    }
+    file << std::endl << "]}" << std::endl;
+
+    return !file.fail();
+}
+
+std::int64_t Tracer::Now()
+{
+    typedef std::chrono::steady_clock Clock;
+    static const Clock::time_point epoch = Clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+    (
+        Clock::now() - epoch
+    ).count();
+}
+std::uint32_t Tracer::GetThreadTrack()
+{
+    thread_local const std::uint32_t track = ++ thread_count_;
+    return track;
+}
+Tracer::GpuThread& Tracer::GetGpuThread()
+{
+    GpuThread*& thread = current_gpu_thread();
+    if (thread == nullptr) { thread = new GpuThread(); }
+    return *thread;
+}
+Tracer::GpuThread*& Tracer::current_gpu_thread()
+{
+    // Not owned by a thread-local object, whose destructor would delete
+    // the queries after the thread's context is gone.
+    thread_local GpuThread* thread = nullptr;
+    return thread;
+}
+void Tracer::PollGpuThread(GpuThread& thread)
+{
+    const std::uint32_t track = GPU_TRACK_OFFSET + GetThreadTrack();
+
+    while (!thread.pending_zones.empty() &&
+           thread.pending_zones.front().end->is_result_available())
+    {
+        GpuThread::Zone& zone = thread.pending_zones.front();
+        const std::int64_t begin =
+            static_cast<std::int64_t>(zone.begin->result());
+        const std::int64_t end =
+            static_cast<std::int64_t>(zone.end->result());
+
+        Record(zone.name, track, begin + thread.offset, end - begin);
+
+        thread.idle_queries.push_back(std::move(zone.begin));
+        thread.idle_queries.push_back(std::move(zone.end));
+        thread.pending_zones.pop_front();
+    }
+}
+
+void Tracer::Record
+(
+    const char* name,
+    const std::uint32_t track,
+    const std::int64_t begin,
+    const std::int64_t duration
+)
+{
+    const std::uint64_t index =
+        next_index_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[index % CAPACITY];
+
+    // The slot is marked as being written before its fields change, so
+    // readers can tell a torn event.
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.duration.store(duration, std::memory_order_relaxed);
+    slot.track.store(track, std::memory_order_relaxed);
+
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
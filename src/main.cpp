@@ -6,12 +6,21 @@
  */
 
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include <tclap/CmdLine.h>
 
+#include <oogl/Instrumentation.hpp>
+#include <oogl/StateCache.hpp>
+
 #include <mandelbrot/Application.h>
+#include <mandelbrot/Benchmark.h>
 #include <mandelbrot/ColorArray.h>
+#include <mandelbrot/ProcessingStage.h>
+#include <mandelbrot/SnapshotWriter.h>
+#include <mandelbrot/Tracer.h>
 #include <mandelbrot/Vector2.h>
 
 
@@ -35,6 +44,8 @@ Status main(const int argc, char** argv)
     static const Vector2d DEFAULT_VIEWPORT_CENTER = Vector2d(-0.5, 0);
     static const double DEFAULT_VIEWPORT_SIZE = 3;
 
+    static const double DEFAULT_REPLAY_TIMESTEP = 1.0 / 60;
+
     try
     {
         TCLAP::CmdLine command_line
@@ -46,7 +57,8 @@ Status main(const int argc, char** argv)
         );
         TCLAP::ValueArg<unsigned int> resolution_arg
         (
-            "r", "resolution", "Rendering resolution",
+            "r", "resolution", 
+            "Rendering resolution along the window's longer side",
             false, DEFAULT_RESOLUTION, "positive integer"
         );
         TCLAP::ValueArg<std::string> color_map_path_arg
@@ -71,16 +83,241 @@ Status main(const int argc, char** argv)
             false, DEFAULT_VIEWPORT_SIZE, "positive double"
         );
 
+        std::vector<std::string> snapshot_formats { "bmp", "png" };
+        TCLAP::ValuesConstraint<std::string> 
+            snapshot_format_constraint(snapshot_formats);
+        TCLAP::ValueArg<std::string> snapshot_format_arg
+        (
+            "f", "snapshot-format", "Image format of saved snapshots",
+            false, "bmp", &snapshot_format_constraint
+        );
+        TCLAP::SwitchArg synchronous_arg
+        (
+            "s", "synchronous", 
+            "Compute on the display thread instead of a background thread"
+        );
+        TCLAP::ValueArg<unsigned int> precision_arg
+        (
+            "p", "precision", "Number of rendering steps per image",
+            false, 1, "positive integer"
+        );
+        TCLAP::SwitchArg symmetry_arg
+        (
+            "", "symmetry", 
+            "Copy rows mirrored across the real axis instead of computing them"
+        );
+        TCLAP::ValueArg<double> escape_radius_arg
+        (
+            "", "escape-radius", "Magnitude beyond which orbits escape",
+            false, 2, "real number, at least 2"
+        );
+        TCLAP::SwitchArg single_precision_arg
+        (
+            "", "single-precision", 
+            "Iterate in single instead of double precision on the GPU"
+        );
+        TCLAP::SwitchArg no_cycle_detection_arg
+        (
+            "", "no-cycle-detection", 
+            "Keep iterating orbits attracted to a cycle on the GPU"
+        );
+        TCLAP::SwitchArg cpu_arg
+        (
+            "", "cpu", 
+            "Compute on the CPU, skipping pixels a distance estimate proves "
+            "to be outside the set"
+        );
+        TCLAP::SwitchArg proven_arg
+        (
+            "", "proven", 
+            "With --cpu, only skip pixels proven to be uniform by interval "
+            "arithmetic"
+        );
+        TCLAP::SwitchArg cost_heatmap_arg
+        (
+            "", "cost-heatmap", 
+            "Show the iterations executed per pixel as a heatmap, and save "
+            "them alongside snapshots"
+        );
+        TCLAP::ValueArg<std::string> shader_cache_arg
+        (
+            "", "shader-cache", 
+            "Directory of cached program binaries",
+            false, ProgramCache::DEFAULT_DIRECTORY, "path"
+        );
+        TCLAP::SwitchArg no_shader_cache_arg
+        (
+            "", "no-shader-cache", 
+            "Compile every program instead of loading cached binaries"
+        );
+        TCLAP::SwitchArg gl_statistics_arg
+        (
+            "", "gl-stats", 
+            "Record GL calls, transfers and wrapper time per frame, shown "
+            "with the debug key"
+        );
+        TCLAP::ValueArg<std::string> gl_statistics_path_arg
+        (
+            "", "gl-stats-path", 
+            "Write a summary of GL statistics to this file on exit; implies "
+            "--gl-stats",
+            false, "", "path"
+        );
+        TCLAP::ValueArg<std::string> stage_times_path_arg
+        (
+            "", "stage-times-path", 
+            "Write rolling GPU times of each stage to this CSV file on exit",
+            false, "", "path"
+        );
+        TCLAP::ValueArg<std::string> trace_path_arg
+        (
+            "", "trace", 
+            "Trace CPU and GPU zones and write them to this Chrome trace "
+            "file on exit, or on the apostrophe key",
+            false, "", "path"
+        );
+        TCLAP::SwitchArg no_dsa_arg
+        (
+            "", "no-dsa", 
+            "Bind objects to operate on them even if direct state access is "
+            "supported"
+        );
+
+        TCLAP::ValueArg<unsigned int> poster_width_arg
+        (
+            "", "poster-width", 
+            "Render a poster of given width without opening a window",
+            false, 0, "positive integer"
+        );
+        TCLAP::ValueArg<unsigned int> poster_height_arg
+        (
+            "", "poster-height", 
+            "Poster height (defaults to the poster's width)",
+            false, 0, "positive integer"
+        );
+        TCLAP::ValueArg<unsigned int> poster_tile_size_arg
+        (
+            "", "poster-tile-size", 
+            "Poster tile size (defaults to the largest supported)",
+            false, 0, "positive integer"
+        );
+        TCLAP::ValueArg<std::string> poster_path_arg
+        (
+            "", "poster-path", 
+            "Poster output path (accepts .png, .ppm)",
+            false, "mandelbrot_poster.png", "string"
+        );
+        TCLAP::SwitchArg poster_tiles_arg
+        (
+            "", "poster-tiles", 
+            "Save each poster tile to its own file, suffixed _row_column"
+        );
+        TCLAP::ValueArg<unsigned int> poster_first_tile_arg
+        (
+            "", "poster-first-tile", 
+            "Index of the first poster tile to render, to resume tiled "
+            "output",
+            false, 0, "non-negative integer"
+        );
+
+        TCLAP::SwitchArg benchmark_arg
+        (
+            "", "benchmark", 
+            "Render each saved state to completion without opening a "
+            "window, and report timings as JSON"
+        );
+        TCLAP::ValueArg<std::string> benchmark_states_arg
+        (
+            "", "benchmark-states", 
+            "Directory of the state files to benchmark",
+            false, Benchmark::DEFAULT_STATE_DIRECTORY, "path"
+        );
+        TCLAP::ValueArg<std::string> benchmark_path_arg
+        (
+            "", "benchmark-path", 
+            "Benchmark report output path",
+            false, Benchmark::DEFAULT_PATH, "path"
+        );
+
+        TCLAP::ValueArg<std::string> record_input_arg
+        (
+            "", "record-input", 
+            "Record key events and frame times to this file on exit",
+            false, "", "path"
+        );
+        TCLAP::ValueArg<std::string> replay_input_arg
+        (
+            "", "replay-input", 
+            "Replay a recorded session without opening a window, and "
+            "report frame times",
+            false, "", "path"
+        );
+        TCLAP::ValueArg<double> replay_timestep_arg
+        (
+            "", "replay-timestep", 
+            "Camera time step of replayed frames in seconds (zero for the "
+            "recorded times)",
+            false, DEFAULT_REPLAY_TIMESTEP, "non-negative number"
+        );
+
         command_line.add(resolution_arg);
         command_line.add(color_map_path_arg);
         command_line.add(camera_x_arg);
         command_line.add(camera_y_arg);
         command_line.add(camera_zoom_arg);
+        command_line.add(snapshot_format_arg);
+        command_line.add(synchronous_arg);
+        command_line.add(precision_arg);
+        command_line.add(symmetry_arg);
+        command_line.add(escape_radius_arg);
+        command_line.add(single_precision_arg);
+        command_line.add(no_cycle_detection_arg);
+        command_line.add(cpu_arg);
+        command_line.add(proven_arg);
+        command_line.add(cost_heatmap_arg);
+        command_line.add(shader_cache_arg);
+        command_line.add(no_shader_cache_arg);
+        command_line.add(gl_statistics_arg);
+        command_line.add(gl_statistics_path_arg);
+        command_line.add(stage_times_path_arg);
+        command_line.add(trace_path_arg);
+        command_line.add(no_dsa_arg);
+        command_line.add(poster_width_arg);
+        command_line.add(poster_height_arg);
+        command_line.add(poster_tile_size_arg);
+        command_line.add(poster_path_arg);
+        command_line.add(poster_tiles_arg);
+        command_line.add(poster_first_tile_arg);
+        command_line.add(benchmark_arg);
+        command_line.add(benchmark_states_arg);
+        command_line.add(benchmark_path_arg);
+        command_line.add(record_input_arg);
+        command_line.add(replay_input_arg);
+        command_line.add(replay_timestep_arg);
 
         command_line.parse(argc, argv);
 
+        oogl::StateCache::set_is_dsa_enabled(!no_dsa_arg.getValue());
+        oogl::Instrumentation::set_is_enabled
+        (
+            gl_statistics_arg.getValue() || 
+            !gl_statistics_path_arg.getValue().empty()
+        );
+        Tracer::set_is_enabled(!trace_path_arg.getValue().empty());
+
         Application::Initialize(WINDOW_WIDTH, WINDOW_HEIGHT);
         Application& application = Application::instance();
+        application.set_is_synchronous(synchronous_arg.getValue());
+        application.set_gl_statistics_path(gl_statistics_path_arg.getValue());
+        application.set_stage_times_path(stage_times_path_arg.getValue());
+        application.set_trace_path(trace_path_arg.getValue());
+        application.set_input_recording_path(record_input_arg.getValue());
+        application.set_snapshot_format
+        (
+            snapshot_format_arg.getValue() == "png" ?
+            SnapshotWriter::Format::Png :
+            SnapshotWriter::Format::Bmp
+        );
 
         ColorArray color_map = 
             ColorArray::FromPath(color_map_path_arg.getValue().c_str());
@@ -102,6 +339,71 @@ Status main(const int argc, char** argv)
         application.renderer().set_resolution(resolution_arg.getValue());
         application.renderer().set_color_map(color_map);
         application.renderer().set_iterations_per_step(color_map.size());
+        application.renderer().set_max_step_count(precision_arg.getValue());
+        application.renderer().set_is_symmetric(symmetry_arg.getValue());
+        application.renderer().set_escape_radius(escape_radius_arg.getValue());
+        if (single_precision_arg.getValue())
+        {
+            application.renderer().set_precision
+            (
+                ComputationStage::Precision::Single
+            );
+        }
+        application.renderer().set_detects_interior
+        (
+            !no_cycle_detection_arg.getValue()
+        );
+        if (cpu_arg.getValue())
+        {
+            application.renderer().set_computation_mode
+            (
+                ComputationStage::Mode::Cpu
+            );
+        }
+        application.renderer().set_is_proven_only(proven_arg.getValue());
+        application.renderer().set_shows_cost(cost_heatmap_arg.getValue());
+
+        ProcessingStage::program_cache().set_directory
+        (
+            no_shader_cache_arg.getValue() ? 
+            std::string() : 
+            shader_cache_arg.getValue()
+        );
+
+        if (!replay_input_arg.getValue().empty())
+        {
+            Application::ReplaySettings replay;
+            replay.path = replay_input_arg.getValue();
+            replay.timestep_seconds = 
+                std::max(replay_timestep_arg.getValue(), 0.0);
+
+            return application.LaunchReplay(replay) ? SUCCESS : FAILURE;
+        }
+        if (benchmark_arg.getValue())
+        {
+            Application::BenchmarkSettings benchmark;
+            benchmark.state_directory = benchmark_states_arg.getValue();
+            benchmark.path = benchmark_path_arg.getValue();
+
+            return application.LaunchBenchmark(benchmark) ? 
+                   SUCCESS : 
+                   FAILURE;
+        }
+        if (poster_width_arg.getValue() > 0)
+        {
+            Application::PosterSettings poster;
+            poster.size.x = poster_width_arg.getValue();
+            poster.size.y = 
+                poster_height_arg.getValue() > 0 ?
+                poster_height_arg.getValue() :
+                poster_width_arg.getValue();
+            poster.tile_size = poster_tile_size_arg.getValue();
+            poster.first_tile_index = poster_first_tile_arg.getValue();
+            poster.path = poster_path_arg.getValue();
+            poster.is_tiled = poster_tiles_arg.getValue();
+
+            return application.LaunchPoster(poster) ? SUCCESS : FAILURE;
+        }
 
         return application.Launch() ? SUCCESS : FAILURE;
     }
@@ -1,6 +1,15 @@
 /**
  * Fragment shader for mandelbrot set computation.
  *
+ * Variants are specialized by the following definitions:
+ *     DT               Iterations per execution step
+ *     ESCAPE_RADIUS    Magnitude beyond which orbits escape
+ *     SINGLE_PRECISION Iterate in single instead of double precision
+ *     DETECT_CYCLES    Stop iterating orbits attracted to a cycle
+ *     COUNT_ACTIVE     Only let pixels still iterated pass, writing nothing,
+ *                      for an occlusion query to count them
+ *     RECORD_COST      Accumulate the iterations executed per pixel
+ *
  * @author Raoul Harel
  * @url github.com/rharel/cpp-mandelbrot
  */
@@ -9,17 +18,47 @@
 #version 440
 
 
+#ifndef DT
+#define DT 1
+#endif
+#ifndef ESCAPE_RADIUS
+#define ESCAPE_RADIUS 2.0
+#endif
+
+#ifdef SINGLE_PRECISION
+#define real_t float
+#define complex_t vec2
+#else
+#define real_t double
+#define complex_t dvec2
+#endif
+
 uniform dvec2 viewport_bottom_left = dvec2(-2, -1.5);
-uniform double viewport_size = 3;
+uniform dvec2 viewport_size = dvec2(3, 3);
 
 uniform  sampler2D value_texture;
 uniform isampler2D lifetime_texture;
+#ifdef RECORD_COST
+uniform usampler2D cost_texture;
+#endif
+
+const real_t ESCAPE_NORM = real_t(ESCAPE_RADIUS * ESCAPE_RADIUS);
 
-uniform int dt = 1;
+// Largest distance between two points of an orbit that are considered
+// the same point of an attracting cycle. Single precision resolves about
+// 1e-7 around the unit circle, where cycles lie, so it needs a looser one.
+#ifdef SINGLE_PRECISION
+const real_t CYCLE_EPSILON = real_t(1e-5);
+#else
+const real_t CYCLE_EPSILON = real_t(1e-10);
+#endif
 
 layout(location = 1) in  vec2 in_clip_space_position;
-layout(location = 0) out vec2 out_value;
-layout(location = 1) out int  out_lifetime;
+layout(location = 0) out vec2  out_value;
+layout(location = 1) out ivec2 out_lifetime;
+#ifdef RECORD_COST
+layout(location = 2) out uint  out_cost;
+#endif
 
 /**
  * Converts a position in clip-space to normalized device coordinates (NDC).
@@ -45,12 +84,23 @@ dvec2 ConvertToComplex(const vec2 position)
 	return viewport_bottom_left + position * viewport_size;
 }
 
+/**
+ * Multiplies two complex numbers.
+ */
+complex_t Multiply(const complex_t a, const complex_t b)
+{
+	return complex_t
+	(
+		a.x * b.x - a.y * b.y,
+		a.x * b.y + a.y * b.x
+	);
+}
 /**
  * Squares a complex number.
  */
-dvec2 Square(const dvec2 z)
+complex_t Square(const complex_t z)
 {
-	return dvec2
+	return complex_t
 	(
 		z.x * z.x - z.y * z.y,
 		2 * z.x * z.y
@@ -59,30 +109,66 @@ dvec2 Square(const dvec2 z)
 /**
  * Executes one iteration of the mandelbrot function.
  */
-dvec2 ComputeMandelbrot(const dvec2 z, const dvec2 c)
+complex_t ComputeMandelbrot(const complex_t z, const complex_t c)
 {
 	return Square(z) + c;
 }
 /**
- * Executes the mandelbrot function for a maximum number of iterations.
+ * Executes the mandelbrot function for DT iterations, or until the orbit
+ * escapes or is found to be attracted to a cycle. The loop has constant
+ * bounds, so it may be unrolled.
+ *
+ * The orbit is compared against a reference point, which is moved forward
+ * at power-of-two iteration counts so cycles of any period up to half of
+ * DT are found. The cycle is attracting if the derivative with respect to
+ * z over one period, the product of 2z along it, is less than one.
  *
  * @param z0  Starting value
  * @param c   Offset
- * @param dt  Duration in iterations
- * @param[out] lifetime Lifetime duration in iterations.
+ * @param[out] lifetime     Lifetime duration in iterations.
+ * @param[out] is_interior  Whether c is found to be inside the set.
  */
-dvec2 RepeatMandelbrot
+complex_t RepeatMandelbrot
 (
-	const dvec2 z0, const dvec2 c, 
-	const int dt, 
-	out int lifetime)
+	const complex_t z0, const complex_t c,
+	out int lifetime,
+	out bool is_interior)
 {
-	dvec2 z = z0;
+	complex_t z = z0;
 	lifetime = 0;
-	while (dot(z, z) < 4 && lifetime < dt)
+	is_interior = false;
+
+#ifdef DETECT_CYCLES
+	complex_t reference = z;
+	complex_t multiplier = complex_t(1, 0);
+	int next_reference = 1;
+#endif
+
+	for (int i = 0; i < DT; ++i)
 	{
+		if (dot(z, z) >= ESCAPE_NORM) { break; }
+
+#ifdef DETECT_CYCLES
+		multiplier = Multiply(multiplier, 2 * z);
+#endif
 		z = ComputeMandelbrot(z, c);
 		++lifetime;
+
+#ifdef DETECT_CYCLES
+		complex_t offset = z - reference;
+		if (dot(offset, offset) < CYCLE_EPSILON * CYCLE_EPSILON &&
+			dot(multiplier, multiplier) < 1)
+		{
+			is_interior = true;
+			break;
+		}
+		if (lifetime == next_reference)
+		{
+			reference = z;
+			multiplier = complex_t(1, 0);
+			next_reference *= 2;
+		}
+#endif
 	}
 	return z;
 }
@@ -90,13 +176,38 @@ dvec2 RepeatMandelbrot
 void main()
 {
 	vec2 ndc = ConvertToNDC(in_clip_space_position);
-	
-	dvec2 z = texture(value_texture, ndc).xy;
-	dvec2 c = ConvertToComplex(ndc);
-	
-	int lifetime_offset;
-	out_value = vec2(RepeatMandelbrot(z, c, dt, lifetime_offset));
 
-	int lifetime = texture(lifetime_texture, ndc).x;
-	out_lifetime = lifetime + lifetime_offset;
+	complex_t z = complex_t(texture(value_texture, ndc).xy);
+	ivec2 lifetime = texture(lifetime_texture, ndc).xy;
+
+#ifdef COUNT_ACTIVE
+	if (lifetime.y != 0 || dot(z, z) >= ESCAPE_NORM) { discard; }
+	return;
+#endif
+
+#ifdef RECORD_COST
+	uint cost = texture(cost_texture, ndc).x;
+	out_cost = cost;
+#endif
+
+	// Interior points are done.
+	if (lifetime.y != 0)
+	{
+		out_value = vec2(z);
+		out_lifetime = lifetime;
+		return;
+	}
+
+	complex_t c = complex_t(ConvertToComplex(ndc));
+
+	int lifetime_offset;
+	bool is_interior;
+	out_value = vec2
+	(
+		RepeatMandelbrot(z, c, lifetime_offset, is_interior)
+	);
+	out_lifetime = ivec2(lifetime.x + lifetime_offset, is_interior);
+#ifdef RECORD_COST
+	out_cost = cost + uint(lifetime_offset);
+#endif
 }
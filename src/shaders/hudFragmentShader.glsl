@@ -0,0 +1,72 @@
+/**
+ * Fragment shader for the performance overlay's text.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#version 440
+
+
+// Glyph size, and the size of the cell holding it, in font pixels.
+const ivec2 GLYPH_SIZE = ivec2(5, 7);
+const ivec2 CELL_SIZE = ivec2(6, 9);
+// Margin around the text, in font pixels.
+const int PADDING = 3;
+
+const vec4 BACKGROUND_COLOR = vec4(0, 0, 0, 0.6);
+const vec4 TEXT_COLOR = vec4(1, 1, 1, 1);
+
+// Glyph indices, one per cell, top line first.
+uniform usampler2D text_texture;
+// Glyphs side by side, top row first.
+uniform  sampler2D font_texture;
+
+layout(location = 1) in  vec2 in_clip_space_position;
+layout(location = 0) out vec4 out_color;
+
+/**
+ * Converts a position in clip-space to normalized device coordinates (NDC).
+ *
+ * @param position Clip-space coordinates.
+ *
+ * @returns Corresponding NDC.
+ */
+vec2 ConvertToNDC(const vec2 position)
+{
+	return 0.5 * (position + 1);
+}
+
+void main()
+{
+	out_color = BACKGROUND_COLOR;
+
+	ivec2 text_size = textureSize(text_texture, 0) * CELL_SIZE;
+	ivec2 area_size = text_size + 2 * PADDING;
+
+	// Font pixel, from the text's top-left corner.
+	ivec2 position = ivec2(ConvertToNDC(in_clip_space_position) * area_size);
+	position.y = area_size.y - 1 - position.y;
+	position -= PADDING;
+
+	if (any(lessThan(position, ivec2(0))) ||
+		any(greaterThanEqual(position, text_size)))
+	{
+		return;
+	}
+
+	ivec2 cell = position / CELL_SIZE;
+	ivec2 offset = position - cell * CELL_SIZE;
+	if (any(greaterThanEqual(offset, GLYPH_SIZE))) { return; }
+
+	int glyph = int(texelFetch(text_texture, cell, 0).r);
+	float coverage = texelFetch
+	(
+		font_texture,
+		ivec2(glyph * GLYPH_SIZE.x + offset.x, offset.y),
+		0
+	).r;
+
+	out_color = mix(BACKGROUND_COLOR, TEXT_COLOR, coverage);
+}
@@ -30,7 +30,12 @@ vec2 ConvertToNDC(const vec2 position)
 void main()
 {
 	vec2 ndc = ConvertToNDC(in_clip_space_position);
-	int lifetime = texture(lifetime_texture, ndc).x;
-	int color_index = lifetime % textureSize(lifetime_color_map_texture, 0);
+	ivec2 lifetime = texture(lifetime_texture, ndc).xy;
+	if (lifetime.y != 0)
+	{
+		out_color = vec3(0, 0, 0);
+		return;
+	}
+	int color_index = lifetime.x % textureSize(lifetime_color_map_texture, 0);
 	out_color = texelFetch(lifetime_color_map_texture, color_index, 0).xyz;
 }
@@ -11,7 +11,7 @@
 
 uniform sampler2D image_texture;
 uniform dvec2 relative_position_offset = dvec2(0, 0);
-uniform double relative_size_factor = 1.0;
+uniform dvec2 relative_size_factor = dvec2(1, 1);
 
 layout(location = 1) in  vec2 in_clip_space_position;
 layout(location = 0) out vec3 out_color;
@@ -1,6 +1,10 @@
 /**
  * Fragment shader for smooth mandelbrot set coloring.
  *
+ * Variants are specialized by the following definitions:
+ *     COST_HEATMAP     Show the iterations executed per pixel instead, on a
+ *                      logarithmic scale up to max_lifetime
+ *
  * @author Raoul Harel
  * @url github.com/rharel/cpp-mandelbrot
  */
@@ -13,6 +17,10 @@ uniform  sampler2D value_texture;
 uniform isampler2D lifetime_texture;
 uniform  sampler1D lifetime_color_map_texture;
 uniform int max_lifetime;
+uniform float escape_radius = 2;
+#ifdef COST_HEATMAP
+uniform usampler2D cost_texture;
+#endif
 
 layout(location = 1) in  vec2 in_clip_space_position;
 layout(location = 0) out vec3 out_color;
@@ -28,14 +36,29 @@ vec2 ConvertToNDC(const vec2 position)
 {
 	return 0.5 * (position + 1);
 }
+/**
+ * Maps a value in [0, 1] to a black-red-yellow-white ramp.
+ */
+vec3 GetHeatColor(const float t)
+{
+	return clamp(vec3(3 * t, 3 * t - 1, 3 * t - 2), 0, 1);
+}
 
 void main()
 {
 	vec2 ndc = ConvertToNDC(in_clip_space_position);
 
+#ifdef COST_HEATMAP
+	float cost = float(texture(cost_texture, ndc).x);
+	out_color = GetHeatColor(log2(1 + cost) / log2(1 + float(max_lifetime)));
+	return;
+#endif
+
 	vec2 z = texture(value_texture, ndc).xy;
-	int lifetime = texture(lifetime_texture, ndc).x;
-	float N = 2;
+	ivec2 lifetime_data = texture(lifetime_texture, ndc).xy;
+	int lifetime = lifetime_data.x;
+	bool is_interior = lifetime_data.y != 0;
+	float N = escape_radius;
 
 	// Compute log_2(log(|z|) / log(N))
 	float log_z = log(dot(z, z)) / 2;
@@ -46,7 +69,7 @@ void main()
 	
 	int color_a_index, 
 	    color_b_index;
-	if (smooth_lifetime >= max_lifetime)
+	if (is_interior || smooth_lifetime >= max_lifetime)
 	{
 		color_a_index = color_b_index = color_map_size;
 	}
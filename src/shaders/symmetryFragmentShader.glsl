@@ -0,0 +1,40 @@
+/**
+ * Fragment shader for mirroring computation results across the real axis.
+ *
+ * @author Raoul Harel
+ * @url github.com/rharel/cpp-mandelbrot
+ */
+
+
+#version 440
+
+
+uniform  sampler2D value_texture;
+uniform isampler2D lifetime_texture;
+
+// Range [begin, end) of rows holding the mirror image of other rows.
+uniform ivec2 mirrored_rows = ivec2(0, 0);
+// Twice the real axis' position, in pixels from the bottom.
+uniform int mirror_axis = 0;
+
+layout(location = 1) in  vec2 in_clip_space_position;
+layout(location = 0) out vec2  out_value;
+layout(location = 1) out ivec2 out_lifetime;
+
+void main()
+{
+	ivec2 position = ivec2(gl_FragCoord.xy);
+
+	bool is_mirrored = 
+		position.y >= mirrored_rows.x && 
+		position.y <  mirrored_rows.y;
+	if (is_mirrored) { position.y = mirror_axis - 1 - position.y; }
+
+	vec2 value = texelFetch(value_texture, position, 0).xy;
+	
+	// The orbit of conj(c) is the conjugate of the orbit of c.
+	if (is_mirrored) { value.y = -value.y; }
+
+	out_value = value;
+	out_lifetime = texelFetch(lifetime_texture, position, 0).xy;
+}